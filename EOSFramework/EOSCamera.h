@@ -11,6 +11,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class EOSVolume;
+@class EOSPropertyHistory;
 @class EOSFile;
 
 
@@ -101,6 +102,24 @@ typedef NS_ENUM(NSInteger, EOSShutterButtonState){
  */
 @property (readonly) NSString* cameraDescription;
 
+/*!
+ @brief The camera's serial number.
+ @discussion The serial number is read from the EOSProperty_SerialNumber property the first time it is requested while the camera has an open session, and is then cached. Unlike port, this value identifies the camera across connections.
+ */
+@property (readonly, nullable) NSString* serialNumber;
+
+/*!
+ @brief The serial number that the camera is assumed to have, before it has been read.
+ @discussion When EOSDeviceRegistry restores cameras, each camera is matched to a record by model and port, which is a guess. Until the camera has been revalidated, this is the serial number of the matched record, and serialNumber is not primed with it. Otherwise this is the cached serialNumber, or nil if it hasn't been read. Use this value only where a wrong guess is harmless, such as for display.
+ */
+@property (readonly, nullable) NSString* provisionalSerialNumber;
+
+/*!
+ @brief The camera's recent property changes.
+ @discussion Every property change event from the camera, and every value written to the camera through the framework, is recorded.
+ */
+@property (readonly) EOSPropertyHistory* propertyHistory;
+
 
 ///---------------------
 /// @name Initialization
@@ -177,7 +196,7 @@ typedef NS_ENUM(NSInteger, EOSShutterButtonState){
 
 /*!
  @brief Gets a list of values that the camera supports in it's current mode, for a given property.
- @discussion Use this to find the supported values for a numeric type property, such as aperture, shutter speed, ISO etc. The list of supported values may change when the camera's mode is changed.
+ @discussion Use this to find the supported values for a numeric type property, such as aperture, shutter speed, ISO etc. The list of supported values may change when the camera's mode is changed. While a session is open, the values are answered from EOSCapabilityCache when the camera's model has been seen in the same mode before.
  @param property The property to get supported values for.
  @param error If unsuccessful, an instance of NSError describes the problem.
  @return If successful an array containing the supported values as NSNumbers, otherwise nil.
@@ -209,6 +228,38 @@ typedef NS_ENUM(NSInteger, EOSShutterButtonState){
 
 
 
+///-------------------------
+/// @name Locking the Camera
+///-------------------------
+
+/*!
+ @brief Locks the camera's UI for the duration of a bulk operation, so that the operator can't make the camera busy part way through it.
+ @discussion Locks are counted, so overlapping operations on the same camera may each take one: EOSCommand_LockUI is sent by the first lock and EOSCommand_UnlockUI by the matching last unlock. Every successful call must be balanced by a call to unlockUI:error: with the token that it returns. Models that don't support locking their UI are counted as locked without sending a command. Closing the session releases every lock, and unlocking a lock taken before then has no effect, so it can't release a lock taken in a later session.
+ @param token On return, identifies the lock to unlockUI:error:.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)lockUI:(NSUInteger*)token error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Releases a lock taken with lockUI:error:.
+ @param token The token returned by lockUI:error:.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO. The lock is released even if the camera fails to unlock its UI.
+ */
+-(BOOL)unlockUI:(NSUInteger)token error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Performs a bulk operation with the camera's UI locked.
+ @discussion The lock is released when the block returns, whether it succeeds, fails or raises an exception. The framework uses this while applying profiles and formatting volumes.
+ @param block The operation, which returns YES if it is successful, and otherwise NO with an error.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if the UI was locked and the block returned YES, otherwise NO.
+ */
+-(BOOL)performWithLockedUI:(BOOL (^)(NSError* __autoreleasing* error))block error:(NSError* __autoreleasing*)error;
+
+
+
 ///----------------------------
 /// @name Managing the Delegate
 ///----------------------------
@@ -300,7 +351,8 @@ typedef NS_ENUM(NSInteger, EOSShutterButtonState){
 -(void)camera:(EOSCamera*)camera didFormatVolume:(EOSVolume*)volume;
 
 /*!
- Untested
+ @brief Called when the camera asks to transfer a file that it has captured, such as when its EOSProperty_CaptureDestination includes the host.
+ @discussion The file must be downloaded, or the transfer cancelled, before the camera frees its buffer. EOSHostCapture handles these requests itself. Files that the operator sends from the camera's menu in direct transfer mode are received with EOSDirectTransfer instead.
  */
 -(void)camera:(EOSCamera*)camera didRequestTransferOfFile:(EOSFile*)file;
 
@@ -11,16 +11,67 @@
 #import <EOSFramework/EOSFile.h>
 #import <EDSDK/EDSDK.h>
 #import <EOSFramework/EOSError.h>
+#import "EOSPrivate.h"
+
+//the number of property changes that each camera remembers
+#define EOSCameraPropertyHistoryCapacity 1024
+
+//description changes this soon after the session opens, the shooting mode changes or the lens changes are expected, and are covered by the capability cache
+#define EOSCameraExpectedDescChangeInterval 5.0
+
+//the supported values of these properties depend on the lens as well as the shooting mode
+static BOOL EOSCameraIsLensDependent(EOSProperty property){
+
+    return property == EOSProperty_Aperture || property == EOSProperty_AFMode;
+
+}
+
+@interface EOSCamera ()
+
+-(void)propertyDidChange:(EOSProperty)property;
+-(void)propertyDescDidChange:(EOSProperty)property;
+
+@end
 
 EdsError EDSCALLBACK EOSCameraPropertyEventHandler(EdsPropertyEvent inEvent, EdsPropertyID inPropertyID, EdsUInt32 inParam, EdsVoid* inContext){
 
     EOSCamera* camera = (__bridge EOSCamera *)(inContext);
+    id delegate = [camera delegate];
     
-    if (inEvent == kEdsPropertyEvent_PropertyChanged)
-        [[camera delegate] camera:camera valueDidChangeForProperty:inPropertyID];
+    if (EOSFRAMEWORK_EVENT_DISPATCH_ENABLED())
+        EOSFRAMEWORK_EVENT_DISPATCH(EOSProbeSerialNumber(camera), EOSProbeEvent_Property, (int)inEvent, (int)inPropertyID);
     
-    else if (inEvent == kEdsPropertyEvent_PropertyDescChanged)
-        [[camera delegate] camera:camera supportedValuesDidChangeForProperty:inPropertyID];
+    //property events are always registered, so the delegate may not handle them
+    if (inEvent == kEdsPropertyEvent_PropertyChanged){
+        
+        [camera propertyDidChange:inPropertyID];
+        
+        //32 bit values are read back, which is one local read, so that the history has the new value
+        NSUInteger size;
+        EdsDataType dataType;
+        UInt32 value;
+        
+        if ([camera getValueSize:&size dataType:&dataType forProperty:inPropertyID withParameter:inParam error:nil] && size == sizeof(value) && [camera getValue:&value ofSize:sizeof(value) forProperty:inPropertyID withParameter:inParam error:nil])
+            EOSPropertyHistoryRecord([camera propertyHistory], inPropertyID, inParam, EOSPropertyChangeSource_Camera, &value, sizeof(value));
+        else
+            EOSPropertyHistoryRecord([camera propertyHistory], inPropertyID, inParam, EOSPropertyChangeSource_Camera, NULL, 0);
+        
+        void (^propertyChangeHandler)(EOSProperty) = [camera propertyChangeHandler];
+        
+        if (propertyChangeHandler != nil)
+            propertyChangeHandler(inPropertyID);
+        
+        if ([delegate respondsToSelector:@selector(camera:valueDidChangeForProperty:)])
+            [delegate camera:camera valueDidChangeForProperty:inPropertyID];
+        
+    }else if (inEvent == kEdsPropertyEvent_PropertyDescChanged){
+        
+        [camera propertyDescDidChange:inPropertyID];
+        
+        if ([delegate respondsToSelector:@selector(camera:supportedValuesDidChangeForProperty:)])
+            [delegate camera:camera supportedValuesDidChangeForProperty:inPropertyID];
+        
+    }
     
     return EDS_ERR_OK;
     
@@ -30,6 +81,9 @@ EdsError EDSCALLBACK EOSCameraStateEventHandler(EdsStateEvent inEvent, EdsUInt32
 
     EOSCamera* camera = (__bridge EOSCamera *)(inContext);
     
+    if (EOSFRAMEWORK_EVENT_DISPATCH_ENABLED())
+        EOSFRAMEWORK_EVENT_DISPATCH(EOSProbeSerialNumber(camera), EOSProbeEvent_State, (int)inEvent, (int)inEventData);
+    
     if (inEvent == kEdsStateEvent_Shutdown)
         [[camera delegate] cameraDidDisconnect:camera];
     
@@ -44,28 +98,99 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     
     EOSCamera* camera = (__bridge EOSCamera *)(inContext);
     
+    if (EOSFRAMEWORK_EVENT_DISPATCH_ENABLED())
+        EOSFRAMEWORK_EVENT_DISPATCH(EOSProbeSerialNumber(camera), EOSProbeEvent_Object, (int)inEvent, 0);
+    
+    //the event's ref is counted until it is interned, which hands it to a wrapper or releases it as a duplicate, or it is released below
+    EOSRefTrackerAddRef(inRef, @"EdsEventRef", camera);
+    
     if (inEvent == kEdsObjectEvent_DirItemCreated)
-        [[camera delegate] camera:camera didCreateFile:[[EOSFile alloc] initWithDirectoryItemRef:inRef]];
+        [[camera delegate] camera:camera didCreateFile:[camera internDirectoryItemRef:inRef volume:nil]];
     
     else if (inEvent == kEdsObjectEvent_DirItemRemoved)
-        [[camera delegate] camera:camera didRemoveFile:[[EOSFile alloc] initWithDirectoryItemRef:inRef]];
-    
-    else if (inEvent == kEdsObjectEvent_VolumeInfoChanged)
-        [[camera delegate] camera:camera didModifyVolume:[[EOSVolume alloc] initWithVolumeRef:inRef]];
+        [[camera delegate] camera:camera didRemoveFile:[camera internDirectoryItemRef:inRef volume:nil]];
     
-    else if (inEvent == kEdsObjectEvent_VolumeUpdateItems)
-        [[camera delegate] camera:camera didFormatVolume:[[EOSVolume alloc] initWithVolumeRef:inRef]];
-    else if (inEvent == kEdsObjectEvent_DirItemRequestTransfer)
-        [[camera delegate] camera:camera didRequestTransferOfFile: [[EOSFile alloc] initWithDirectoryItemRef:inRef]];
-    else if (inRef)
-        EdsRelease(inRef);
+    else if (inEvent == kEdsObjectEvent_VolumeInfoChanged){
+        
+        void (^volumeChangeHandler)(EOSVolume*) = [camera volumeChangeHandler];
+        EOSVolume* volume = [camera internVolumeRef:inRef];
+        
+        if (volumeChangeHandler != nil)
+            volumeChangeHandler(volume);
+        
+        if ([[camera delegate] respondsToSelector:@selector(camera:didModifyVolume:)])
+            [[camera delegate] camera:camera didModifyVolume:volume];
+        
+    }else if (inEvent == kEdsObjectEvent_VolumeUpdateItems){
+        
+        void (^volumeUpdateHandler)(EOSVolume*) = [camera volumeUpdateHandler];
+        EOSVolume* volume = [camera internVolumeRef:inRef];
+        
+        if (volumeUpdateHandler != nil)
+            volumeUpdateHandler(volume);
+        
+        if ([[camera delegate] respondsToSelector:@selector(camera:didFormatVolume:)])
+            [[camera delegate] camera:camera didFormatVolume:volume];
+        
+    }else if (inEvent == kEdsObjectEvent_DirItemRequestTransfer){
+        
+        void (^transferRequestHandler)(EOSFile*) = [camera transferRequestHandler];
+        EOSFile* file = [camera internDirectoryItemRef:inRef volume:nil];
+        
+        if (transferRequestHandler != nil)
+            transferRequestHandler(file);
+        else
+            [[camera delegate] camera:camera didRequestTransferOfFile:file];
+        
+    }else if ((inEvent == kEdsObjectEvent_DirItemRequestTransferDT || inEvent == kEdsObjectEvent_DirItemCancelTransferDT) && [camera directTransferHandler] != nil){
+        
+        [camera directTransferHandler]([camera internDirectoryItemRef:inRef volume:nil], inEvent == kEdsObjectEvent_DirItemCancelTransferDT);
+        
+    }else if (inRef)
+        EOSRefTrackerRelease(inRef);
     
     return EDS_ERR_OK;
     
 }
 
-@implementation EOSCamera
+@implementation EOSCamera{
+
+    //the live wrappers of the camera's volumes and files, keyed by ref
+    NSMapTable* _internedObjects;
+
+    //the serial number of the camera's registry record, until the camera's own has been read
+    NSString* _provisionalSerialNumber;
+
+    //the serial number for logs and probes, which are read without a lock, so every string published stays alive with the camera
+    _Atomic(const char*) _probeSerialNumber;
+    NSMutableArray* _probeSerialNumbers;
+
+    //the capabilities of the camera's model, while a session is open
+    EOSCapabilities* _capabilities;
+    NSNumber* _aeMode;
+    NSUInteger _aeModeGeneration;
+    NSString* _lensName;
+    NSUInteger _lensNameGeneration;
+    NSTimeInterval _expectedDescChangeTime;
+
+    void (^_transferRequestHandler)(EOSFile*);
+    void (^_volumeUpdateHandler)(EOSVolume*);
+    void (^_volumeChangeHandler)(EOSVolume*);
+    void (^_propertyChangeHandler)(EOSProperty);
+    void (^_directTransferHandler)(EOSFile*, BOOL);
+
+    //UI locks are counted across overlapping operations, and the commands are sent while the guard is held
+    NSObject* _uiLockGuard;
+    NSUInteger _uiLockCount;
+    BOOL _isUILocked;
+
+    //advanced when a session closes, so the locks of an earlier session can't release those of a later one
+    NSUInteger _uiLockGeneration;
+
+}
+
 //@synthesize baseRef = _baseRef;
+@synthesize serialNumber = _serialNumber;
 
 -(id)initWithCameraRef:(EdsCameraRef)cameraRef{
 
@@ -74,6 +199,9 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     if (self){
 
         _isOpen = false;
+        _internedObjects = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality valueOptions:NSPointerFunctionsWeakMemory capacity:0];
+        _propertyHistory = [[EOSPropertyHistory alloc] initWithCapacity:EOSCameraPropertyHistoryCapacity];
+        _uiLockGuard = [[NSObject alloc] init];
         
         EdsDeviceInfo deviceInfo;
         
@@ -93,10 +221,197 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     
 }
 
+-(void)dealloc{
+
+    //the property, transfer and volume event handlers outlive the delegate, so they are removed here
+    EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyChanged, NULL, NULL);
+    EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyDescChanged, NULL, NULL);
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransfer, NULL, NULL);
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeUpdateItems, NULL, NULL);
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeInfoChanged, NULL, NULL);
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransferDT, NULL, NULL);
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemCancelTransferDT, NULL, NULL);
+
+}
+
 -(NSString*)description{
     return [self cameraDescription];
 }
 
+-(NSString*)serialNumber{
+    
+    @synchronized(self){
+        
+        if (_serialNumber == nil && _isOpen){
+            
+            _serialNumber = [self stringValueForProperty:EOSProperty_SerialNumber error:nil];
+            [self publishProbeSerialNumber];
+            
+        }
+        
+        return _serialNumber;
+        
+    }
+    
+}
+
+-(void (^)(EOSFile *))transferRequestHandler{
+
+    @synchronized(self){
+        return _transferRequestHandler;
+    }
+
+}
+
+-(void)setTransferRequestHandler:(void (^)(EOSFile *))transferRequestHandler{
+
+    @synchronized(self){
+        _transferRequestHandler = [transferRequestHandler copy];
+    }
+
+    //the handler is registered while either the delegate or the handler wants transfer requests
+    if (transferRequestHandler != nil || [_delegate respondsToSelector:@selector(camera:didRequestTransferOfFile:)])
+        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransfer, EOSCameraObjectEventHandler, (__bridge EdsVoid *)(self));
+    else
+        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransfer, NULL, NULL);
+
+}
+
+-(void (^)(EOSVolume *))volumeUpdateHandler{
+
+    @synchronized(self){
+        return _volumeUpdateHandler;
+    }
+
+}
+
+-(void)setVolumeUpdateHandler:(void (^)(EOSVolume *))volumeUpdateHandler{
+
+    @synchronized(self){
+        _volumeUpdateHandler = [volumeUpdateHandler copy];
+    }
+
+    if (volumeUpdateHandler != nil || [_delegate respondsToSelector:@selector(camera:didFormatVolume:)])
+        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeUpdateItems, EOSCameraObjectEventHandler, (__bridge EdsVoid *)(self));
+    else
+        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeUpdateItems, NULL, NULL);
+
+}
+
+-(void (^)(EOSVolume *))volumeChangeHandler{
+
+    @synchronized(self){
+        return _volumeChangeHandler;
+    }
+
+}
+
+-(void)setVolumeChangeHandler:(void (^)(EOSVolume *))volumeChangeHandler{
+
+    @synchronized(self){
+        _volumeChangeHandler = [volumeChangeHandler copy];
+    }
+
+    if (volumeChangeHandler != nil || [_delegate respondsToSelector:@selector(camera:didModifyVolume:)])
+        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeInfoChanged, EOSCameraObjectEventHandler, (__bridge EdsVoid *)(self));
+    else
+        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeInfoChanged, NULL, NULL);
+
+}
+
+//property events are always registered, so the handler needs no registration of its own
+-(void (^)(EOSProperty))propertyChangeHandler{
+
+    @synchronized(self){
+        return _propertyChangeHandler;
+    }
+
+}
+
+-(void)setPropertyChangeHandler:(void (^)(EOSProperty))propertyChangeHandler{
+
+    @synchronized(self){
+        _propertyChangeHandler = [propertyChangeHandler copy];
+    }
+
+}
+
+//direct transfer requests have no delegate method, so they are only registered while there is a handler
+-(void (^)(EOSFile *, BOOL))directTransferHandler{
+
+    @synchronized(self){
+        return _directTransferHandler;
+    }
+
+}
+
+-(void)setDirectTransferHandler:(void (^)(EOSFile *, BOOL))directTransferHandler{
+
+    @synchronized(self){
+        _directTransferHandler = [directTransferHandler copy];
+    }
+
+    EdsObjectEventHandler handler = directTransferHandler != nil ? EOSCameraObjectEventHandler : NULL;
+    EdsVoid* context = directTransferHandler != nil ? (__bridge EdsVoid *)(self) : NULL;
+
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransferDT, handler, context);
+    EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemCancelTransferDT, handler, context);
+
+}
+
+-(void)setCachedSerialNumber:(NSString *)serialNumber{
+
+    @synchronized(self){
+
+        _serialNumber = serialNumber;
+        _provisionalSerialNumber = nil;
+        [self publishProbeSerialNumber];
+
+    }
+
+}
+
+//called while the camera is locked
+-(void)publishProbeSerialNumber{
+
+    if (_serialNumber == nil)
+        return;
+
+    NSMutableData* data = [NSMutableData dataWithData:[_serialNumber dataUsingEncoding:NSUTF8StringEncoding]];
+    [data appendBytes:"" length:1];
+
+    if (_probeSerialNumbers == nil)
+        _probeSerialNumbers = [NSMutableArray array];
+
+    [_probeSerialNumbers addObject:data];
+    atomic_store_explicit(&_probeSerialNumber, (const char*)[data bytes], memory_order_release);
+
+}
+
+-(const char*)probeSerialNumber{
+
+    const char* serialNumber = atomic_load_explicit(&_probeSerialNumber, memory_order_acquire);
+
+    return serialNumber != NULL ? serialNumber : "";
+
+}
+
+-(void)setProvisionalSerialNumber:(NSString *)provisionalSerialNumber{
+
+    @synchronized(self){
+        _provisionalSerialNumber = provisionalSerialNumber;
+    }
+
+}
+
+-(NSString*)provisionalSerialNumber{
+
+    @synchronized(self){
+        return _provisionalSerialNumber ?: _serialNumber;
+    }
+
+}
+
 -(id)delegate{
     
     return _delegate;
@@ -105,24 +420,14 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
 
 -(void)setDelegate:(id)delegate{
     
+    //property events keep the capability cache current, so they are handled with or without a delegate
+    EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyChanged, EOSCameraPropertyEventHandler, (__bridge EdsVoid *)(self));
+    EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyDescChanged, EOSCameraPropertyEventHandler, (__bridge EdsVoid *)(self));
+    
     if (delegate != nil){
             
         //register for events
         
-        //property value change event
-        if ([delegate respondsToSelector:@selector(camera:valueDidChangeForProperty:)]){
-            
-            EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyChanged, EOSCameraPropertyEventHandler, (__bridge EdsVoid *)(self));
-            
-        }
-        
-        //property supported values change event
-        if ([delegate respondsToSelector:@selector(camera:supportedValuesDidChangeForProperty:)]){
-            
-            EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyDescChanged, EOSCameraPropertyEventHandler, (__bridge EdsVoid *)(self));
-            
-        }
-        
         //camera shutdown event
         if ([delegate respondsToSelector:@selector(cameraDidDisconnect:)]){
 
@@ -152,20 +457,20 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
         }
         
         //volume info changed event
-        if ([delegate respondsToSelector:@selector(camera:didModifyVolume:)]){
+        if ([delegate respondsToSelector:@selector(camera:didModifyVolume:)] || [self volumeChangeHandler] != nil){
             
             EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeInfoChanged, EOSCameraObjectEventHandler, (__bridge EdsVoid *)(self));
             
         }
         
         //volume formatted event
-        if ([delegate respondsToSelector:@selector(camera:didFormatVolume:)]){
+        if ([delegate respondsToSelector:@selector(camera:didFormatVolume:)] || [self volumeUpdateHandler] != nil){
             
             EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeUpdateItems, EOSCameraObjectEventHandler, (__bridge EdsVoid *)(self));
             
         }
         
-        if ([delegate respondsToSelector:@selector(camera:didRequestTransferOfFile:)]){
+        if ([delegate respondsToSelector:@selector(camera:didRequestTransferOfFile:)] || [self transferRequestHandler] != nil){
             
             EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransfer, EOSCameraObjectEventHandler, (__bridge EdsVoid *)(self));
             
@@ -175,16 +480,18 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     }else{
             
         //stop receiving events
-        EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyChanged, NULL, NULL);
-        EdsSetPropertyEventHandler(_baseRef, kEdsPropertyEvent_PropertyDescChanged, NULL, NULL);
-        
         EdsSetCameraStateEventHandler(_baseRef, kEdsStateEvent_Shutdown, NULL, NULL);
         EdsSetCameraStateEventHandler(_baseRef, kEdsStateEvent_WillSoonShutDown, NULL, NULL);
         
         EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemCreated, NULL, NULL);
         EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRemoved, NULL, NULL);
-        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeInfoChanged, NULL, NULL);
-        EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransfer, NULL, NULL);
+        
+        //volume changes and transfer requests may still be handled without a delegate
+        if ([self volumeChangeHandler] == nil)
+            EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_VolumeInfoChanged, NULL, NULL);
+        
+        if ([self transferRequestHandler] == nil)
+            EdsSetObjectEventHandler(_baseRef, kEdsObjectEvent_DirItemRequestTransfer, NULL, NULL);
         
     }
     
@@ -197,7 +504,12 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
 
 -(BOOL)openSession:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsOpenSession(_baseRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsOpenSession(_baseRef));
+    
+    if (EOSFRAMEWORK_SESSION_OPEN_ENABLED())
+        EOSFRAMEWORK_SESSION_OPEN(EOSProbeSerialNumber(self), (char*)[[self cameraDescription] UTF8String], (int)errorCode);
+    
+    EOSLog(errorCode == EOSError_OK ? EOSLogLevel_Info : EOSLogLevel_Error, "session", self, 0, "open %s on %s returned 0x%x", [[self cameraDescription] UTF8String], [[self port] UTF8String], (unsigned int)errorCode);
     
     if (errorCode != EOSError_OK){
         
@@ -208,13 +520,20 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     }
     
     _isOpen = YES;
+    [self loadCapabilities];
+    
     return YES;
     
 }
 
 -(BOOL)closeSession:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsCloseSession(_baseRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Recovery, EdsCloseSession(_baseRef));
+    
+    if (EOSFRAMEWORK_SESSION_CLOSE_ENABLED())
+        EOSFRAMEWORK_SESSION_CLOSE(EOSProbeSerialNumber(self), (int)errorCode);
+    
+    EOSLog(errorCode == EOSError_OK ? EOSLogLevel_Info : EOSLogLevel_Error, "session", self, 0, "close returned 0x%x", (unsigned int)errorCode);
     
     if (errorCode != EOSError_OK){
         
@@ -225,6 +544,24 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     }
     
     _isOpen = NO;
+    
+    @synchronized(self){
+        
+        _capabilities = nil;
+        _aeMode = nil;
+        _lensName = nil;
+        
+    }
+    
+    //the camera unlocks its UI when the session closes
+    @synchronized(_uiLockGuard){
+        
+        _uiLockCount = 0;
+        _isUILocked = NO;
+        _uiLockGeneration++;
+        
+    }
+    
     return YES;
     
 }
@@ -235,7 +572,20 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     EdsPropertyDesc propertyDesc;
     NSArray *array;
     
-    EOSError errorCode = EdsGetPropertyDesc(_baseRef, property, &propertyDesc);
+    //the supported values depend on the shooting mode, and for some properties on the lens
+    EOSCapabilities* capabilities = [self capabilities];
+    NSString* context = capabilities != nil ? [self capabilityContextForProperty:property] : nil;
+    
+    if (context != nil){
+        
+        array = [capabilities supportedValuesForProperty:property context:context];
+        
+        if (array != nil)
+            return array;
+        
+    }
+    
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetPropertyDesc(_baseRef, property, &propertyDesc));
      
     if (errorCode == EOSError_OK){
         
@@ -250,6 +600,9 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
         
         array = [NSArray arrayWithArray:mArray];
         
+        if (context != nil)
+            [capabilities setSupportedValues:array forProperty:property context:context];
+        
     }else{
         
         if (error)
@@ -268,23 +621,23 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     switch (command) {
             
         case EOSCommand_LockUI:
-            errorCode = EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_UILock, 0);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_UILock, 0));
             break;
             
         case EOSCommand_UnlockUI:
-            errorCode = EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_UIUnLock, 0);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_UIUnLock, 0));
             break;
             
         case EOSCommand_EnterDirectTransfer:
-            errorCode = EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_EnterDirectTransfer, 0);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_EnterDirectTransfer, 0));
             break;
             
         case EOSCommand_ExitDirectTransfer:
-            errorCode = EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_ExitDirectTransfer, 0);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSendStatusCommand(_baseRef, kEdsCameraStatusCommand_ExitDirectTransfer, 0));
             break;
             
         default:
-            errorCode = EdsSendCommand(_baseRef, command, (EdsInt32)parameter);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSendCommand(_baseRef, command, (EdsInt32)parameter));
             break;
     }
 
@@ -308,11 +661,93 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
 }
 
 
+-(BOOL)lockUI:(NSUInteger *)token error:(NSError *__autoreleasing *)error{
+    
+    @synchronized(_uiLockGuard){
+        
+        if (_uiLockCount == 0){
+            
+            NSError* lockError;
+            
+            if ([self sendCommand:EOSCommand_LockUI error:&lockError])
+                _isUILocked = YES;
+            
+            //the operation can still go ahead on a model that can't lock its UI
+            else if ([lockError code] != EOSError_NotSupported){
+                
+                if (error)
+                    *error = lockError;
+                return NO;
+                
+            }
+            
+        }
+        
+        _uiLockCount++;
+        
+        if (token)
+            *token = _uiLockGeneration;
+        
+    }
+    
+    return YES;
+    
+}
+
+-(BOOL)unlockUI:(NSUInteger)token error:(NSError *__autoreleasing *)error{
+    
+    @synchronized(_uiLockGuard){
+        
+        //the lock was released when its session closed
+        if (token != _uiLockGeneration || _uiLockCount == 0)
+            return YES;
+        
+        _uiLockCount--;
+        
+        if (_uiLockCount > 0 || !_isUILocked)
+            return YES;
+        
+        _isUILocked = NO;
+        
+        return [self sendCommand:EOSCommand_UnlockUI error:error];
+        
+    }
+    
+}
+
+-(BOOL)performWithLockedUI:(BOOL (^)(NSError *__autoreleasing *))block error:(NSError *__autoreleasing *)error{
+    
+    NSUInteger token;
+    
+    if (![self lockUI:&token error:error])
+        return NO;
+    
+    BOOL success = NO;
+    
+    @try{
+        
+        success = block(error);
+        
+    }@finally{
+        
+        NSError* unlockError;
+        
+        //the operation's own result is reported rather than a failure to unlock
+        if (![self unlockUI:token error:&unlockError])
+            EOSLog(EOSLogLevel_Warning, "uilock", self, 0, "unlock failed with 0x%x", (unsigned int)[unlockError code]);
+        
+    }
+    
+    return success;
+    
+}
+
+
 -(NSNumber*)volumeCount:(NSError *__autoreleasing *)error{
     
     EdsUInt32 count;
 
-    EOSError errorCode = EdsGetChildCount(_baseRef, &count);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetChildCount(_baseRef, &count));
     
     if (errorCode != EOSError_OK){
         
@@ -330,7 +765,7 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     
     EdsVolumeRef volumeRef;
     
-    EOSError errorCode = EdsGetChildAtIndex(_baseRef, (int)index, &volumeRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetChildAtIndex(_baseRef, (int)index, &volumeRef));
     
     if (errorCode != EOSError_OK){
         
@@ -340,7 +775,7 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
         
     }
     
-    return [[EOSVolume alloc] initWithVolumeRef:volumeRef];
+    return [self internVolumeRef:volumeRef];
     
 }
 
@@ -366,4 +801,244 @@ EdsError EDSCALLBACK EOSCameraObjectEventHandler(EdsObjectEvent inEvent, EdsBase
     
 }
 
+//the EDSDK returns the same ref for the same item, retained once more, so the ref identifies the item
+-(id)internedObjectForRef:(EdsBaseRef)ref create:(EOSObject* (^)(void))create{
+
+    @synchronized(_internedObjects){
+
+        EOSObject* object = [_internedObjects objectForKey:(__bridge id)ref];
+
+        if (object != nil){
+
+            //the live wrapper already holds a reference
+            EOSRefTrackerRelease(ref);
+            return object;
+
+        }
+
+        //the wrapper counts the reference from now on
+        EOSRefTrackerRemoveRef(ref);
+        object = create();
+        [_internedObjects setObject:object forKey:(__bridge id)ref];
+
+        return object;
+
+    }
+
+}
+
+-(EOSVolume*)internVolumeRef:(EdsVolumeRef)volumeRef{
+
+    return [self internedObjectForRef:volumeRef create:^EOSObject *{
+        return [[EOSVolume alloc] initWithVolumeRef:volumeRef camera:self];
+    }];
+
+}
+
+-(EOSFile*)internDirectoryItemRef:(EdsDirectoryItemRef)fileRef volume:(EOSVolume *)volume{
+
+    return [self internedObjectForRef:fileRef create:^EOSObject *{
+        return [[EOSFile alloc] initWithDirectoryItemRef:fileRef camera:self volume:volume];
+    }];
+
+}
+
+
+
+
+#pragma mark - Capabilities
+
+-(EOSCapabilities*)capabilities{
+
+    @synchronized(self){
+        return _capabilities;
+    }
+
+}
+
+-(void)loadCapabilities{
+
+    NSString* productName = [self stringValueForProperty:EOSProperty_ProductName error:nil];
+    NSString* firmwareVersion = [self stringValueForProperty:EOSProperty_FirmwareVersion error:nil];
+
+    if (productName == nil || firmwareVersion == nil)
+        return;
+
+    EOSCapabilities* capabilities = [[EOSCapabilityCache sharedCache] capabilitiesForProductName:productName firmwareVersion:firmwareVersion];
+
+    @synchronized(self){
+
+        _capabilities = capabilities;
+        _aeMode = nil;
+        _lensName = nil;
+        _expectedDescChangeTime = [NSDate timeIntervalSinceReferenceDate] + EOSCameraExpectedDescChangeInterval;
+
+    }
+
+}
+
+//the shooting mode is read once, then kept current by property events
+-(NSNumber*)currentAEMode{
+
+    NSUInteger generation;
+
+    @synchronized(self){
+
+        if (_aeMode != nil)
+            return _aeMode;
+
+        generation = _aeModeGeneration;
+
+    }
+
+    NSNumber* aeMode = [self numberValueForProperty:EOSProperty_AEMode error:nil];
+
+    @synchronized(self){
+
+        //the mode changed while it was being read
+        if (generation == _aeModeGeneration)
+            _aeMode = aeMode;
+
+    }
+
+    return aeMode;
+
+}
+
+//the lens is read once, then kept current by property events
+-(NSString*)currentLensName{
+
+    NSUInteger generation;
+
+    @synchronized(self){
+
+        if (_lensName != nil)
+            return _lensName;
+
+        generation = _lensNameGeneration;
+
+    }
+
+    NSString* lensName = [self stringValueForProperty:EOSProperty_LensName error:nil];
+
+    @synchronized(self){
+
+        if (generation == _lensNameGeneration)
+            _lensName = lensName;
+
+    }
+
+    return lensName;
+
+}
+
+//the configuration that the supported values of a property are cached for, or nil if it isn't known
+-(NSString*)capabilityContextForProperty:(EOSProperty)property{
+
+    NSNumber* aeMode = [self currentAEMode];
+
+    if (aeMode == nil)
+        return nil;
+
+    if (!EOSCameraIsLensDependent(property))
+        return [aeMode stringValue];
+
+    NSString* lensName = [self currentLensName];
+
+    return lensName != nil ? [NSString stringWithFormat:@"%@/%@", aeMode, lensName] : nil;
+
+}
+
+-(void)propertyDidChange:(EOSProperty)property{
+
+    if (property != EOSProperty_AEMode && property != EOSProperty_LensName && property != EOSProperty_isLensAttached)
+        return;
+
+    @synchronized(self){
+
+        if (property == EOSProperty_AEMode){
+
+            _aeMode = nil;
+            _aeModeGeneration++;
+
+        }else{
+
+            _lensName = nil;
+            _lensNameGeneration++;
+
+        }
+
+        _expectedDescChangeTime = [NSDate timeIntervalSinceReferenceDate] + EOSCameraExpectedDescChangeInterval;
+
+    }
+
+}
+
+-(void)propertyDescDidChange:(EOSProperty)property{
+
+    EOSCapabilities* capabilities;
+    NSString* context;
+
+    @synchronized(self){
+
+        if ([NSDate timeIntervalSinceReferenceDate] < _expectedDescChangeTime)
+            return;
+
+        capabilities = _capabilities;
+
+        if (_aeMode != nil && !EOSCameraIsLensDependent(property))
+            context = [_aeMode stringValue];
+        else if (_aeMode != nil && _lensName != nil)
+            context = [NSString stringWithFormat:@"%@/%@", _aeMode, _lensName];
+
+    }
+
+    //any other change means the cached values are wrong for this configuration, or for every configuration if it isn't known
+    [capabilities removeSupportedValuesForProperty:property context:context];
+
+}
+
+-(BOOL)getValueSize:(NSUInteger *)size dataType:(EdsDataType *)dataType forProperty:(EOSProperty)property withParameter:(NSUInteger)parameter error:(NSError *__autoreleasing *)error{
+
+    EOSCapabilities* capabilities = [self capabilities];
+
+    if ([capabilities getSize:size dataType:dataType forProperty:property parameter:parameter])
+        return YES;
+
+    if (![super getValueSize:size dataType:dataType forProperty:property withParameter:parameter error:error])
+        return NO;
+
+    [capabilities setSize:*size dataType:*dataType forProperty:property parameter:parameter];
+
+    return YES;
+
+}
+
+-(BOOL)getValue:(void *)value ofSize:(NSUInteger)size forProperty:(EOSProperty)property withParameter:(NSUInteger)parameter error:(NSError *__autoreleasing *)error{
+
+    if ([super getValue:value ofSize:size forProperty:property withParameter:parameter error:error])
+        return YES;
+
+    //the size may have come from the cache, so it is queried again next time
+    [[self capabilities] removeTraitsForProperty:property parameter:parameter];
+
+    return NO;
+
+}
+
+-(BOOL)setValue:(const void *)value ofSize:(NSUInteger)size forProperty:(EOSProperty)property withParameter:(NSUInteger)parameter error:(NSError *__autoreleasing *)error{
+
+    //numeric values are read before they are overwritten, using the cached size, so the history has the value that was replaced
+    UInt64 previousValue;
+    BOOL hasPreviousValue = (size == sizeof(UInt8) || size == sizeof(UInt16) || size == sizeof(UInt32) || size == sizeof(UInt64)) && [self getValue:&previousValue ofSize:size forProperty:property withParameter:parameter error:nil];
+
+    if (![super setValue:value ofSize:size forProperty:property withParameter:parameter error:error])
+        return NO;
+
+    EOSPropertyHistoryRecordChange(_propertyHistory, property, parameter, EOSPropertyChangeSource_Framework, value, hasPreviousValue ? &previousValue : NULL, size);
+
+    return YES;
+
+}
+
 @end
@@ -0,0 +1,105 @@
+//
+//  EOSCameraProfile.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+#import <EOSFramework/EOSPropertyObject.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+
+/*!
+ The EOSCameraProfile class stores the settings of a camera, so that they can be restored later or applied to other cameras.
+ @discussion A profile stores the raw value of each property, as returned by [EOSPropertyObject getValue:ofSize:forProperty:withParameter:error:], along with its size and data type. This means that properties with structured values, such as EOSProperty_PictureStyleDesc and EOSProperty_WhiteBalanceShift, are stored exactly. Profiles are serialized to a compact binary format using the data property.
+
+ When a profile is applied to a camera, each of the camera's current values is read once and only the properties that differ are written. Properties are written in dependency order - the shooting mode and drive mode first, then exposure settings, then white balance before colour temperature and white balance shift, then picture style before its settings - so a value is never overridden by a later change to the setting it depends on.
+
+ Cameras must have an open session when profiles are captured or applied.
+ */
+@interface EOSCameraProfile : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the properties that are captured by default.
+ @discussion These are the writable camera settings. Read-only properties, such as EOSProperty_BatteryLevel, are not included.
+ @return An array of NSNumber objects containing EOSProperty values.
+ */
++(NSArray<NSNumber*>*)defaultProperties;
+
+/*!
+ @brief Initializes a profile with the current settings of a camera.
+ @discussion Properties that are not supported by the camera are skipped.
+ @param camera The camera to read the settings from.
+ @param properties An array of NSNumber objects containing the EOSProperty values to capture, or nil to capture the default properties.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSCameraProfile, or nil if no properties could be read.
+ */
+-(nullable id)initWithCamera:(EOSCamera*)camera properties:(nullable NSArray<NSNumber*>*)properties error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Initializes a profile from its binary representation.
+ @param data The data, as returned by the data property.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSCameraProfile, or nil if the data is not a valid profile.
+ */
+-(nullable id)initWithData:(NSData*)data error:(NSError* __autoreleasing*)error;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The binary representation of the profile.
+ */
+@property (readonly) NSData* data;
+
+/*!
+ @brief The properties stored in the profile, in dependency order.
+ @discussion An array of NSNumber objects containing EOSProperty values.
+ */
+@property (readonly) NSArray<NSNumber*>* properties;
+
+/*!
+ @brief Gets the raw value of a property stored in the profile.
+ @param property The property.
+ @return The value, or nil if the property is not stored in the profile.
+ */
+-(nullable NSData*)valueForProperty:(EOSProperty)property;
+
+
+
+///-----------------------
+/// @name Applying Profiles
+///-----------------------
+
+/*!
+ @brief Gets the properties whose values differ between the profile and a camera.
+ @param camera The camera to compare with.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return An array of NSNumber objects containing EOSProperty values in dependency order, or nil if unsuccessful.
+ */
+-(nullable NSArray<NSNumber*>*)differingPropertiesForCamera:(EOSCamera*)camera error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Applies the profile to a camera.
+ @discussion Only the properties whose values differ from the camera's current values are written. Properties are written in dependency order, such as the shooting mode before the exposure settings, and each group is read from the camera only once the groups before it have been written, as writing one property can change the values of others, so each property is read once. If a property cannot be written, the remaining properties are not written. The camera's UI is locked from the first write until the profile has been applied, and isn't locked if no property differs.
+ @param camera The camera to apply the profile to.
+ @param changedProperties If not NULL, on return this contains the properties that were written.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)applyToCamera:(EOSCamera*)camera changedProperties:(NSArray<NSNumber*>* __autoreleasing _Nullable * _Nullable)changedProperties error:(NSError* __autoreleasing*)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
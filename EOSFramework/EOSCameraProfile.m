@@ -0,0 +1,408 @@
+//
+//  EOSCameraProfile.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSCameraProfile.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSError.h>
+#import <EDSDK/EDSDK.h>
+
+#define EOSProfileMagic     "EOSP"
+#define EOSProfileVersion   1
+
+//properties are written in ascending order of rank
+static NSUInteger EOSProfileRankForProperty(EOSProperty property){
+
+    switch (property){
+
+        case EOSProperty_AEModeSelect:
+        case EOSProperty_AEMode:
+            return 0;
+
+        case EOSProperty_DriveMode:
+            return 1;
+
+        case EOSProperty_ISOSpeed:
+        case EOSProperty_Aperture:
+        case EOSProperty_ShutterSpeed:
+            return 2;
+
+        case EOSProperty_ExposureCompensation:
+        case EOSProperty_FlashCompensation:
+        case EOSProperty_MeteringMode:
+        case EOSProperty_AFMode:
+        case EOSProperty_AEBracket:
+            return 3;
+
+        case EOSProperty_WhiteBalance:
+            return 4;
+
+        case EOSProperty_ColorTemperature:
+        case EOSProperty_WhiteBalanceShift:
+        case EOSProperty_WhiteBalanceBracket:
+            return 5;
+
+        case EOSProperty_PictureStyle:
+            return 6;
+
+        case EOSProperty_PictureStyleDesc:
+            return 7;
+
+        default:
+            return 8;
+
+    }
+
+}
+
+static void EOSProfileAppendUInt32(NSMutableData* data, UInt32 value){
+
+    value = OSSwapHostToLittleInt32(value);
+    [data appendBytes:&value length:sizeof(value)];
+
+}
+
+static BOOL EOSProfileReadUInt32(NSData* data, NSUInteger* offset, UInt32* value){
+
+    if (*offset + sizeof(UInt32) > [data length])
+        return NO;
+
+    UInt32 littleValue;
+    [data getBytes:&littleValue range:NSMakeRange(*offset, sizeof(littleValue))];
+
+    *value = OSSwapLittleToHostInt32(littleValue);
+    *offset += sizeof(littleValue);
+
+    return YES;
+
+}
+
+
+
+
+@implementation EOSCameraProfile{
+
+    NSMutableDictionary* _values;
+    NSMutableDictionary* _dataTypes;
+
+}
+
++(NSArray*)defaultProperties{
+
+    static NSArray* properties;
+    static dispatch_once_t pred = 0;
+
+    dispatch_once(&pred, ^{
+
+        properties = @[@(EOSProperty_AEModeSelect),
+                       @(EOSProperty_DriveMode),
+                       @(EOSProperty_ISOSpeed),
+                       @(EOSProperty_Aperture),
+                       @(EOSProperty_ShutterSpeed),
+                       @(EOSProperty_ExposureCompensation),
+                       @(EOSProperty_FlashCompensation),
+                       @(EOSProperty_MeteringMode),
+                       @(EOSProperty_AFMode),
+                       @(EOSProperty_AEBracket),
+                       @(EOSProperty_WhiteBalance),
+                       @(EOSProperty_ColorTemperature),
+                       @(EOSProperty_WhiteBalanceShift),
+                       @(EOSProperty_WhiteBalanceBracket),
+                       @(EOSProperty_PictureStyle),
+                       @(EOSProperty_PictureStyleDesc),
+                       @(EOSProperty_ColorSpace),
+                       @(EOSProperty_ImageQuality),
+                       @(EOSProperty_CaptureDestination),
+                       @(EOSProperty_NoiseReduction),
+                       @(EOSProperty_RedEye),
+                       @(EOSProperty_OwnerName),
+                       @(EOSProperty_Artist),
+                       @(EOSProperty_Copyright)];
+
+    });
+
+    return properties;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _values = [NSMutableDictionary dictionary];
+        _dataTypes = [NSMutableDictionary dictionary];
+        _properties = [NSArray array];
+
+    }
+
+    return self;
+
+}
+
+-(id)initWithCamera:(EOSCamera *)camera properties:(NSArray *)properties error:(NSError *__autoreleasing *)error{
+
+    self = [self init];
+    if (self){
+
+        if (properties == nil)
+            properties = [EOSCameraProfile defaultProperties];
+
+        NSError* readError;
+
+        for (NSNumber* property in properties){
+
+            EdsDataType dataType;
+            NSData* value = [EOSCameraProfile valueForProperty:[property unsignedIntegerValue] ofCamera:camera dataType:&dataType error:&readError];
+
+            //unsupported properties are skipped
+            if (value == nil)
+                continue;
+
+            [_values setObject:value forKey:property];
+            [_dataTypes setObject:@(dataType) forKey:property];
+
+        }
+
+        if ([_values count] == 0){
+
+            if (error)
+                *error = readError != nil ? readError : EOSCreateError(EOSError_InvalidParameter);
+            return nil;
+
+        }
+
+        [self sortProperties];
+
+    }
+
+    return self;
+
+}
+
+-(id)initWithData:(NSData *)data error:(NSError *__autoreleasing *)error{
+
+    self = [self init];
+    if (self){
+
+        NSUInteger offset = 4;
+        UInt32 version, count, i;
+
+        BOOL valid = [data length] >= 4 && memcmp([data bytes], EOSProfileMagic, 4) == 0;
+        valid = valid && EOSProfileReadUInt32(data, &offset, &version) && version == EOSProfileVersion;
+        valid = valid && EOSProfileReadUInt32(data, &offset, &count);
+
+        for (i=0; valid && i<count; i++){
+
+            UInt32 property, dataType, size;
+
+            valid = EOSProfileReadUInt32(data, &offset, &property) && EOSProfileReadUInt32(data, &offset, &dataType) && EOSProfileReadUInt32(data, &offset, &size);
+            valid = valid && offset + size <= [data length];
+
+            if (valid){
+
+                [_values setObject:[data subdataWithRange:NSMakeRange(offset, size)] forKey:@(property)];
+                [_dataTypes setObject:@(dataType) forKey:@(property)];
+                offset += size;
+
+            }
+
+        }
+
+        if (!valid || offset != [data length]){
+
+            if (error)
+                *error = EOSCreateError(EOSError_File_FormatUnrecognized);
+            return nil;
+
+        }
+
+        [self sortProperties];
+
+    }
+
+    return self;
+
+}
+
+-(void)sortProperties{
+
+    //stable, so properties with the same rank keep a predictable order
+    _properties = [[[_values allKeys] sortedArrayUsingSelector:@selector(compare:)] sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSNumber* a, NSNumber* b){
+
+        NSUInteger rankA = EOSProfileRankForProperty([a unsignedIntegerValue]);
+        NSUInteger rankB = EOSProfileRankForProperty([b unsignedIntegerValue]);
+
+        if (rankA == rankB)
+            return NSOrderedSame;
+
+        return rankA < rankB ? NSOrderedAscending : NSOrderedDescending;
+
+    }];
+
+}
+
++(NSData*)valueForProperty:(EOSProperty)property ofCamera:(EOSCamera*)camera dataType:(EdsDataType*)dataType error:(NSError* __autoreleasing*)error{
+
+    NSUInteger size = 0;
+
+    if (![camera getValueSize:&size dataType:dataType forProperty:property withParameter:0 error:error])
+        return nil;
+
+    NSMutableData* value = [NSMutableData dataWithLength:size];
+
+    if (![camera getValue:[value mutableBytes] ofSize:size forProperty:property withParameter:0 error:error])
+        return nil;
+
+    return value;
+
+}
+
+
+
+
+#pragma mark - Properties
+
+-(NSData*)data{
+
+    NSMutableData* data = [NSMutableData data];
+
+    [data appendBytes:EOSProfileMagic length:4];
+    EOSProfileAppendUInt32(data, EOSProfileVersion);
+    EOSProfileAppendUInt32(data, (UInt32)[_properties count]);
+
+    for (NSNumber* property in _properties){
+
+        NSData* value = [_values objectForKey:property];
+
+        EOSProfileAppendUInt32(data, [property unsignedIntValue]);
+        EOSProfileAppendUInt32(data, [[_dataTypes objectForKey:property] unsignedIntValue]);
+        EOSProfileAppendUInt32(data, (UInt32)[value length]);
+        [data appendData:value];
+
+    }
+
+    return [NSData dataWithData:data];
+
+}
+
+-(NSData*)valueForProperty:(EOSProperty)property{
+
+    return [_values objectForKey:@(property)];
+
+}
+
+
+
+
+#pragma mark - Applying Profiles
+
+-(NSArray*)differingPropertiesForCamera:(EOSCamera *)camera error:(NSError *__autoreleasing *)error{
+
+    return [self differingProperties:_properties forCamera:camera error:error];
+
+}
+
+-(NSArray*)differingProperties:(NSArray*)properties forCamera:(EOSCamera*)camera error:(NSError* __autoreleasing*)error{
+
+    NSMutableArray* differingProperties = [NSMutableArray array];
+
+    for (NSNumber* property in properties){
+
+        EdsDataType dataType;
+        NSError* readError;
+        NSData* currentValue = [EOSCameraProfile valueForProperty:[property unsignedIntegerValue] ofCamera:camera dataType:&dataType error:&readError];
+
+        if (currentValue == nil){
+
+            //the camera doesn't have this property, so it can't be applied
+            if ([readError code] == EOSError_Property_Unavailable || [readError code] == EOSError_NotSupported)
+                continue;
+
+            if (error)
+                *error = readError;
+            return nil;
+
+        }
+
+        if (![currentValue isEqualToData:[_values objectForKey:property]])
+            [differingProperties addObject:property];
+
+    }
+
+    return [NSArray arrayWithArray:differingProperties];
+
+}
+
+-(BOOL)applyToCamera:(EOSCamera *)camera changedProperties:(NSArray *__autoreleasing *)changedProperties error:(NSError *__autoreleasing *)error{
+
+    NSMutableArray* writtenProperties = [NSMutableArray array];
+    NSUInteger token = 0;
+    BOOL locked = NO;
+    BOOL success = NO;
+
+    @try{
+
+        NSUInteger start = 0;
+
+        //writing a rank can change the values of the ranks after it, such as the shooting mode resetting the exposure, so each rank is read and compared only when it is reached
+        while (start < [_properties count]){
+
+            NSUInteger rank = EOSProfileRankForProperty([[_properties objectAtIndex:start] unsignedIntegerValue]);
+            NSUInteger end = start + 1;
+
+            while (end < [_properties count] && EOSProfileRankForProperty([[_properties objectAtIndex:end] unsignedIntegerValue]) == rank)
+                end++;
+
+            NSArray* rankProperties = [self differingProperties:[_properties subarrayWithRange:NSMakeRange(start, end - start)] forCamera:camera error:error];
+
+            if (rankProperties == nil)
+                return NO;
+
+            //the UI is locked before the first write, so that the operator can't make the camera busy between writes, and isn't locked at all if nothing differs
+            if ([rankProperties count] > 0 && !locked){
+
+                if (![camera lockUI:&token error:error])
+                    return NO;
+
+                locked = YES;
+
+            }
+
+            for (NSNumber* property in rankProperties){
+
+                NSData* value = [_values objectForKey:property];
+
+                if (![camera setValue:[value bytes] ofSize:[value length] forProperty:[property unsignedIntegerValue] withParameter:0 error:error])
+                    return NO;
+
+                [writtenProperties addObject:property];
+
+            }
+
+            start = end;
+
+        }
+
+        success = YES;
+
+    }@finally{
+
+        //the result of applying the profile is reported rather than a failure to unlock
+        if (locked)
+            [camera unlockUI:token error:nil];
+
+        if (changedProperties)
+            *changedProperties = [NSArray arrayWithArray:writtenProperties];
+
+    }
+
+    return success;
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,85 @@
+//
+//  EOSCapabilityCache.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The EOSCapabilityCache class stores what the framework has learnt about each camera model, so that it isn't rediscovered in every session.
+ @discussion Capabilities are keyed by the camera's EOSProperty_ProductName and EOSProperty_FirmwareVersion, which are read when a session is opened. For each model and firmware, the cache stores the size and data type of each property and the supported values of each property in each shooting mode (EOSProperty_AEMode). The values of properties that depend on the lens, such as the aperture, are stored for each lens (EOSProperty_LensName) too. A camera with an open session answers [EOSPropertyObject getValueSize:dataType:forProperty:withParameter:error:] and [EOSCamera supportedValuesForProperty:error:] from the cache, so switching modes only costs a query of the shooting mode.
+
+ Commands that a camera rejects are not stored, as whether a command is accepted often depends on the camera's state or the command's parameter rather than on its model.
+
+ Cached capabilities are validated lazily. When a camera reports that the supported values of a property have changed, or a read fails after its size came from the cache, the cached answer is discarded and the camera is asked again the next time. The shooting mode is tracked through the camera's property events, so the application must run the run loop that the EDSDK delivers events on.
+
+ The cache is written to disk a few seconds after it changes.
+ */
+@interface EOSCapabilityCache : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the singleton instance of EOSCapabilityCache.
+ @return The singleton instance of EOSCapabilityCache.
+ */
++(EOSCapabilityCache*)sharedCache;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief Indicates whether cameras use the cache. The default value is YES.
+ @discussion Changes take effect the next time a session is opened.
+ */
+@property (getter=isEnabled) BOOL enabled;
+
+/*!
+ @brief The location of the cache file. The default value is Capabilities.plist in the EOSFramework directory of the user's caches directory.
+ @discussion Setting this property discards the capabilities in memory; they are loaded from the new location when they are next needed.
+ */
+@property (copy) NSURL* fileURL;
+
+/*!
+ @brief The models that have capabilities stored, each in the form "product name (firmware version)".
+ */
+@property (readonly) NSArray<NSString*>* models;
+
+
+
+///-------------------------
+/// @name Managing the Cache
+///-------------------------
+
+/*!
+ @brief Writes any unsaved changes to the cache file immediately.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)save:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Discards the capabilities of one model and firmware version.
+ @param productName The camera's EOSProperty_ProductName.
+ @param firmwareVersion The camera's EOSProperty_FirmwareVersion.
+ */
+-(void)removeCapabilitiesForProductName:(NSString*)productName firmwareVersion:(NSString*)firmwareVersion;
+
+/*!
+ @brief Discards every stored capability.
+ */
+-(void)removeAllCapabilities;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
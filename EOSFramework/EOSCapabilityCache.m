@@ -0,0 +1,456 @@
+//
+//  EOSCapabilityCache.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSCapabilityCache.h>
+#import <EOSFramework/EOSError.h>
+#import <EDSDK/EDSDK.h>
+#import "EOSPrivate.h"
+
+#define EOSCapabilityCacheVersion       2
+#define EOSCapabilityCacheSaveDelay     5.0
+
+static NSString *const EOSCapabilityCacheVersionKey = @"Version";
+static NSString *const EOSCapabilityCacheModelsKey = @"Models";
+static NSString *const EOSCapabilityTraitsKey = @"Traits";
+static NSString *const EOSCapabilitySupportedValuesKey = @"SupportedValues";
+
+@interface EOSCapabilityCache ()
+
+-(void)setNeedsSave;
+
+@end
+
+
+
+
+@implementation EOSCapabilities{
+
+    __weak EOSCapabilityCache* _cache;
+
+    //"property:parameter" to [size, data type]
+    NSMutableDictionary* _traits;
+
+    //"context:property" to the supported values, where the context is the shooting mode, and the lens for properties that depend on it
+    NSMutableDictionary* _supportedValues;
+
+}
+
+-(id)initWithPropertyList:(NSDictionary*)propertyList cache:(EOSCapabilityCache*)cache{
+
+    self = [super init];
+    if (self){
+
+        _cache = cache;
+        _traits = [NSMutableDictionary dictionary];
+        _supportedValues = [NSMutableDictionary dictionary];
+
+        NSDictionary* traits = [propertyList objectForKey:EOSCapabilityTraitsKey];
+        NSDictionary* supportedValues = [propertyList objectForKey:EOSCapabilitySupportedValuesKey];
+
+        //entries of the wrong type are dropped rather than trusted
+        if ([traits isKindOfClass:[NSDictionary class]]){
+
+            [traits enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL* stop){
+
+                if ([key isKindOfClass:[NSString class]] && [value isKindOfClass:[NSArray class]] && [value count] == 2)
+                    [_traits setObject:value forKey:key];
+
+            }];
+
+        }
+
+        if ([supportedValues isKindOfClass:[NSDictionary class]]){
+
+            [supportedValues enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL* stop){
+
+                if ([key isKindOfClass:[NSString class]] && [value isKindOfClass:[NSArray class]])
+                    [_supportedValues setObject:value forKey:key];
+
+            }];
+
+        }
+
+    }
+
+    return self;
+
+}
+
+-(NSDictionary*)propertyList{
+
+    @synchronized(self){
+
+        return @{EOSCapabilityTraitsKey: [_traits copy],
+                 EOSCapabilitySupportedValuesKey: [_supportedValues copy]};
+
+    }
+
+}
+
+-(BOOL)getSize:(NSUInteger *)size dataType:(EdsDataType *)dataType forProperty:(EOSProperty)property parameter:(NSUInteger)parameter{
+
+    NSArray* traits;
+
+    @synchronized(self){
+        traits = [_traits objectForKey:[NSString stringWithFormat:@"%lu:%lu", (unsigned long)property, (unsigned long)parameter]];
+    }
+
+    if (traits == nil)
+        return NO;
+
+    *size = [[traits objectAtIndex:0] unsignedIntegerValue];
+    *dataType = [[traits objectAtIndex:1] unsignedIntValue];
+
+    return YES;
+
+}
+
+-(void)setSize:(NSUInteger)size dataType:(EdsDataType)dataType forProperty:(EOSProperty)property parameter:(NSUInteger)parameter{
+
+    //the size of a string or block depends on its value, not on the model
+    if (dataType == kEdsDataType_String || dataType == kEdsDataType_ByteBlock)
+        return;
+
+    @synchronized(self){
+        [_traits setObject:@[@(size), @(dataType)] forKey:[NSString stringWithFormat:@"%lu:%lu", (unsigned long)property, (unsigned long)parameter]];
+    }
+
+    [_cache setNeedsSave];
+
+}
+
+-(void)removeTraitsForProperty:(EOSProperty)property parameter:(NSUInteger)parameter{
+
+    @synchronized(self){
+        [_traits removeObjectForKey:[NSString stringWithFormat:@"%lu:%lu", (unsigned long)property, (unsigned long)parameter]];
+    }
+
+    [_cache setNeedsSave];
+
+}
+
+-(NSArray*)supportedValuesForProperty:(EOSProperty)property context:(NSString *)context{
+
+    @synchronized(self){
+        return [_supportedValues objectForKey:[NSString stringWithFormat:@"%@:%lu", context, (unsigned long)property]];
+    }
+
+}
+
+-(void)setSupportedValues:(NSArray *)supportedValues forProperty:(EOSProperty)property context:(NSString *)context{
+
+    @synchronized(self){
+        [_supportedValues setObject:supportedValues forKey:[NSString stringWithFormat:@"%@:%lu", context, (unsigned long)property]];
+    }
+
+    [_cache setNeedsSave];
+
+}
+
+-(void)removeSupportedValuesForProperty:(EOSProperty)property context:(NSString *)context{
+
+    @synchronized(self){
+
+        if (context != nil){
+
+            [_supportedValues removeObjectForKey:[NSString stringWithFormat:@"%@:%lu", context, (unsigned long)property]];
+
+        }else{
+
+            NSString* suffix = [NSString stringWithFormat:@":%lu", (unsigned long)property];
+
+            for (NSString* key in [_supportedValues allKeys]){
+
+                if ([key hasSuffix:suffix])
+                    [_supportedValues removeObjectForKey:key];
+
+            }
+
+        }
+
+    }
+
+    [_cache setNeedsSave];
+
+}
+
+@end
+
+
+
+
+@implementation EOSCapabilityCache{
+
+    dispatch_queue_t _queue;
+    NSMutableDictionary* _capabilities;
+    BOOL _loaded;
+    BOOL _saveScheduled;
+
+}
+
+@synthesize enabled = _enabled;
+@synthesize fileURL = _fileURL;
+
++(EOSCapabilityCache*)sharedCache{
+
+    static EOSCapabilityCache* sharedCache;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^(void){
+        sharedCache = [[EOSCapabilityCache alloc] init];
+    });
+
+    return sharedCache;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _queue = dispatch_queue_create("com.EOSFramework.capabilities", DISPATCH_QUEUE_SERIAL);
+        _capabilities = [NSMutableDictionary dictionary];
+        _enabled = YES;
+
+        NSURL* cachesURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+        _fileURL = [[cachesURL URLByAppendingPathComponent:@"EOSFramework" isDirectory:YES] URLByAppendingPathComponent:@"Capabilities.plist"];
+
+    }
+
+    return self;
+
+}
+
+-(BOOL)isEnabled{
+
+    __block BOOL enabled;
+
+    dispatch_sync(_queue, ^(void){
+        enabled = _enabled;
+    });
+
+    return enabled;
+
+}
+
+-(void)setEnabled:(BOOL)enabled{
+
+    dispatch_sync(_queue, ^(void){
+        _enabled = enabled;
+    });
+
+}
+
+-(NSURL*)fileURL{
+
+    __block NSURL* fileURL;
+
+    dispatch_sync(_queue, ^(void){
+        fileURL = _fileURL;
+    });
+
+    return fileURL;
+
+}
+
+-(void)setFileURL:(NSURL *)fileURL{
+
+    dispatch_sync(_queue, ^(void){
+
+        _fileURL = [fileURL copy];
+        [_capabilities removeAllObjects];
+        _loaded = NO;
+
+    });
+
+}
+
+-(NSArray*)models{
+
+    __block NSArray* models;
+
+    dispatch_sync(_queue, ^(void){
+
+        [self loadOnQueue];
+        models = [[_capabilities allKeys] sortedArrayUsingSelector:@selector(compare:)];
+
+    });
+
+    return models;
+
+}
+
+
+
+
+#pragma mark - Loading and Saving
+
+//must be called on the queue
+-(void)loadOnQueue{
+
+    if (_loaded)
+        return;
+
+    _loaded = YES;
+
+    NSData* data = [NSData dataWithContentsOfURL:_fileURL];
+
+    if (data == nil)
+        return;
+
+    NSDictionary* propertyList = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+
+    //a cache from another version is rebuilt rather than migrated
+    if (![propertyList isKindOfClass:[NSDictionary class]] || [[propertyList objectForKey:EOSCapabilityCacheVersionKey] integerValue] != EOSCapabilityCacheVersion)
+        return;
+
+    NSDictionary* models = [propertyList objectForKey:EOSCapabilityCacheModelsKey];
+
+    if (![models isKindOfClass:[NSDictionary class]])
+        return;
+
+    [models enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL* stop){
+
+        if ([key isKindOfClass:[NSString class]] && [value isKindOfClass:[NSDictionary class]])
+            [_capabilities setObject:[[EOSCapabilities alloc] initWithPropertyList:value cache:self] forKey:key];
+
+    }];
+
+}
+
+//must be called on the queue
+-(BOOL)saveOnQueue:(NSError* __autoreleasing*)error{
+
+    NSMutableDictionary* models = [NSMutableDictionary dictionaryWithCapacity:[_capabilities count]];
+
+    [_capabilities enumerateKeysAndObjectsUsingBlock:^(NSString* key, EOSCapabilities* capabilities, BOOL* stop){
+        [models setObject:[capabilities propertyList] forKey:key];
+    }];
+
+    NSDictionary* propertyList = @{EOSCapabilityCacheVersionKey: @(EOSCapabilityCacheVersion), EOSCapabilityCacheModelsKey: models};
+    NSData* data = [NSPropertyListSerialization dataWithPropertyList:propertyList format:NSPropertyListBinaryFormat_v1_0 options:0 error:error];
+
+    if (data == nil)
+        return NO;
+
+    if (![[NSFileManager defaultManager] createDirectoryAtURL:[_fileURL URLByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:error])
+        return NO;
+
+    return [data writeToURL:_fileURL options:NSDataWritingAtomic error:error];
+
+}
+
+-(BOOL)save:(NSError *__autoreleasing *)error{
+
+    __block BOOL success = YES;
+    __block NSError* saveError;
+
+    dispatch_sync(_queue, ^(void){
+
+        if (_saveScheduled){
+
+            _saveScheduled = NO;
+            success = [self saveOnQueue:&saveError];
+
+        }
+
+    });
+
+    if (!success && error)
+        *error = saveError;
+
+    return success;
+
+}
+
+//changes arrive in bursts when a session opens, so they are written together
+-(void)setNeedsSave{
+
+    dispatch_async(_queue, ^(void){
+
+        if (_saveScheduled)
+            return;
+
+        _saveScheduled = YES;
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, EOSCapabilityCacheSaveDelay * NSEC_PER_SEC), _queue, ^(void){
+
+            if (!_saveScheduled)
+                return;
+
+            _saveScheduled = NO;
+            [self saveOnQueue:nil];
+
+        });
+
+    });
+
+}
+
+
+
+
+#pragma mark - Capabilities
+
+-(EOSCapabilities*)capabilitiesForProductName:(NSString *)productName firmwareVersion:(NSString *)firmwareVersion{
+
+    __block EOSCapabilities* capabilities;
+    NSString* key = [NSString stringWithFormat:@"%@ (%@)", productName, firmwareVersion];
+
+    dispatch_sync(_queue, ^(void){
+
+        if (!_enabled)
+            return;
+
+        [self loadOnQueue];
+
+        capabilities = [_capabilities objectForKey:key];
+
+        if (capabilities == nil){
+
+            capabilities = [[EOSCapabilities alloc] initWithPropertyList:@{} cache:self];
+            [_capabilities setObject:capabilities forKey:key];
+
+        }
+
+    });
+
+    return capabilities;
+
+}
+
+-(void)removeCapabilitiesForProductName:(NSString *)productName firmwareVersion:(NSString *)firmwareVersion{
+
+    NSString* key = [NSString stringWithFormat:@"%@ (%@)", productName, firmwareVersion];
+
+    dispatch_sync(_queue, ^(void){
+
+        [self loadOnQueue];
+        [_capabilities removeObjectForKey:key];
+
+    });
+
+    [self setNeedsSave];
+
+}
+
+-(void)removeAllCapabilities{
+
+    dispatch_sync(_queue, ^(void){
+
+        [_capabilities removeAllObjects];
+        _loaded = YES;
+
+    });
+
+    [self setNeedsSave];
+
+}
+
+@end
\ No newline at end of file
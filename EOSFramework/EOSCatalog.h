@@ -0,0 +1,196 @@
+//
+//  EOSCatalog.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSFile;
+@class EOSFileInfo;
+
+/*!
+ The EOSCatalogRecord class describes a single downloaded file. Instances of this class are created by EOSCatalog.
+ */
+@interface EOSCatalogRecord : NSObject
+
+/*!
+ @brief The unique identifier of the record within the catalog.
+ */
+@property (readonly) int64_t recordID;
+
+/*!
+ @brief The serial number of the camera that the file was downloaded from.
+ */
+@property (readonly) NSString* cameraSerialNumber;
+
+/*!
+ @brief The name of the volume that the file was stored on.
+ */
+@property (readonly, nullable) NSString* volumeName;
+
+/*!
+ @brief The name of the file on the camera.
+ */
+@property (readonly) NSString* originalName;
+
+/*!
+ @brief The group ID of the file.
+ @discussion Files that belong to the same group, such as RAW+JPEG images, have the same group ID.
+ */
+@property (readonly) NSUInteger groupID;
+
+/*!
+ @brief The size of the file, in bytes.
+ */
+@property (readonly) UInt64 size;
+
+/*!
+ @brief The date that the file was created on the camera.
+ */
+@property (readonly, nullable) NSDate* captureDate;
+
+/*!
+ @brief The SHA-256 checksum of the file.
+ */
+@property (readonly, nullable) NSData* checksum;
+
+/*!
+ @brief The current location of the downloaded file.
+ */
+@property (readonly) NSURL* localURL;
+
+/*!
+ @brief The date that the file was downloaded.
+ */
+@property (readonly) NSDate* downloadDate;
+
+@end
+
+
+
+/*!
+ The EOSCatalog class is a persistent index of downloaded files.
+ @discussion The catalog is stored in an SQLite database, with indexes on capture date, camera, original name, checksum and location, so queries remain fast with millions of records. Records are typically added by [EOSFile downloadWithOptions:delegate:contextInfo:] when the EOSDownloadCatalogKey option is provided. When a file is moved to an archive directory by EOSArchiveDirectoryURLKey, its location is updated.
+
+ All methods of this class are thread safe.
+ */
+@interface EOSCatalog : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Opens the catalog at a URL, creating it if necessary.
+ @param url The URL of the catalog database.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSCatalog, or nil if the catalog could not be opened.
+ */
+-(nullable id)initWithURL:(NSURL*)url error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief The URL of the catalog database.
+ */
+@property (readonly) NSURL* URL;
+
+
+
+///-----------------------
+/// @name Managing Records
+///-----------------------
+
+/*!
+ @brief Adds a record for a downloaded file.
+ @param file The file that was downloaded. The serial number of the file's camera and the name of its volume are recorded.
+ @param info The information of the file, as returned by [EOSFile info:].
+ @param localURL The location of the downloaded file.
+ @param checksum The SHA-256 checksum of the downloaded file, or nil.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)addRecordForFile:(EOSFile*)file info:(EOSFileInfo*)info localURL:(NSURL*)localURL checksum:(nullable NSData*)checksum error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Updates the location of a file that has been moved.
+ @param localURL The previous location of the file.
+ @param newURL The new location of the file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)moveRecordAtURL:(NSURL*)localURL toURL:(NSURL*)newURL error:(NSError* __autoreleasing*)error;
+
+
+
+///-----------------------
+/// @name Querying Records
+///-----------------------
+
+/*!
+ @brief The number of records in the catalog.
+ */
+@property (readonly) NSUInteger recordCount;
+
+/*!
+ @brief Gets the serial numbers of all cameras that have records in the catalog.
+ @return An array of serial numbers.
+ */
+-(NSArray<NSString*>*)cameraSerialNumbers;
+
+/*!
+ @brief Gets the records of files captured within a period of time, ordered by capture date.
+ @param startDate The start of the period, or nil for no limit.
+ @param endDate The end of the period (exclusive), or nil for no limit.
+ @return An array of EOSCatalogRecord objects.
+ */
+-(NSArray<EOSCatalogRecord*>*)recordsCapturedFrom:(nullable NSDate*)startDate to:(nullable NSDate*)endDate;
+
+/*!
+ @brief Gets the records of files captured by a camera within a period of time, ordered by capture date.
+ @param serialNumber The serial number of the camera.
+ @param startDate The start of the period, or nil for no limit.
+ @param endDate The end of the period (exclusive), or nil for no limit.
+ @return An array of EOSCatalogRecord objects.
+ */
+-(NSArray<EOSCatalogRecord*>*)recordsForCameraSerialNumber:(NSString*)serialNumber capturedFrom:(nullable NSDate*)startDate to:(nullable NSDate*)endDate;
+
+/*!
+ @brief Gets the records of files with an original name.
+ @param originalName The name of the file on the camera.
+ @return An array of EOSCatalogRecord objects.
+ */
+-(NSArray<EOSCatalogRecord*>*)recordsWithOriginalName:(NSString*)originalName;
+
+/*!
+ @brief Gets the record of a file with a checksum.
+ @param checksum The SHA-256 checksum of the file.
+ @return The record, or nil if there is no file with the checksum.
+ */
+-(nullable EOSCatalogRecord*)recordWithChecksum:(NSData*)checksum;
+
+/*!
+ @brief Gets the record of a file at a location.
+ @param localURL The location of the file.
+ @return The record, or nil if there is no file at the location.
+ */
+-(nullable EOSCatalogRecord*)recordAtURL:(NSURL*)localURL;
+
+
+
+///-------------------------
+/// @name Closing the Catalog
+///-------------------------
+
+/*!
+ @brief Closes the catalog database.
+ @discussion Any further use of the catalog will fail.
+ */
+-(void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,505 @@
+//
+//  EOSCatalog.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSCatalog.h>
+#import <EOSFramework/EOSFile.h>
+#import <EOSFramework/EOSVolume.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSError.h>
+#include <sqlite3.h>
+
+static NSString* const EOSCatalogSchema =
+    @"CREATE TABLE IF NOT EXISTS files ("
+    @"id INTEGER PRIMARY KEY, "
+    @"camera TEXT NOT NULL, "
+    @"volume TEXT, "
+    @"name TEXT NOT NULL, "
+    @"group_id INTEGER NOT NULL, "
+    @"size INTEGER NOT NULL, "
+    @"capture_time REAL, "
+    @"checksum BLOB, "
+    @"path TEXT NOT NULL, "
+    @"download_time REAL NOT NULL);"
+    @"CREATE INDEX IF NOT EXISTS files_capture_time ON files(capture_time);"
+    @"CREATE INDEX IF NOT EXISTS files_camera_capture_time ON files(camera, capture_time);"
+    @"CREATE INDEX IF NOT EXISTS files_name ON files(name);"
+    @"CREATE INDEX IF NOT EXISTS files_checksum ON files(checksum);"
+    @"CREATE INDEX IF NOT EXISTS files_path ON files(path);";
+
+static NSString* const EOSCatalogColumns = @"id, camera, volume, name, group_id, size, capture_time, checksum, path, download_time";
+
+static EOSError EOSErrorFromSQLiteResult(int result){
+
+    switch (result){
+
+        case SQLITE_FULL:
+            return EOSError_File_DiskFull;
+        case SQLITE_CANTOPEN:
+            return EOSError_File_OpenError;
+        case SQLITE_PERM:
+        case SQLITE_READONLY:
+            return EOSError_File_PermissionError;
+        case SQLITE_CORRUPT:
+            return EOSError_File_DataCorrupt;
+        case SQLITE_NOTADB:
+            return EOSError_File_FormatUnrecognized;
+        default:
+            return EOSError_File_IOError;
+
+    }
+
+}
+
+
+
+
+@interface EOSCatalogRecord ()
+
+@property int64_t recordID;
+@property NSString* cameraSerialNumber;
+@property (nullable) NSString* volumeName;
+@property NSString* originalName;
+@property NSUInteger groupID;
+@property UInt64 size;
+@property (nullable) NSDate* captureDate;
+@property (nullable) NSData* checksum;
+@property NSURL* localURL;
+@property NSDate* downloadDate;
+
+@end
+
+@implementation EOSCatalogRecord
+
+@end
+
+
+
+
+@implementation EOSCatalog{
+
+    sqlite3* _db;
+    dispatch_queue_t _queue;
+    NSMutableDictionary* _statements;
+
+}
+
+-(id)initWithURL:(NSURL *)url error:(NSError *__autoreleasing *)error{
+
+    self = [super init];
+    if (self){
+
+        _URL = url;
+        _statements = [NSMutableDictionary dictionary];
+        _queue = dispatch_queue_create("com.EOSFramework.catalog", DISPATCH_QUEUE_SERIAL);
+
+        int result = sqlite3_open_v2([[url path] fileSystemRepresentation], &_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, NULL);
+
+        if (result == SQLITE_OK)
+            result = sqlite3_exec(_db, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
+
+        if (result == SQLITE_OK)
+            result = sqlite3_exec(_db, [EOSCatalogSchema UTF8String], NULL, NULL, NULL);
+
+        if (result != SQLITE_OK){
+
+            if (error)
+                *error = EOSCreateError(EOSErrorFromSQLiteResult(result));
+
+            [self close];
+            return nil;
+
+        }
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    [self closeOnQueue];
+
+}
+
+
+
+
+#pragma mark - Statements
+
+//must be called on _queue
+-(sqlite3_stmt*)statementForSQL:(NSString*)sql{
+
+    NSValue* value = [_statements objectForKey:sql];
+
+    if (value != nil){
+
+        sqlite3_stmt* statement = [value pointerValue];
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+        return statement;
+
+    }
+
+    sqlite3_stmt* statement = NULL;
+
+    if (_db == NULL || sqlite3_prepare_v2(_db, [sql UTF8String], -1, &statement, NULL) != SQLITE_OK)
+        return NULL;
+
+    [_statements setObject:[NSValue valueWithPointer:statement] forKey:sql];
+    return statement;
+
+}
+
+static void EOSCatalogBindText(sqlite3_stmt* statement, int index, NSString* text){
+
+    if (text != nil)
+        sqlite3_bind_text(statement, index, [text UTF8String], -1, SQLITE_TRANSIENT);
+    else
+        sqlite3_bind_null(statement, index);
+
+}
+
+static void EOSCatalogBindDate(sqlite3_stmt* statement, int index, NSDate* date){
+
+    if (date != nil)
+        sqlite3_bind_double(statement, index, [date timeIntervalSince1970]);
+    else
+        sqlite3_bind_null(statement, index);
+
+}
+
+static NSString* EOSCatalogColumnText(sqlite3_stmt* statement, int index){
+
+    const unsigned char* text = sqlite3_column_text(statement, index);
+    return text != NULL ? [NSString stringWithUTF8String:(const char*)text] : nil;
+
+}
+
+//must be called on _queue
+-(NSArray*)recordsForStatement:(sqlite3_stmt*)statement{
+
+    NSMutableArray* records = [NSMutableArray array];
+
+    if (statement == NULL)
+        return records;
+
+    while (sqlite3_step(statement) == SQLITE_ROW){
+
+        EOSCatalogRecord* record = [[EOSCatalogRecord alloc] init];
+
+        [record setRecordID:sqlite3_column_int64(statement, 0)];
+        [record setCameraSerialNumber:EOSCatalogColumnText(statement, 1)];
+        [record setVolumeName:EOSCatalogColumnText(statement, 2)];
+        [record setOriginalName:EOSCatalogColumnText(statement, 3)];
+        [record setGroupID:(NSUInteger)sqlite3_column_int64(statement, 4)];
+        [record setSize:(UInt64)sqlite3_column_int64(statement, 5)];
+
+        if (sqlite3_column_type(statement, 6) != SQLITE_NULL)
+            [record setCaptureDate:[NSDate dateWithTimeIntervalSince1970:sqlite3_column_double(statement, 6)]];
+
+        if (sqlite3_column_type(statement, 7) != SQLITE_NULL)
+            [record setChecksum:[NSData dataWithBytes:sqlite3_column_blob(statement, 7) length:sqlite3_column_bytes(statement, 7)]];
+
+        [record setLocalURL:[NSURL fileURLWithPath:EOSCatalogColumnText(statement, 8)]];
+        [record setDownloadDate:[NSDate dateWithTimeIntervalSince1970:sqlite3_column_double(statement, 9)]];
+
+        [records addObject:record];
+
+    }
+
+    sqlite3_reset(statement);
+
+    return [NSArray arrayWithArray:records];
+
+}
+
+
+
+
+#pragma mark - Managing Records
+
+-(BOOL)addRecordForFile:(EOSFile *)file info:(EOSFileInfo *)info localURL:(NSURL *)localURL checksum:(NSData *)checksum error:(NSError *__autoreleasing *)error{
+
+    NSString* serialNumber = [[file camera] serialNumber];
+    NSString* volumeName = [[[file volume] info:nil] name];
+
+    __block int result;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:@"INSERT INTO files (camera, volume, name, group_id, size, capture_time, checksum, path, download_time) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"];
+
+        if (statement == NULL){
+
+            result = SQLITE_ERROR;
+            return;
+
+        }
+
+        EOSCatalogBindText(statement, 1, serialNumber != nil ? serialNumber : @"");
+        EOSCatalogBindText(statement, 2, volumeName);
+        EOSCatalogBindText(statement, 3, [info name]);
+        sqlite3_bind_int64(statement, 4, [info groupID]);
+        sqlite3_bind_int64(statement, 5, [info size]);
+        EOSCatalogBindDate(statement, 6, [info captureDate]);
+
+        if (checksum != nil)
+            sqlite3_bind_blob(statement, 7, [checksum bytes], (int)[checksum length], SQLITE_TRANSIENT);
+        else
+            sqlite3_bind_null(statement, 7);
+
+        EOSCatalogBindText(statement, 8, [[localURL absoluteURL] path]);
+        EOSCatalogBindDate(statement, 9, [NSDate date]);
+
+        result = sqlite3_step(statement);
+        sqlite3_reset(statement);
+
+    });
+
+    if (result != SQLITE_DONE){
+
+        if (error)
+            *error = EOSCreateError(EOSErrorFromSQLiteResult(result));
+        return NO;
+
+    }
+
+    return YES;
+
+}
+
+-(BOOL)moveRecordAtURL:(NSURL *)localURL toURL:(NSURL *)newURL error:(NSError *__autoreleasing *)error{
+
+    __block int result;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:@"UPDATE files SET path = ? WHERE path = ?"];
+
+        if (statement == NULL){
+
+            result = SQLITE_ERROR;
+            return;
+
+        }
+
+        EOSCatalogBindText(statement, 1, [[newURL absoluteURL] path]);
+        EOSCatalogBindText(statement, 2, [[localURL absoluteURL] path]);
+
+        result = sqlite3_step(statement);
+        sqlite3_reset(statement);
+
+    });
+
+    if (result != SQLITE_DONE){
+
+        if (error)
+            *error = EOSCreateError(EOSErrorFromSQLiteResult(result));
+        return NO;
+
+    }
+
+    return YES;
+
+}
+
+
+
+
+#pragma mark - Querying Records
+
+-(NSUInteger)recordCount{
+
+    __block NSUInteger count = 0;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:@"SELECT COUNT(*) FROM files"];
+
+        if (statement != NULL && sqlite3_step(statement) == SQLITE_ROW)
+            count = (NSUInteger)sqlite3_column_int64(statement, 0);
+
+        if (statement != NULL)
+            sqlite3_reset(statement);
+
+    });
+
+    return count;
+
+}
+
+-(NSArray*)cameraSerialNumbers{
+
+    __block NSMutableArray* serialNumbers = [NSMutableArray array];
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:@"SELECT DISTINCT camera FROM files"];
+
+        if (statement == NULL)
+            return;
+
+        while (sqlite3_step(statement) == SQLITE_ROW)
+            [serialNumbers addObject:EOSCatalogColumnText(statement, 0)];
+
+        sqlite3_reset(statement);
+
+    });
+
+    return [NSArray arrayWithArray:serialNumbers];
+
+}
+
+-(NSArray*)recordsCapturedFrom:(NSDate *)startDate to:(NSDate *)endDate{
+
+    __block NSArray* records;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT %@ FROM files WHERE capture_time >= ? AND capture_time < ? ORDER BY capture_time", EOSCatalogColumns]];
+
+        if (statement != NULL){
+
+            sqlite3_bind_double(statement, 1, startDate != nil ? [startDate timeIntervalSince1970] : -DBL_MAX);
+            sqlite3_bind_double(statement, 2, endDate != nil ? [endDate timeIntervalSince1970] : DBL_MAX);
+
+        }
+
+        records = [self recordsForStatement:statement];
+
+    });
+
+    return records;
+
+}
+
+-(NSArray*)recordsForCameraSerialNumber:(NSString *)serialNumber capturedFrom:(NSDate *)startDate to:(NSDate *)endDate{
+
+    __block NSArray* records;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement;
+
+        //files without a capture date are only included when the period is unlimited
+        if (startDate == nil && endDate == nil){
+
+            statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT %@ FROM files WHERE camera = ? ORDER BY capture_time", EOSCatalogColumns]];
+
+            if (statement != NULL)
+                EOSCatalogBindText(statement, 1, serialNumber);
+
+        }else{
+
+            statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT %@ FROM files WHERE camera = ? AND capture_time >= ? AND capture_time < ? ORDER BY capture_time", EOSCatalogColumns]];
+
+            if (statement != NULL){
+
+                EOSCatalogBindText(statement, 1, serialNumber);
+                sqlite3_bind_double(statement, 2, startDate != nil ? [startDate timeIntervalSince1970] : -DBL_MAX);
+                sqlite3_bind_double(statement, 3, endDate != nil ? [endDate timeIntervalSince1970] : DBL_MAX);
+
+            }
+
+        }
+
+        records = [self recordsForStatement:statement];
+
+    });
+
+    return records;
+
+}
+
+-(NSArray*)recordsWithOriginalName:(NSString *)originalName{
+
+    __block NSArray* records;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT %@ FROM files WHERE name = ?", EOSCatalogColumns]];
+
+        if (statement != NULL)
+            EOSCatalogBindText(statement, 1, originalName);
+
+        records = [self recordsForStatement:statement];
+
+    });
+
+    return records;
+
+}
+
+-(EOSCatalogRecord*)recordWithChecksum:(NSData *)checksum{
+
+    __block NSArray* records;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT %@ FROM files WHERE checksum = ? LIMIT 1", EOSCatalogColumns]];
+
+        if (statement != NULL)
+            sqlite3_bind_blob(statement, 1, [checksum bytes], (int)[checksum length], SQLITE_TRANSIENT);
+
+        records = [self recordsForStatement:statement];
+
+    });
+
+    return [records firstObject];
+
+}
+
+-(EOSCatalogRecord*)recordAtURL:(NSURL *)localURL{
+
+    __block NSArray* records;
+
+    dispatch_sync(_queue, ^(void){
+
+        sqlite3_stmt* statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT %@ FROM files WHERE path = ? LIMIT 1", EOSCatalogColumns]];
+
+        if (statement != NULL)
+            EOSCatalogBindText(statement, 1, [[localURL absoluteURL] path]);
+
+        records = [self recordsForStatement:statement];
+
+    });
+
+    return [records firstObject];
+
+}
+
+
+
+
+#pragma mark - Closing
+
+//must be called on _queue, or when no other thread can use the catalog
+-(void)closeOnQueue{
+
+    for (NSValue* value in [_statements allValues])
+        sqlite3_finalize([value pointerValue]);
+
+    [_statements removeAllObjects];
+
+    if (_db != NULL)
+        sqlite3_close(_db);
+
+    _db = NULL;
+
+}
+
+-(void)close{
+
+    dispatch_sync(_queue, ^(void){
+        [self closeOnQueue];
+    });
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,158 @@
+//
+//  EOSClockSync.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSFleetResult;
+
+/*!
+ The EOSClockOffset class models the offset between a camera's clock and the host's clock. Instances of this class are created by EOSClockSync.
+ */
+@interface EOSClockOffset : NSObject
+
+/*!
+ @brief Initializes an offset.
+ @param offset The camera's time minus the host's time, in seconds.
+ @param uncertainty The maximum error of the offset, in seconds.
+ @param roundTripTime The time taken to read the camera's clock, in seconds.
+ @param drift The rate at which the offset changes, in seconds per second.
+ @param measurementDate The host time at which the offset was measured.
+ @return The initialized EOSClockOffset.
+ */
+-(id)initWithOffset:(NSTimeInterval)offset uncertainty:(NSTimeInterval)uncertainty roundTripTime:(NSTimeInterval)roundTripTime drift:(double)drift measurementDate:(NSDate*)measurementDate;
+
+/*!
+ @brief The camera's time minus the host's time when the offset was measured, in seconds.
+ */
+@property (readonly) NSTimeInterval offset;
+
+/*!
+ @brief The maximum error of the offset, in seconds.
+ */
+@property (readonly) NSTimeInterval uncertainty;
+
+/*!
+ @brief The time taken to read the camera's clock, in seconds.
+ */
+@property (readonly) NSTimeInterval roundTripTime;
+
+/*!
+ @brief The rate at which the offset changes, in seconds per second.
+ @discussion This is 0 until the camera has been measured twice, far enough apart for the drift to be estimated.
+ */
+@property (readonly) double drift;
+
+/*!
+ @brief The host time at which the offset was measured.
+ */
+@property (readonly) NSDate* measurementDate;
+
+/*!
+ @brief Predicts the offset at a given time, taking drift into account.
+ @param date The host time.
+ @return The camera's time minus the host's time, in seconds.
+ */
+-(NSTimeInterval)offsetAtDate:(NSDate*)date;
+
+/*!
+ @brief Converts a time read from the camera, such as a capture time, to host time.
+ @param cameraDate The camera time.
+ @return The host time.
+ */
+-(NSDate*)hostDateForCameraDate:(NSDate*)cameraDate;
+
+/*!
+ @brief Converts a host time to the camera's time.
+ @param hostDate The host time.
+ @return The camera time.
+ */
+-(NSDate*)cameraDateForHostDate:(NSDate*)hostDate;
+
+@end
+
+
+
+/*!
+ The EOSClockSync class measures and corrects the clocks of cameras, so that capture times from several cameras can be compared.
+ @discussion A camera reports its clock (EOSProperty_DateTime) to the nearest second. To measure the offset more precisely, the clock is read repeatedly until its second changes; the change happened between the two reads on either side of it, and each read is timestamped at the midpoint of its round trip. This gives an offset whose error is bounded by the read interval and round trip time, typically a few tens of milliseconds.
+
+ When a camera is synchronized, the host time is written just before a whole second, early by half the round trip time, so that the camera's second starts as close as possible to the host's. The camera is then measured again, and the residual offset is recorded. The latest offset of each camera is kept, along with an estimate of its drift, for correcting capture times.
+
+ The methods that take a single camera are synchronous and take up to a few seconds; the methods that take several cameras run in parallel. Cameras must have an open session.
+ */
+@interface EOSClockSync : NSObject
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The maximum number of cameras that are measured or synchronized at once. The default value is 8.
+ */
+@property NSUInteger maxConcurrentOperations;
+
+/*!
+ @brief Cameras whose offset is within this many seconds are not written to when synchronizing. The default value is 0.25.
+ */
+@property NSTimeInterval tolerance;
+
+
+
+///-------------------------
+/// @name Measuring Offsets
+///-------------------------
+
+/*!
+ @brief Measures the offset of a camera's clock.
+ @param camera The camera.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The offset, or nil if unsuccessful.
+ */
+-(nullable EOSClockOffset*)measureCamera:(EOSCamera*)camera error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Measures the offsets of several cameras in parallel.
+ @param cameras The cameras.
+ @param completion A block that is called on the main thread once every camera has been measured. The value for each camera is an EOSClockOffset.
+ */
+-(void)measureCameras:(NSArray<EOSCamera*>*)cameras completion:(nullable void (^)(EOSFleetResult* result))completion;
+
+/*!
+ @brief Returns the most recently measured offset of a camera.
+ @param camera The camera.
+ @return The offset, or nil if the camera has not been measured.
+ */
+-(nullable EOSClockOffset*)offsetForCamera:(EOSCamera*)camera;
+
+
+
+///---------------------------
+/// @name Correcting Clocks
+///---------------------------
+
+/*!
+ @brief Sets a camera's clock to the host's time.
+ @param camera The camera.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The residual offset after the clock was set, or nil if unsuccessful.
+ */
+-(nullable EOSClockOffset*)synchronizeCamera:(EOSCamera*)camera error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Sets the clocks of several cameras to the host's time in parallel.
+ @param cameras The cameras.
+ @param completion A block that is called on the main thread once every camera has been synchronized. The value for each camera is an EOSClockOffset with its residual offset.
+ */
+-(void)synchronizeCameras:(NSArray<EOSCamera*>*)cameras completion:(nullable void (^)(EOSFleetResult* result))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,317 @@
+//
+//  EOSClockSync.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSClockSync.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSManager.h>
+#import <EOSFramework/EOSFleetResult.h>
+#import <EOSFramework/EOSError.h>
+#import <EDSDK/EDSDK.h>
+
+#define EOSClockSyncDefaultConcurrency  8
+#define EOSClockSyncDefaultTolerance    0.25
+
+//the longest time to wait for the camera's second to change
+#define EOSClockSyncMaxPollTime         1.5
+
+//drift is only estimated from measurements at least this far apart
+#define EOSClockSyncMinDriftInterval    600.0
+
+typedef struct{
+
+    NSTimeInterval cameraTime;
+    NSTimeInterval hostTime;
+    NSTimeInterval roundTripTime;
+    BOOL hasMilliseconds;
+
+} EOSClockSample;
+
+@implementation EOSClockOffset
+
+-(id)initWithOffset:(NSTimeInterval)offset uncertainty:(NSTimeInterval)uncertainty roundTripTime:(NSTimeInterval)roundTripTime drift:(double)drift measurementDate:(NSDate *)measurementDate{
+
+    self = [super init];
+    if (self){
+
+        _offset = offset;
+        _uncertainty = uncertainty;
+        _roundTripTime = roundTripTime;
+        _drift = drift;
+        _measurementDate = measurementDate;
+
+    }
+
+    return self;
+
+}
+
+-(NSTimeInterval)offsetAtDate:(NSDate *)date{
+
+    return _offset + _drift * [date timeIntervalSinceDate:_measurementDate];
+
+}
+
+-(NSDate*)hostDateForCameraDate:(NSDate *)cameraDate{
+
+    //the drift over one offset is negligible, so the offset is evaluated at the camera time
+    return [cameraDate dateByAddingTimeInterval:-[self offsetAtDate:cameraDate]];
+
+}
+
+-(NSDate*)cameraDateForHostDate:(NSDate *)hostDate{
+
+    return [hostDate dateByAddingTimeInterval:[self offsetAtDate:hostDate]];
+
+}
+
+-(NSString*)description{
+
+    return [NSString stringWithFormat:@"<%@: %+.3fs ±%.3fs>", [self class], _offset, _uncertainty];
+
+}
+
+@end
+
+
+
+
+@implementation EOSClockSync{
+
+    dispatch_queue_t _queue;
+    NSMapTable* _offsets;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _maxConcurrentOperations = EOSClockSyncDefaultConcurrency;
+        _tolerance = EOSClockSyncDefaultTolerance;
+        _queue = dispatch_queue_create("com.EOSFramework.clocksync", DISPATCH_QUEUE_SERIAL);
+        _offsets = [NSMapTable weakToStrongObjectsMapTable];
+
+    }
+
+    return self;
+
+}
+
+
+
+
+#pragma mark - Reading the Clock
+
+//the camera's clock is local time
+static NSTimeInterval EOSClockSyncTimeFromEdsTime(EdsTime time){
+
+    NSDateComponents* components = [[NSDateComponents alloc] init];
+    [components setYear:time.year];
+    [components setMonth:time.month];
+    [components setDay:time.day];
+    [components setHour:time.hour];
+    [components setMinute:time.minute];
+    [components setSecond:time.second];
+
+    NSDate* date = [[NSCalendar currentCalendar] dateFromComponents:components];
+
+    return [date timeIntervalSinceReferenceDate] + time.milliseconds / 1000.0;
+
+}
+
+static EdsTime EOSClockSyncEdsTimeFromTime(NSTimeInterval time){
+
+    NSCalendarUnit units = NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay | NSCalendarUnitHour | NSCalendarUnitMinute | NSCalendarUnitSecond;
+    NSDateComponents* components = [[NSCalendar currentCalendar] components:units fromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:time]];
+
+    EdsTime edsTime;
+    edsTime.year = (EdsUInt32)[components year];
+    edsTime.month = (EdsUInt32)[components month];
+    edsTime.day = (EdsUInt32)[components day];
+    edsTime.hour = (EdsUInt32)[components hour];
+    edsTime.minute = (EdsUInt32)[components minute];
+    edsTime.second = (EdsUInt32)[components second];
+    edsTime.milliseconds = 0;
+
+    return edsTime;
+
+}
+
+//the read is timestamped at the midpoint of its round trip
+-(BOOL)readClockOfCamera:(EOSCamera*)camera sample:(EOSClockSample*)sample error:(NSError* __autoreleasing*)error{
+
+    EdsTime time;
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+
+    if (![camera getValue:&time ofSize:sizeof(EdsTime) forProperty:EOSProperty_DateTime withParameter:0 error:error])
+        return NO;
+
+    NSTimeInterval end = [NSDate timeIntervalSinceReferenceDate];
+
+    sample->cameraTime = EOSClockSyncTimeFromEdsTime(time);
+    sample->hostTime = (start + end) / 2;
+    sample->roundTripTime = end - start;
+    sample->hasMilliseconds = time.milliseconds != 0;
+
+    return YES;
+
+}
+
+
+
+
+#pragma mark - Measuring Offsets
+
+-(EOSClockOffset*)measureCamera:(EOSCamera *)camera error:(NSError *__autoreleasing *)error{
+
+    EOSClockSample previous, sample;
+
+    if (![self readClockOfCamera:camera sample:&previous error:error])
+        return nil;
+
+    NSTimeInterval maxRoundTripTime = previous.roundTripTime;
+    NSTimeInterval offset, uncertainty;
+
+    if (previous.hasMilliseconds){
+
+        //the clock is already precise
+        offset = previous.cameraTime - previous.hostTime;
+        uncertainty = previous.roundTripTime / 2;
+
+    }else{
+
+        //the clock's second starts somewhere in the following second, so on average halfway
+        offset = previous.cameraTime + 0.5 - previous.hostTime;
+        uncertainty = 0.5 + previous.roundTripTime / 2;
+
+        NSTimeInterval deadline = previous.hostTime + EOSClockSyncMaxPollTime;
+
+        //poll for the second to change, which pins the camera's clock to within the read interval
+        while (previous.hostTime < deadline){
+
+            if (![self readClockOfCamera:camera sample:&sample error:error])
+                return nil;
+
+            maxRoundTripTime = MAX(maxRoundTripTime, sample.roundTripTime);
+
+            if (sample.cameraTime > previous.cameraTime){
+
+                //the second started between the two reads
+                NSTimeInterval edge = (previous.hostTime + sample.hostTime) / 2;
+
+                offset = sample.cameraTime - edge;
+                uncertainty = (sample.hostTime - previous.hostTime) / 2 + maxRoundTripTime / 2;
+                break;
+
+            }
+
+            previous = sample;
+
+        }
+
+    }
+
+    return [self recordOffset:offset uncertainty:uncertainty roundTripTime:maxRoundTripTime measurementDate:[NSDate date] forCamera:camera];
+
+}
+
+-(void)measureCameras:(NSArray *)cameras completion:(void (^)(EOSFleetResult *))completion{
+
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        return [self measureCamera:camera error:error];
+
+    } onCameras:cameras maxConcurrentOperations:_maxConcurrentOperations completion:completion];
+
+}
+
+-(EOSClockOffset*)recordOffset:(NSTimeInterval)offset uncertainty:(NSTimeInterval)uncertainty roundTripTime:(NSTimeInterval)roundTripTime measurementDate:(NSDate*)measurementDate forCamera:(EOSCamera*)camera{
+
+    __block EOSClockOffset* clockOffset;
+
+    dispatch_sync(_queue, ^(void){
+
+        EOSClockOffset* previous = [_offsets objectForKey:camera];
+        double drift = [previous drift];
+
+        //the drift is a property of the camera's oscillator, so it survives the clock being set
+        if (previous != nil){
+
+            NSTimeInterval interval = [measurementDate timeIntervalSinceDate:[previous measurementDate]];
+
+            if (interval >= EOSClockSyncMinDriftInterval)
+                drift = (offset - [previous offset]) / interval;
+
+        }
+
+        clockOffset = [[EOSClockOffset alloc] initWithOffset:offset uncertainty:uncertainty roundTripTime:roundTripTime drift:drift measurementDate:measurementDate];
+        [_offsets setObject:clockOffset forKey:camera];
+
+    });
+
+    return clockOffset;
+
+}
+
+-(EOSClockOffset*)offsetForCamera:(EOSCamera *)camera{
+
+    __block EOSClockOffset* clockOffset;
+
+    dispatch_sync(_queue, ^(void){
+        clockOffset = [_offsets objectForKey:camera];
+    });
+
+    return clockOffset;
+
+}
+
+
+
+
+#pragma mark - Correcting Clocks
+
+-(EOSClockOffset*)synchronizeCamera:(EOSCamera *)camera error:(NSError *__autoreleasing *)error{
+
+    EOSClockOffset* clockOffset = [self measureCamera:camera error:error];
+
+    if (clockOffset == nil)
+        return nil;
+
+    if (fabs([clockOffset offset]) <= _tolerance)
+        return clockOffset;
+
+    //write the next whole second, early by the time the write takes to arrive
+    NSTimeInterval latency = [clockOffset roundTripTime] / 2;
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    NSTimeInterval target = ceil(now + latency + 0.05);
+
+    [NSThread sleepForTimeInterval:MAX(target - latency - [NSDate timeIntervalSinceReferenceDate], 0)];
+
+    EdsTime time = EOSClockSyncEdsTimeFromTime(target);
+
+    if (![camera setValue:&time ofSize:sizeof(EdsTime) forProperty:EOSProperty_DateTime withParameter:0 error:error])
+        return nil;
+
+    //the measurement just before the write is too recent for the residual to change the drift
+    return [self measureCamera:camera error:error];
+
+}
+
+-(void)synchronizeCameras:(NSArray *)cameras completion:(void (^)(EOSFleetResult *))completion{
+
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        return [self synchronizeCamera:camera error:error];
+
+    } onCameras:cameras maxConcurrentOperations:_maxConcurrentOperations completion:completion];
+
+}
+
+@end
\ No newline at end of file
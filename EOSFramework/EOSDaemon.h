@@ -0,0 +1,102 @@
+//
+//  EOSDaemon.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSFile;
+@class EOSSharedRing;
+@class EOSSharedSlot;
+
+/*!
+ The EOSDaemon class owns the connected cameras on behalf of other processes.
+ @discussion EDSDK sessions cannot be shared between processes, so only one process should open each camera. A daemon opens a session with every connected camera and serves a compact binary protocol over a Unix domain socket, allowing any number of EOSDaemonClient objects to read and write properties in batches, send commands to several cameras at once, and subscribe to camera events.
+
+ The daemon becomes the delegate of the cameras it owns. Camera events are delivered on the main thread, so the main run loop must be running.
+ */
+@interface EOSDaemon : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Initializes a daemon that will listen on a socket path.
+ @param path The path of the Unix domain socket.
+ @return The initialized EOSDaemon.
+ */
+-(id)initWithSocketPath:(NSString*)path;
+
+/*!
+ @brief The path of the socket.
+ */
+@property (readonly) NSString* socketPath;
+
+/*!
+ @brief Indicates whether the daemon is running.
+ */
+@property (readonly) BOOL isRunning;
+
+
+
+///--------------------------
+/// @name Running the Daemon
+///--------------------------
+
+/*!
+ @brief Opens sessions with the connected cameras and starts listening for clients.
+ @discussion The EOS SDK must be loaded. A socket left at the path by a daemon that has exited is replaced, but if another daemon is listening on it, this method fails with EOSError_COMM_PortInUse. The socket is only accessible to the current user, and connections from other users are refused. Cameras that connect while the daemon is running are opened when a client next lists the cameras.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)start:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Disconnects all clients, stops listening and closes the camera sessions.
+ */
+-(void)stop;
+
+/*!
+ @brief The cameras owned by the daemon.
+ */
+@property (readonly) NSArray<EOSCamera*>* cameras;
+
+
+
+///--------------------------------
+/// @name Sharing Files and Frames
+///--------------------------------
+
+/*!
+ @brief The shared ring used to hand files to clients without copying them.
+ @discussion Clients attach to the ring with [EOSDaemonClient attachSharedRing:], which passes them the ring's file descriptor. Set this property before starting the daemon.
+ */
+@property (nullable) EOSSharedRing* sharedRing;
+
+/*!
+ @brief Publishes a slot of the shared ring to every attached client.
+ @discussion The slot is held until each client has released it. Producers other than file downloads can write into slots acquired from sharedRing and publish them with this method.
+ @param slot A slot acquired from sharedRing, with its length set.
+ @param camera The camera that the data came from, or nil.
+ */
+-(void)publishSlot:(EOSSharedSlot*)slot camera:(nullable EOSCamera*)camera;
+
+/*!
+ @brief Downloads a file into the shared ring and publishes it to every attached client.
+ @discussion This method is synchronous.
+ @param file The file to download. It must be smaller than the slot size of sharedRing.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)publishFile:(EOSFile*)file error:(NSError* __autoreleasing*)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,935 @@
+//
+//  EOSDaemon.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSDaemon.h>
+#import <EOSFramework/EOSDaemonClient.h>
+#import <EOSFramework/EOSManager.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSError.h>
+#import <EOSFramework/EOSFile.h>
+#import <EOSFramework/EOSSharedRing.h>
+#import "EOSDaemonProtocol.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#define EOSDaemonReadBufferSize (64 * 1024)
+
+//a connected client
+@interface EOSDaemonConnection : NSObject
+
+@property int fd;
+@property dispatch_source_t readSource;
+@property dispatch_queue_t writeQueue;
+
+//set on the write queue once the descriptor has been closed, as its number may then be reused
+@property BOOL isClosed;
+@property NSMutableData* buffer;
+
+//nil when not subscribed, empty when subscribed to all cameras
+@property NSIndexSet* subscription;
+
+//index in the shared ring, or NSNotFound when not attached
+@property NSUInteger consumerIndex;
+
+@end
+
+@implementation EOSDaemonConnection
+
+@end
+
+
+
+
+//one property of a batched request, which is performed on its camera's queue
+@interface EOSDaemonPropertyItem : NSObject
+
+@property EOSCamera* camera;
+@property UInt32 property;
+@property UInt32 parameter;
+
+//the value to write, or the value that was read
+@property NSData* value;
+@property EdsDataType dataType;
+@property UInt32 errorCode;
+
+@end
+
+@implementation EOSDaemonPropertyItem
+
+@end
+
+
+
+
+@interface EOSDaemon () <EOSCameraDelegate>
+
+@end
+
+@implementation EOSDaemon{
+
+    int _listenFD;
+    dispatch_source_t _listenSource;
+    dispatch_queue_t _queue;
+    dispatch_queue_t _cameraQueue;
+    NSMutableArray* _connections;
+    NSMutableArray* _cameraList;
+    NSMutableArray* _cameraQueues;
+    UInt64 _consumers;
+
+}
+
+-(id)initWithSocketPath:(NSString *)path{
+
+    self = [super init];
+    if (self){
+
+        _socketPath = path;
+        _isRunning = NO;
+        _listenFD = -1;
+        _connections = [NSMutableArray array];
+        _cameraList = [NSMutableArray array];
+        _cameraQueues = [NSMutableArray array];
+        _consumers = 0;
+
+        //connections are managed on _queue, cameras are discovered on _cameraQueue, and each camera's requests are performed in order on its own queue, so a slow camera doesn't hold up the others
+        _queue = dispatch_queue_create("com.EOSFramework.daemon", DISPATCH_QUEUE_SERIAL);
+        _cameraQueue = dispatch_queue_create("com.EOSFramework.daemon.cameras", DISPATCH_QUEUE_SERIAL);
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    [self stop];
+
+}
+
+-(NSArray*)cameras{
+
+    @synchronized(_cameraList){
+        return [NSArray arrayWithArray:_cameraList];
+    }
+
+}
+
+
+
+
+#pragma mark - Running the Daemon
+
+-(BOOL)start:(NSError *__autoreleasing *)error{
+
+    if (_isRunning)
+        return YES;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    const char* path = [_socketPath fileSystemRepresentation];
+
+    if (strlen(path) >= sizeof(address.sun_path)){
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidParameter);
+        return NO;
+
+    }
+
+    strlcpy(address.sun_path, path, sizeof(address.sun_path));
+
+    //a socket that still accepts connections belongs to a running daemon, otherwise it was left behind by one that exited
+    int probeFD = socket(AF_UNIX, SOCK_STREAM, 0);
+    BOOL isInUse = probeFD >= 0 && connect(probeFD, (struct sockaddr*)&address, sizeof(address)) == 0;
+
+    if (probeFD >= 0)
+        close(probeFD);
+
+    if (isInUse){
+
+        if (error)
+            *error = EOSCreateError(EOSError_COMM_PortInUse);
+        return NO;
+
+    }
+
+    unlink(path);
+
+    //only the daemon's own user may connect, as clients can change settings and format cards
+    _listenFD = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (_listenFD < 0 || bind(_listenFD, (struct sockaddr*)&address, sizeof(address)) != 0 || chmod(path, S_IRUSR | S_IWUSR) != 0 || listen(_listenFD, 16) != 0){
+
+        if (_listenFD >= 0)
+            close(_listenFD);
+        _listenFD = -1;
+
+        if (error)
+            *error = EOSCreateError(EOSError_COMM_PortInUse);
+        return NO;
+
+    }
+
+    fcntl(_listenFD, F_SETFL, O_NONBLOCK);
+
+    dispatch_sync(_cameraQueue, ^(void){
+        [self refreshCameras];
+    });
+
+    int listenFD = _listenFD;
+    _listenSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, listenFD, 0, _queue);
+
+    __weak EOSDaemon* weakSelf = self;
+
+    dispatch_source_set_event_handler(_listenSource, ^(void){
+        [weakSelf acceptConnection];
+    });
+
+    dispatch_source_set_cancel_handler(_listenSource, ^(void){
+        close(listenFD);
+    });
+
+    dispatch_resume(_listenSource);
+
+    _isRunning = YES;
+    return YES;
+
+}
+
+-(void)stop{
+
+    if (!_isRunning)
+        return;
+
+    _isRunning = NO;
+
+    dispatch_sync(_queue, ^(void){
+
+        dispatch_source_cancel(_listenSource);
+        _listenSource = nil;
+        _listenFD = -1;
+
+        for (EOSDaemonConnection* connection in [NSArray arrayWithArray:_connections])
+            [self closeConnection:connection];
+
+    });
+
+    unlink([_socketPath fileSystemRepresentation]);
+
+    dispatch_sync(_cameraQueue, ^(void){
+
+        //requests already queued for each camera finish first
+        for (EOSCamera* camera in [self cameras]){
+
+            dispatch_sync([self queueForCamera:camera], ^(void){
+
+                [camera setDelegate:nil];
+
+                if ([camera isOpen])
+                    [camera closeSession:nil];
+
+            });
+
+        }
+
+    });
+
+}
+
+//must be called on _cameraQueue
+-(void)refreshCameras{
+
+    for (EOSCamera* camera in [[EOSManager sharedManager] getCameras]){
+
+        @synchronized(_cameraList){
+
+            if ([_cameraList indexOfObjectIdenticalTo:camera] != NSNotFound)
+                continue;
+
+            [_cameraList addObject:camera];
+            [_cameraQueues addObject:dispatch_queue_create("com.EOSFramework.daemon.camera", DISPATCH_QUEUE_SERIAL)];
+
+        }
+
+        if (![camera isOpen])
+            [camera openSession:nil];
+
+        [camera setDelegate:self];
+
+    }
+
+}
+
+//camera identifiers are 1-based indexes into _cameraList, which is only appended to
+-(EOSCamera*)cameraWithIdentifier:(UInt32)identifier{
+
+    @synchronized(_cameraList){
+
+        if (identifier == 0 || identifier > [_cameraList count])
+            return nil;
+
+        return [_cameraList objectAtIndex:identifier - 1];
+
+    }
+
+}
+
+-(dispatch_queue_t)queueForCamera:(EOSCamera*)camera{
+
+    @synchronized(_cameraList){
+        return [_cameraQueues objectAtIndex:[_cameraList indexOfObjectIdenticalTo:camera]];
+    }
+
+}
+
+-(UInt32)identifierForCamera:(EOSCamera*)camera{
+
+    @synchronized(_cameraList){
+
+        NSUInteger index = [_cameraList indexOfObjectIdenticalTo:camera];
+        return index != NSNotFound ? (UInt32)index + 1 : 0;
+
+    }
+
+}
+
+
+
+
+#pragma mark - Connections
+
+//must be called on _queue
+-(void)acceptConnection{
+
+    int fd = accept(_listenFD, NULL, NULL);
+
+    if (fd < 0)
+        return;
+
+    uid_t uid;
+    gid_t gid;
+
+    if (getpeereid(fd, &uid, &gid) != 0 || uid != geteuid()){
+
+        close(fd);
+        return;
+
+    }
+
+    //reads are driven by a dispatch source, writes block on the connection's own queue
+    int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+
+    int noSigPipe = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+
+    EOSDaemonConnection* connection = [[EOSDaemonConnection alloc] init];
+    [connection setFd:fd];
+    [connection setBuffer:[NSMutableData data]];
+    [connection setConsumerIndex:NSNotFound];
+    [connection setWriteQueue:dispatch_queue_create("com.EOSFramework.daemon.connection", DISPATCH_QUEUE_SERIAL)];
+
+    dispatch_source_t readSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, fd, 0, _queue);
+    __weak EOSDaemon* weakSelf = self;
+    __weak EOSDaemonConnection* weakConnection = connection;
+
+    dispatch_source_set_event_handler(readSource, ^(void){
+        [weakSelf readFromConnection:weakConnection];
+    });
+
+    //the descriptor is closed once the source has let go of it and the frames already queued have been written
+    dispatch_queue_t writeQueue = [connection writeQueue];
+
+    dispatch_source_set_cancel_handler(readSource, ^(void){
+
+        dispatch_barrier_async(writeQueue, ^(void){
+
+            [weakConnection setIsClosed:YES];
+            close(fd);
+
+        });
+
+    });
+
+    [connection setReadSource:readSource];
+    [_connections addObject:connection];
+
+    dispatch_resume(readSource);
+
+}
+
+//must be called on _queue
+-(void)closeConnection:(EOSDaemonConnection*)connection{
+
+    if ([connection readSource] == nil)
+        return;
+
+    //pending and later writes fail straight away rather than waiting for the client
+    shutdown([connection fd], SHUT_RDWR);
+    dispatch_source_cancel([connection readSource]);
+    [connection setReadSource:nil];
+    [_connections removeObjectIdenticalTo:connection];
+
+    //release anything the client was still holding
+    if ([connection consumerIndex] != NSNotFound){
+
+        [_sharedRing releaseSlotsForConsumer:[connection consumerIndex]];
+        _consumers &= ~(1ULL << [connection consumerIndex]);
+        [connection setConsumerIndex:NSNotFound];
+
+    }
+
+}
+
+//must be called on _queue
+-(void)readFromConnection:(EOSDaemonConnection*)connection{
+
+    if (connection == nil)
+        return;
+
+    UInt8 bytes[EOSDaemonReadBufferSize];
+    ssize_t length = read([connection fd], bytes, sizeof(bytes));
+
+    if (length <= 0){
+
+        if (length < 0 && errno == EINTR)
+            return;
+
+        [self closeConnection:connection];
+        return;
+
+    }
+
+    [[connection buffer] appendBytes:bytes length:length];
+
+    NSData* frame;
+    BOOL invalid = NO;
+
+    while ((frame = EOSDaemonTakeFrame([connection buffer], &invalid)) != nil){
+
+        EOSDaemonReader reader = EOSDaemonReaderCreate(frame, sizeof(UInt32));
+        UInt32 requestID = EOSDaemonReadUInt32(&reader);
+        EOSDaemonOpcode opcode = EOSDaemonReadUInt8(&reader);
+
+        //subscriptions are connection state, so they are handled here
+        if (opcode == EOSDaemonOpcode_Subscribe || opcode == EOSDaemonOpcode_Unsubscribe){
+
+            [self handleSubscription:opcode requestID:requestID reader:&reader connection:connection];
+            continue;
+
+        }
+
+        if (opcode == EOSDaemonOpcode_AttachRing){
+
+            [self attachRingForConnection:connection requestID:requestID];
+            continue;
+
+        }
+
+        EOSDaemonReader bodyReader = EOSDaemonReaderCreate(frame, EOSDaemonFrameHeaderLength);
+        NSMutableData* response = EOSDaemonCreateFrame(requestID, opcode);
+
+        [self handleRequest:opcode reader:&bodyReader response:response completion:^(void){
+
+            EOSDaemonFinishFrame(response);
+            [self sendFrame:response toConnection:connection];
+
+        }];
+
+    }
+
+    if (invalid)
+        [self closeConnection:connection];
+
+}
+
+-(void)sendFrame:(NSData*)frame toConnection:(EOSDaemonConnection*)connection{
+
+    [self sendFrame:frame withDescriptor:-1 toConnection:connection];
+
+}
+
+-(void)sendFrame:(NSData*)frame withDescriptor:(int)descriptor toConnection:(EOSDaemonConnection*)connection{
+
+    dispatch_async([connection writeQueue], ^(void){
+
+        if ([connection isClosed])
+            return;
+
+        BOOL written = descriptor >= 0 ? EOSDaemonWriteAllWithDescriptor([connection fd], frame, descriptor) : EOSDaemonWriteAll([connection fd], frame);
+
+        if (!written){
+
+            dispatch_async(_queue, ^(void){
+                [self closeConnection:connection];
+            });
+
+        }
+
+    });
+
+}
+
+
+
+
+#pragma mark - Requests
+
+//must be called on _queue
+-(void)handleSubscription:(EOSDaemonOpcode)opcode requestID:(UInt32)requestID reader:(EOSDaemonReader*)reader connection:(EOSDaemonConnection*)connection{
+
+    EOSError errorCode = EOSError_OK;
+
+    if (opcode == EOSDaemonOpcode_Subscribe){
+
+        NSMutableIndexSet* cameras = [NSMutableIndexSet indexSet];
+        UInt16 i, count = EOSDaemonReadUInt16(reader);
+
+        for (i=0; i<count; i++)
+            [cameras addIndex:EOSDaemonReadUInt32(reader)];
+
+        if (reader->failed)
+            errorCode = EOSError_InvalidParameter;
+        else
+            [connection setSubscription:cameras];
+
+    }else{
+
+        [connection setSubscription:nil];
+
+    }
+
+    NSMutableData* response = EOSDaemonCreateFrame(requestID, opcode);
+    EOSDaemonAppendUInt32(response, errorCode);
+    EOSDaemonFinishFrame(response);
+
+    [self sendFrame:response toConnection:connection];
+
+}
+
+//must be called on _queue
+-(void)attachRingForConnection:(EOSDaemonConnection*)connection requestID:(UInt32)requestID{
+
+    EOSError errorCode = EOSError_OK;
+
+    if (_sharedRing == nil){
+
+        errorCode = EOSError_NotSupported;
+
+    }else if ([connection consumerIndex] == NSNotFound){
+
+        //find a free consumer index
+        NSUInteger index = 0;
+        while (index < EOSSharedRingMaxConsumers && (_consumers & (1ULL << index)) != 0)
+            index++;
+
+        if (index < EOSSharedRingMaxConsumers){
+
+            _consumers |= 1ULL << index;
+            [connection setConsumerIndex:index];
+
+        }else{
+
+            errorCode = EOSError_Device_Busy;
+
+        }
+
+    }
+
+    NSMutableData* response = EOSDaemonCreateFrame(requestID, EOSDaemonOpcode_AttachRing);
+    EOSDaemonAppendUInt32(response, errorCode);
+    EOSDaemonAppendUInt32(response, errorCode == EOSError_OK ? (UInt32)[connection consumerIndex] : 0);
+    EOSDaemonAppendUInt32(response, (UInt32)[_sharedRing slotCount]);
+    EOSDaemonAppendUInt32(response, (UInt32)[_sharedRing slotSize]);
+    EOSDaemonFinishFrame(response);
+
+    [self sendFrame:response withDescriptor:errorCode == EOSError_OK ? [_sharedRing fileDescriptor] : -1 toConnection:connection];
+
+}
+
+//the request is read before this returns, and the completion is called once the response is complete, on any queue
+-(void)handleRequest:(EOSDaemonOpcode)opcode reader:(EOSDaemonReader*)reader response:(NSMutableData*)response completion:(dispatch_block_t)completion{
+
+    switch (opcode){
+
+        case EOSDaemonOpcode_ListCameras:
+
+            dispatch_async(_cameraQueue, ^(void){
+
+                [self listCamerasWithResponse:response];
+                completion();
+
+            });
+
+            break;
+
+        case EOSDaemonOpcode_GetProperties:
+            [self getPropertiesWithReader:reader response:response completion:completion];
+            break;
+
+        case EOSDaemonOpcode_SetProperties:
+            [self setPropertiesWithReader:reader response:response completion:completion];
+            break;
+
+        case EOSDaemonOpcode_SendCommand:
+            [self sendCommandWithReader:reader response:response completion:completion];
+            break;
+
+        default:
+            EOSDaemonAppendUInt32(response, EOSError_NotSupported);
+            completion();
+            break;
+
+    }
+
+}
+
+//performs the block for each item on its camera's queue, the items for one camera in the order they were requested, and calls the completion once every item has been performed
+-(void)performItems:(NSArray*)items block:(void (^)(EOSDaemonPropertyItem* item))block completion:(dispatch_block_t)completion{
+
+    NSMapTable* batches = [NSMapTable strongToStrongObjectsMapTable];
+
+    for (EOSDaemonPropertyItem* item in items){
+
+        //items that couldn't be read, or are for unknown cameras, already have their error
+        if ([item camera] == nil)
+            continue;
+
+        NSMutableArray* batch = [batches objectForKey:[item camera]];
+
+        if (batch == nil){
+
+            batch = [NSMutableArray array];
+            [batches setObject:batch forKey:[item camera]];
+
+        }
+
+        [batch addObject:item];
+
+    }
+
+    dispatch_group_t group = dispatch_group_create();
+
+    for (EOSCamera* camera in batches){
+
+        NSArray* batch = [batches objectForKey:camera];
+
+        dispatch_group_async(group, [self queueForCamera:camera], ^(void){
+
+            for (EOSDaemonPropertyItem* item in batch)
+                block(item);
+
+        });
+
+    }
+
+    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), completion);
+
+}
+
+-(void)listCamerasWithResponse:(NSMutableData*)response{
+
+    [self refreshCameras];
+
+    NSArray* cameras = [self cameras];
+    EOSDaemonAppendUInt16(response, (UInt16)[cameras count]);
+
+    for (EOSCamera* camera in cameras){
+
+        EOSDaemonAppendUInt32(response, [self identifierForCamera:camera]);
+        EOSDaemonAppendUInt8(response, [camera isOpen]);
+        EOSDaemonAppendString(response, [camera serialNumber]);
+        EOSDaemonAppendString(response, [camera cameraDescription]);
+
+    }
+
+}
+
+-(void)getPropertiesWithReader:(EOSDaemonReader*)reader response:(NSMutableData*)response completion:(dispatch_block_t)completion{
+
+    UInt16 i, count = EOSDaemonReadUInt16(reader);
+    NSMutableArray* items = [NSMutableArray arrayWithCapacity:count];
+
+    for (i=0; i<count; i++){
+
+        EOSDaemonPropertyItem* item = [[EOSDaemonPropertyItem alloc] init];
+        UInt32 identifier = EOSDaemonReadUInt32(reader);
+
+        [item setProperty:EOSDaemonReadUInt32(reader)];
+        [item setParameter:EOSDaemonReadUInt32(reader)];
+
+        [item setCamera:reader->failed ? nil : [self cameraWithIdentifier:identifier]];
+
+        if (reader->failed)
+            [item setErrorCode:EOSError_InvalidParameter];
+        else if ([item camera] == nil)
+            [item setErrorCode:EOSError_Device_NotFound];
+
+        [items addObject:item];
+
+    }
+
+    [self performItems:items block:^(EOSDaemonPropertyItem* item){
+
+        EOSCamera* camera = [item camera];
+        NSUInteger size = 0;
+        EdsDataType dataType = 0;
+        NSError* error;
+
+        if ([camera getValueSize:&size dataType:&dataType forProperty:[item property] withParameter:[item parameter] error:&error]){
+
+            NSMutableData* value = [NSMutableData dataWithLength:size];
+
+            if ([camera getValue:[value mutableBytes] ofSize:size forProperty:[item property] withParameter:[item parameter] error:&error]){
+
+                [item setValue:value];
+                [item setDataType:dataType];
+
+            }
+
+        }
+
+        [item setErrorCode:(UInt32)[error code]];
+
+    } completion:^(void){
+
+        EOSDaemonAppendUInt16(response, count);
+
+        for (EOSDaemonPropertyItem* item in items){
+
+            EOSDaemonAppendUInt32(response, [item errorCode]);
+            EOSDaemonAppendUInt32(response, [item value] != nil ? [item dataType] : 0);
+            EOSDaemonAppendUInt32(response, (UInt32)[[item value] length]);
+
+            if ([item value] != nil)
+                [response appendData:[item value]];
+
+        }
+
+        completion();
+
+    }];
+
+}
+
+-(void)setPropertiesWithReader:(EOSDaemonReader*)reader response:(NSMutableData*)response completion:(dispatch_block_t)completion{
+
+    UInt16 i, count = EOSDaemonReadUInt16(reader);
+    NSMutableArray* items = [NSMutableArray arrayWithCapacity:count];
+
+    for (i=0; i<count; i++){
+
+        EOSDaemonPropertyItem* item = [[EOSDaemonPropertyItem alloc] init];
+        UInt32 identifier = EOSDaemonReadUInt32(reader);
+
+        [item setProperty:EOSDaemonReadUInt32(reader)];
+        [item setParameter:EOSDaemonReadUInt32(reader)];
+
+        UInt32 size = EOSDaemonReadUInt32(reader);
+        const UInt8* value = EOSDaemonReadBytes(reader, size);
+
+        //the value is copied, as the request's frame isn't kept
+        [item setCamera:reader->failed ? nil : [self cameraWithIdentifier:identifier]];
+
+        if (reader->failed)
+            [item setErrorCode:EOSError_InvalidParameter];
+        else if ([item camera] == nil)
+            [item setErrorCode:EOSError_Device_NotFound];
+        else
+            [item setValue:[NSData dataWithBytes:value length:size]];
+
+        [items addObject:item];
+
+    }
+
+    [self performItems:items block:^(EOSDaemonPropertyItem* item){
+
+        NSError* error;
+
+        [[item camera] setValue:[[item value] bytes] ofSize:[[item value] length] forProperty:[item property] withParameter:[item parameter] error:&error];
+        [item setErrorCode:(UInt32)[error code]];
+
+    } completion:^(void){
+
+        EOSDaemonAppendUInt16(response, count);
+
+        for (EOSDaemonPropertyItem* item in items)
+            EOSDaemonAppendUInt32(response, [item errorCode]);
+
+        completion();
+
+    }];
+
+}
+
+-(void)sendCommandWithReader:(EOSDaemonReader*)reader response:(NSMutableData*)response completion:(dispatch_block_t)completion{
+
+    UInt32 command = EOSDaemonReadUInt32(reader);
+    NSInteger parameter = (SInt32)EOSDaemonReadUInt32(reader);
+    UInt16 i, count = EOSDaemonReadUInt16(reader);
+    NSMutableArray* items = [NSMutableArray arrayWithCapacity:count];
+
+    for (i=0; i<count; i++){
+
+        EOSDaemonPropertyItem* item = [[EOSDaemonPropertyItem alloc] init];
+        UInt32 identifier = EOSDaemonReadUInt32(reader);
+
+        [item setCamera:reader->failed ? nil : [self cameraWithIdentifier:identifier]];
+
+        if (reader->failed)
+            [item setErrorCode:EOSError_InvalidParameter];
+        else if ([item camera] == nil)
+            [item setErrorCode:EOSError_Device_NotFound];
+
+        [items addObject:item];
+
+    }
+
+    //every camera is triggered at the same time, each on its own queue
+    [self performItems:items block:^(EOSDaemonPropertyItem* item){
+
+        NSError* error;
+
+        [[item camera] sendCommand:command withParameter:parameter error:&error];
+        [item setErrorCode:(UInt32)[error code]];
+
+    } completion:^(void){
+
+        EOSDaemonAppendUInt16(response, count);
+
+        for (EOSDaemonPropertyItem* item in items)
+            EOSDaemonAppendUInt32(response, [item errorCode]);
+
+        completion();
+
+    }];
+
+}
+
+
+
+
+#pragma mark - Sharing Files and Frames
+
+-(void)publishSlot:(EOSSharedSlot *)slot camera:(EOSCamera *)camera{
+
+    UInt32 identifier = camera != nil ? [self identifierForCamera:camera] : 0;
+
+    dispatch_sync(_queue, ^(void){
+
+        NSMutableData* frame = EOSDaemonCreateFrame(0, EOSDaemonOpcode_SlotPublished);
+        EOSDaemonAppendUInt32(frame, identifier);
+        EOSDaemonAppendUInt32(frame, (UInt32)[slot index]);
+        EOSDaemonFinishFrame(frame);
+
+        //the slot is held by every attached client until they release it
+        [_sharedRing publishSlot:slot consumers:_consumers];
+
+        for (EOSDaemonConnection* connection in _connections){
+
+            if ([connection consumerIndex] != NSNotFound)
+                [self sendFrame:frame toConnection:connection];
+
+        }
+
+    });
+
+}
+
+-(BOOL)publishFile:(EOSFile *)file error:(NSError *__autoreleasing *)error{
+
+    if (_sharedRing == nil){
+
+        if (error)
+            *error = EOSCreateError(EOSError_NotSupported);
+        return NO;
+
+    }
+
+    EOSSharedSlot* slot = [file downloadToSharedRing:_sharedRing error:error];
+
+    if (slot == nil)
+        return NO;
+
+    [self publishSlot:slot camera:[file camera]];
+    return YES;
+
+}
+
+
+
+
+#pragma mark - Events
+
+-(void)broadcastEvent:(EOSDaemonEvent)event forCamera:(EOSCamera*)camera property:(EOSProperty)property{
+
+    UInt32 identifier = [self identifierForCamera:camera];
+
+    NSMutableData* frame = EOSDaemonCreateFrame(0, EOSDaemonOpcode_Event);
+    EOSDaemonAppendUInt32(frame, identifier);
+    EOSDaemonAppendUInt8(frame, event);
+    EOSDaemonAppendUInt32(frame, (UInt32)property);
+    EOSDaemonFinishFrame(frame);
+
+    dispatch_async(_queue, ^(void){
+
+        for (EOSDaemonConnection* connection in _connections){
+
+            NSIndexSet* subscription = [connection subscription];
+
+            if (subscription != nil && ([subscription count] == 0 || [subscription containsIndex:identifier]))
+                [self sendFrame:frame toConnection:connection];
+
+        }
+
+    });
+
+}
+
+-(void)camera:(EOSCamera *)camera valueDidChangeForProperty:(EOSProperty)property{
+
+    [self broadcastEvent:EOSDaemonEvent_ValueChanged forCamera:camera property:property];
+
+}
+
+-(void)camera:(EOSCamera *)camera supportedValuesDidChangeForProperty:(EOSProperty)property{
+
+    [self broadcastEvent:EOSDaemonEvent_SupportedValuesChanged forCamera:camera property:property];
+
+}
+
+-(void)camera:(EOSCamera *)camera didCreateFile:(EOSFile *)file{
+
+    [self broadcastEvent:EOSDaemonEvent_FileCreated forCamera:camera property:0];
+
+}
+
+-(void)camera:(EOSCamera *)camera didRemoveFile:(EOSFile *)file{
+
+    [self broadcastEvent:EOSDaemonEvent_FileRemoved forCamera:camera property:0];
+
+}
+
+-(void)camera:(EOSCamera *)camera willShutdownAfterDelay:(NSUInteger)delay{
+
+    [self broadcastEvent:EOSDaemonEvent_WillShutdown forCamera:camera property:0];
+
+}
+
+-(void)cameraDidDisconnect:(EOSCamera *)camera{
+
+    [self broadcastEvent:EOSDaemonEvent_Disconnected forCamera:camera property:0];
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,247 @@
+//
+//  EOSDaemonClient.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+#import <EOSFramework/EOSPropertyObject.h>
+#import <EOSFramework/EOSCamera.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSSharedRing;
+@class EOSSharedSlot;
+
+/*!
+ @brief Events sent by EOSDaemon to subscribed clients.
+ */
+typedef NS_ENUM(UInt8, EOSDaemonEvent){
+
+    /** The value of a property changed. */
+    EOSDaemonEvent_ValueChanged             = 1,
+
+    /** The supported values of a property changed. */
+    EOSDaemonEvent_SupportedValuesChanged   = 2,
+
+    /** A file was created on one of the camera's volumes. */
+    EOSDaemonEvent_FileCreated              = 3,
+
+    /** A file was removed from one of the camera's volumes. */
+    EOSDaemonEvent_FileRemoved              = 4,
+
+    /** The camera is going to shutdown. */
+    EOSDaemonEvent_WillShutdown             = 5,
+
+    /** The camera disconnected. */
+    EOSDaemonEvent_Disconnected             = 6
+
+};
+
+
+
+/*!
+ The EOSDaemonCamera class describes a camera owned by an EOSDaemon. Instances of this class are created by [EOSDaemonClient cameras:].
+ */
+@interface EOSDaemonCamera : NSObject
+
+/*!
+ @brief The identifier of the camera within the daemon.
+ @discussion Identifiers are not reused while the daemon is running.
+ */
+@property (readonly) UInt32 identifier;
+
+/*!
+ @brief Indicates whether the daemon has an open session with the camera.
+ */
+@property (readonly) BOOL isOpen;
+
+/*!
+ @brief The serial number of the camera, or an empty string if it is unknown.
+ */
+@property (readonly) NSString* serialNumber;
+
+/*!
+ @brief The description of the camera.
+ */
+@property (readonly) NSString* cameraDescription;
+
+@end
+
+
+
+/*!
+ The EOSDaemonProperty class describes a single property read or write in a batch sent to an EOSDaemon.
+ */
+@interface EOSDaemonProperty : NSObject
+
+/*!
+ @brief Initializes a property read.
+ @param property The property.
+ @param camera The identifier of the camera.
+ @return The initialized EOSDaemonProperty.
+ */
+-(id)initWithProperty:(EOSProperty)property camera:(UInt32)camera;
+
+/*!
+ @brief Initializes a property write.
+ @param property The property.
+ @param camera The identifier of the camera.
+ @param value The raw value to write, as used by [EOSPropertyObject setValue:ofSize:forProperty:withParameter:error:].
+ @return The initialized EOSDaemonProperty.
+ */
+-(id)initWithProperty:(EOSProperty)property camera:(UInt32)camera value:(NSData*)value;
+
+/*!
+ @brief The identifier of the camera.
+ */
+@property UInt32 camera;
+
+/*!
+ @brief The property.
+ */
+@property EOSProperty property;
+
+/*!
+ @brief The parameter of the property. The default value is 0.
+ */
+@property NSUInteger parameter;
+
+/*!
+ @brief The raw value of the property.
+ @discussion For reads, this is set once the batch has completed successfully.
+ */
+@property (nullable) NSData* value;
+
+/*!
+ @brief The data type of the value, set once a read has completed successfully.
+ */
+@property NSUInteger dataType;
+
+/*!
+ @brief The error that caused the read or write to fail, or nil if it succeeded.
+ */
+@property (nullable) NSError* error;
+
+/*!
+ @brief The value interpreted as an unsigned integer, or nil if the value is not 4 bytes long.
+ */
+-(nullable NSNumber*)numberValue;
+
+@end
+
+
+
+/*!
+ The EOSDaemonClient class connects to an EOSDaemon, giving access to cameras that are owned by another process.
+ @discussion Requests are sent as batches, so reading or writing many properties across many cameras takes a single round trip. The methods of this class are synchronous and thread safe; subscription events are delivered on the main thread.
+ */
+@interface EOSDaemonClient : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Connects to a daemon.
+ @param path The path of the daemon's socket.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSDaemonClient, or nil if the connection failed.
+ */
+-(nullable id)initWithSocketPath:(NSString*)path error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Closes the connection.
+ */
+-(void)close;
+
+
+
+///---------------------------
+/// @name Accessing Cameras
+///---------------------------
+
+/*!
+ @brief Gets the cameras owned by the daemon.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return An array of EOSDaemonCamera objects, or nil if unsuccessful.
+ */
+-(nullable NSArray<EOSDaemonCamera*>*)cameras:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Reads a batch of properties.
+ @discussion The value, dataType and error properties of each object are set when the batch completes.
+ @param properties An array of EOSDaemonProperty objects.
+ @param error If the batch could not be sent, an instance of NSError describes the problem.
+ @return YES if the batch was completed, otherwise NO. Individual reads may still have failed.
+ */
+-(BOOL)getProperties:(NSArray<EOSDaemonProperty*>*)properties error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Writes a batch of properties.
+ @discussion The error property of each object is set when the batch completes.
+ @param properties An array of EOSDaemonProperty objects with values.
+ @param error If the batch could not be sent, an instance of NSError describes the problem.
+ @return YES if the batch was completed, otherwise NO. Individual writes may still have failed.
+ */
+-(BOOL)setProperties:(NSArray<EOSDaemonProperty*>*)properties error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Sends a command to several cameras at the same time.
+ @param command The command.
+ @param parameter The parameter of the command.
+ @param cameras An array of NSNumber objects containing camera identifiers.
+ @param error If the request could not be sent, an instance of NSError describes the problem.
+ @return An array containing an NSError, or NSNull if the command succeeded, for each camera. Returns nil if unsuccessful.
+ */
+-(nullable NSArray*)sendCommand:(EOSCameraCommand)command withParameter:(NSInteger)parameter toCameras:(NSArray<NSNumber*>*)cameras error:(NSError* __autoreleasing*)error;
+
+
+
+///-------------------------
+/// @name Receiving Events
+///-------------------------
+
+/*!
+ @brief Subscribes to the events of cameras.
+ @discussion Any previous subscription is replaced.
+ @param cameras An array of NSNumber objects containing camera identifiers, or nil to subscribe to all cameras.
+ @param handler A block that is called on the main thread for each event. The property is 0 for events that aren't about a property.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)subscribeToCameras:(nullable NSArray<NSNumber*>*)cameras handler:(void (^)(UInt32 camera, EOSDaemonEvent event, EOSProperty property))handler error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Stops receiving events.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)unsubscribe:(NSError* __autoreleasing*)error;
+
+
+
+///--------------------------------
+/// @name Sharing Files and Frames
+///--------------------------------
+
+/*!
+ @brief Attaches to the daemon's shared ring.
+ @discussion The ring's file descriptor is passed over the connection and mapped into this process. Once attached, the slots that the daemon publishes are passed to the slot handler.
+ @param error If unsuccessful, an instance of NSError describes the problem. If the daemon doesn't have a shared ring, the error code will be EOSError_NotSupported.
+ @return The shared ring, or nil if unsuccessful.
+ */
+-(nullable EOSSharedRing*)attachSharedRing:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Sets the block that is called with each slot published by the daemon.
+ @discussion The block is called on the main thread. The slot is held until it is released with [EOSSharedRing releaseSlot:], which may be done later on any thread. If no handler is set, slots are released as soon as they arrive.
+ @param handler The block, with the identifier of the camera (or 0) and the slot.
+ */
+-(void)setSlotHandler:(nullable void (^)(UInt32 camera, EOSSharedSlot* slot))handler;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,750 @@
+//
+//  EOSDaemonClient.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSDaemonClient.h>
+#import <EOSFramework/EOSError.h>
+#import <EOSFramework/EOSSharedRing.h>
+#import "EOSDaemonProtocol.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define EOSDaemonClientTimeout      30
+#define EOSDaemonReadBufferSize     (64 * 1024)
+
+@implementation EOSDaemonCamera
+
+-(id)initWithIdentifier:(UInt32)identifier isOpen:(BOOL)isOpen serialNumber:(NSString*)serialNumber cameraDescription:(NSString*)cameraDescription{
+
+    self = [super init];
+    if (self){
+
+        _identifier = identifier;
+        _isOpen = isOpen;
+        _serialNumber = serialNumber;
+        _cameraDescription = cameraDescription;
+
+    }
+
+    return self;
+
+}
+
+-(NSString*)description{
+    return [self cameraDescription];
+}
+
+@end
+
+
+
+
+@implementation EOSDaemonProperty
+
+-(id)initWithProperty:(EOSProperty)property camera:(UInt32)camera{
+
+    self = [super init];
+    if (self){
+
+        _property = property;
+        _camera = camera;
+        _parameter = 0;
+
+    }
+
+    return self;
+
+}
+
+-(id)initWithProperty:(EOSProperty)property camera:(UInt32)camera value:(NSData *)value{
+
+    self = [self initWithProperty:property camera:camera];
+    if (self){
+
+        _value = value;
+
+    }
+
+    return self;
+
+}
+
+-(NSNumber*)numberValue{
+
+    if ([_value length] != sizeof(UInt32))
+        return nil;
+
+    UInt32 value;
+    [_value getBytes:&value length:sizeof(value)];
+
+    return [NSNumber numberWithUnsignedInt:value];
+
+}
+
+@end
+
+
+
+
+//a request waiting for its response
+@interface EOSDaemonPendingRequest : NSObject
+
+@property dispatch_semaphore_t semaphore;
+@property NSData* response;
+
+@end
+
+@implementation EOSDaemonPendingRequest
+
+@end
+
+
+
+
+@implementation EOSDaemonClient{
+
+    int _fd;
+    dispatch_source_t _readSource;
+    dispatch_queue_t _queue;
+    dispatch_queue_t _writeQueue;
+    NSMutableData* _buffer;
+    NSMutableDictionary* _pendingRequests;
+    UInt32 _nextRequestID;
+    void (^_eventHandler)(UInt32, EOSDaemonEvent, EOSProperty);
+    void (^_slotHandler)(UInt32, EOSSharedSlot*);
+    NSMutableArray* _receivedDescriptors;
+    NSMutableArray* _earlySlots;
+    EOSSharedRing* _sharedRing;
+
+}
+
+-(id)initWithSocketPath:(NSString *)path error:(NSError *__autoreleasing *)error{
+
+    self = [super init];
+    if (self){
+
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strlcpy(address.sun_path, [path fileSystemRepresentation], sizeof(address.sun_path));
+
+        _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (_fd < 0 || connect(_fd, (struct sockaddr*)&address, sizeof(address)) != 0){
+
+            if (_fd >= 0)
+                close(_fd);
+
+            if (error)
+                *error = EOSCreateError(EOSError_COMM_Disconnected);
+            return nil;
+
+        }
+
+        int noSigPipe = 1;
+        setsockopt(_fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+
+        _buffer = [NSMutableData data];
+        _pendingRequests = [NSMutableDictionary dictionary];
+        _receivedDescriptors = [NSMutableArray array];
+        _earlySlots = [NSMutableArray array];
+        _nextRequestID = 1;
+
+        _queue = dispatch_queue_create("com.EOSFramework.daemonclient", DISPATCH_QUEUE_SERIAL);
+        _writeQueue = dispatch_queue_create("com.EOSFramework.daemonclient.write", DISPATCH_QUEUE_SERIAL);
+
+        int fd = _fd;
+        _readSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, fd, 0, _queue);
+        __weak EOSDaemonClient* weakSelf = self;
+
+        dispatch_source_set_event_handler(_readSource, ^(void){
+            [weakSelf readResponses];
+        });
+
+        //the descriptor is closed on the write queue, so a request that is being written never writes to a reused descriptor
+        dispatch_queue_t writeQueue = _writeQueue;
+
+        dispatch_source_set_cancel_handler(_readSource, ^(void){
+
+            dispatch_barrier_async(writeQueue, ^(void){
+
+                EOSDaemonClient* strongSelf = weakSelf;
+
+                if (strongSelf != nil)
+                    strongSelf->_fd = -1;
+
+                close(fd);
+
+            });
+
+        });
+
+        dispatch_resume(_readSource);
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    //the last reference may be released on _queue, so the connection is torn down without waiting for it; nothing else can be using it by now
+    [self disconnect];
+
+}
+
+-(void)close{
+
+    dispatch_sync(_queue, ^(void){
+        [self disconnect];
+    });
+
+}
+
+//must be called on _queue
+-(void)disconnect{
+
+    if (_readSource == nil)
+        return;
+
+    shutdown(_fd, SHUT_RDWR);
+    dispatch_source_cancel(_readSource);
+    _readSource = nil;
+
+    //wake any waiting requests, which will fail
+    for (EOSDaemonPendingRequest* request in [_pendingRequests allValues])
+        dispatch_semaphore_signal([request semaphore]);
+
+    [_pendingRequests removeAllObjects];
+
+    for (NSNumber* descriptor in _receivedDescriptors)
+        close([descriptor intValue]);
+
+    [_receivedDescriptors removeAllObjects];
+    [_earlySlots removeAllObjects];
+
+}
+
+//must be called on _queue
+-(void)readResponses{
+
+    UInt8 bytes[EOSDaemonReadBufferSize];
+    int descriptor;
+    ssize_t length = EOSDaemonReadWithDescriptor(_fd, bytes, sizeof(bytes), &descriptor);
+
+    //descriptors arrive with the response that they belong to, and are claimed by the waiting request
+    if (descriptor >= 0)
+        [_receivedDescriptors addObject:@(descriptor)];
+
+    if (length <= 0){
+
+        if (length < 0 && errno == EINTR)
+            return;
+
+        [self disconnect];
+        return;
+
+    }
+
+    [_buffer appendBytes:bytes length:length];
+
+    NSData* frame;
+    BOOL invalid = NO;
+
+    while ((frame = EOSDaemonTakeFrame(_buffer, &invalid)) != nil){
+
+        EOSDaemonReader reader = EOSDaemonReaderCreate(frame, sizeof(UInt32));
+        UInt32 requestID = EOSDaemonReadUInt32(&reader);
+        EOSDaemonOpcode opcode = EOSDaemonReadUInt8(&reader);
+
+        if (requestID == 0 && opcode == EOSDaemonOpcode_Event){
+
+            UInt32 camera = EOSDaemonReadUInt32(&reader);
+            EOSDaemonEvent event = EOSDaemonReadUInt8(&reader);
+            EOSProperty property = EOSDaemonReadUInt32(&reader);
+
+            void (^handler)(UInt32, EOSDaemonEvent, EOSProperty) = _eventHandler;
+
+            if (handler != nil && !reader.failed){
+
+                dispatch_async(dispatch_get_main_queue(), ^(void){
+                    handler(camera, event, property);
+                });
+
+            }
+
+            continue;
+
+        }
+
+        if (requestID == 0 && opcode == EOSDaemonOpcode_SlotPublished){
+
+            UInt32 camera = EOSDaemonReadUInt32(&reader);
+            UInt32 index = EOSDaemonReadUInt32(&reader);
+
+            if (reader.failed)
+                continue;
+
+            //slots can arrive before attachSharedRing: has mapped the ring, so hold them until it has
+            if (_sharedRing == nil)
+                [_earlySlots addObject:@[@(camera), @(index)]];
+            else
+                [self deliverSlotAtIndex:index camera:camera];
+
+            continue;
+
+        }
+
+        EOSDaemonPendingRequest* request = [_pendingRequests objectForKey:@(requestID)];
+
+        if (request != nil){
+
+            [request setResponse:frame];
+            [_pendingRequests removeObjectForKey:@(requestID)];
+            dispatch_semaphore_signal([request semaphore]);
+
+        }
+
+    }
+
+    if (invalid)
+        [self disconnect];
+
+}
+
+//sends a request and waits for its response frame
+-(BOOL)sendRequest:(EOSDaemonOpcode)opcode body:(NSData*)body response:(NSData* __autoreleasing*)response error:(NSError* __autoreleasing*)error{
+
+    EOSDaemonPendingRequest* request = [[EOSDaemonPendingRequest alloc] init];
+    [request setSemaphore:dispatch_semaphore_create(0)];
+
+    __block UInt32 requestID = 0;
+    __block BOOL connected;
+
+    dispatch_sync(_queue, ^(void){
+
+        connected = _readSource != nil;
+
+        if (connected){
+
+            requestID = _nextRequestID++;
+
+            //0 is reserved for events
+            if (_nextRequestID == 0)
+                _nextRequestID = 1;
+
+            [_pendingRequests setObject:request forKey:@(requestID)];
+
+        }
+
+    });
+
+    NSMutableData* frame = EOSDaemonCreateFrame(requestID, opcode);
+    [frame appendData:body];
+    EOSDaemonFinishFrame(frame);
+
+    __block BOOL written = NO;
+
+    if (connected){
+
+        dispatch_sync(_writeQueue, ^(void){
+            written = _fd >= 0 && EOSDaemonWriteAll(_fd, frame);
+        });
+
+    }
+
+    EOSError errorCode = EOSError_OK;
+
+    if (!written){
+
+        errorCode = EOSError_COMM_Disconnected;
+
+    }else if (dispatch_semaphore_wait([request semaphore], dispatch_time(DISPATCH_TIME_NOW, EOSDaemonClientTimeout * NSEC_PER_SEC)) != 0){
+
+        errorCode = EOSError_Timeout;
+
+    }else if ([request response] == nil){
+
+        errorCode = EOSError_COMM_Disconnected;
+
+    }
+
+    if (errorCode != EOSError_OK){
+
+        dispatch_sync(_queue, ^(void){
+            [_pendingRequests removeObjectForKey:@(requestID)];
+        });
+
+        if (error)
+            *error = EOSCreateError(errorCode);
+        return NO;
+
+    }
+
+    *response = [request response];
+    return YES;
+
+}
+
+
+
+
+#pragma mark - Accessing Cameras
+
+-(NSArray*)cameras:(NSError *__autoreleasing *)error{
+
+    NSData* response;
+
+    if (![self sendRequest:EOSDaemonOpcode_ListCameras body:[NSData data] response:&response error:error])
+        return nil;
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(response, EOSDaemonFrameHeaderLength);
+    UInt16 i, count = EOSDaemonReadUInt16(&reader);
+
+    NSMutableArray* cameras = [NSMutableArray arrayWithCapacity:count];
+
+    for (i=0; i<count; i++){
+
+        UInt32 identifier = EOSDaemonReadUInt32(&reader);
+        BOOL isOpen = EOSDaemonReadUInt8(&reader);
+        NSString* serialNumber = EOSDaemonReadString(&reader);
+        NSString* cameraDescription = EOSDaemonReadString(&reader);
+
+        if (reader.failed)
+            break;
+
+        [cameras addObject:[[EOSDaemonCamera alloc] initWithIdentifier:identifier isOpen:isOpen serialNumber:serialNumber cameraDescription:cameraDescription]];
+
+    }
+
+    if (reader.failed){
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidLength);
+        return nil;
+
+    }
+
+    return [NSArray arrayWithArray:cameras];
+
+}
+
+-(BOOL)getProperties:(NSArray *)properties error:(NSError *__autoreleasing *)error{
+
+    NSMutableData* body = [NSMutableData data];
+    EOSDaemonAppendUInt16(body, (UInt16)[properties count]);
+
+    for (EOSDaemonProperty* property in properties){
+
+        EOSDaemonAppendUInt32(body, [property camera]);
+        EOSDaemonAppendUInt32(body, (UInt32)[property property]);
+        EOSDaemonAppendUInt32(body, (UInt32)[property parameter]);
+
+    }
+
+    NSData* response;
+
+    if (![self sendRequest:EOSDaemonOpcode_GetProperties body:body response:&response error:error])
+        return NO;
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(response, EOSDaemonFrameHeaderLength);
+    UInt16 count = EOSDaemonReadUInt16(&reader);
+
+    if (count != [properties count])
+        reader.failed = YES;
+
+    for (EOSDaemonProperty* property in properties){
+
+        EOSError errorCode = EOSDaemonReadUInt32(&reader);
+        UInt32 dataType = EOSDaemonReadUInt32(&reader);
+        UInt32 size = EOSDaemonReadUInt32(&reader);
+        NSData* value = EOSDaemonReadData(&reader, size);
+
+        if (reader.failed)
+            break;
+
+        [property setError:EOSCreateError(errorCode)];
+        [property setDataType:dataType];
+        [property setValue:errorCode == EOSError_OK ? value : nil];
+
+    }
+
+    if (reader.failed){
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidLength);
+        return NO;
+
+    }
+
+    return YES;
+
+}
+
+-(BOOL)setProperties:(NSArray *)properties error:(NSError *__autoreleasing *)error{
+
+    NSMutableData* body = [NSMutableData data];
+    EOSDaemonAppendUInt16(body, (UInt16)[properties count]);
+
+    for (EOSDaemonProperty* property in properties){
+
+        NSData* value = [property value];
+
+        EOSDaemonAppendUInt32(body, [property camera]);
+        EOSDaemonAppendUInt32(body, (UInt32)[property property]);
+        EOSDaemonAppendUInt32(body, (UInt32)[property parameter]);
+        EOSDaemonAppendUInt32(body, (UInt32)[value length]);
+
+        if (value != nil)
+            [body appendData:value];
+
+    }
+
+    NSData* response;
+
+    if (![self sendRequest:EOSDaemonOpcode_SetProperties body:body response:&response error:error])
+        return NO;
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(response, EOSDaemonFrameHeaderLength);
+    UInt16 count = EOSDaemonReadUInt16(&reader);
+
+    if (count != [properties count])
+        reader.failed = YES;
+
+    for (EOSDaemonProperty* property in properties){
+
+        EOSError errorCode = EOSDaemonReadUInt32(&reader);
+
+        if (reader.failed)
+            break;
+
+        [property setError:EOSCreateError(errorCode)];
+
+    }
+
+    if (reader.failed){
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidLength);
+        return NO;
+
+    }
+
+    return YES;
+
+}
+
+-(NSArray*)sendCommand:(EOSCameraCommand)command withParameter:(NSInteger)parameter toCameras:(NSArray *)cameras error:(NSError *__autoreleasing *)error{
+
+    NSMutableData* body = [NSMutableData data];
+    EOSDaemonAppendUInt32(body, (UInt32)command);
+    EOSDaemonAppendUInt32(body, (UInt32)parameter);
+    EOSDaemonAppendUInt16(body, (UInt16)[cameras count]);
+
+    for (NSNumber* camera in cameras)
+        EOSDaemonAppendUInt32(body, [camera unsignedIntValue]);
+
+    NSData* response;
+
+    if (![self sendRequest:EOSDaemonOpcode_SendCommand body:body response:&response error:error])
+        return nil;
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(response, EOSDaemonFrameHeaderLength);
+    UInt16 i, count = EOSDaemonReadUInt16(&reader);
+
+    NSMutableArray* errors = [NSMutableArray arrayWithCapacity:count];
+
+    for (i=0; i<count && !reader.failed; i++){
+
+        NSError* commandError = EOSCreateError(EOSDaemonReadUInt32(&reader));
+        [errors addObject:commandError != nil ? commandError : [NSNull null]];
+
+    }
+
+    if (reader.failed || count != [cameras count]){
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidLength);
+        return nil;
+
+    }
+
+    return [NSArray arrayWithArray:errors];
+
+}
+
+
+
+
+#pragma mark - Receiving Events
+
+-(BOOL)subscribeToCameras:(NSArray *)cameras handler:(void (^)(UInt32, EOSDaemonEvent, EOSProperty))handler error:(NSError *__autoreleasing *)error{
+
+    NSMutableData* body = [NSMutableData data];
+    EOSDaemonAppendUInt16(body, (UInt16)[cameras count]);
+
+    for (NSNumber* camera in cameras)
+        EOSDaemonAppendUInt32(body, [camera unsignedIntValue]);
+
+    //set before subscribing, so no early events are missed
+    dispatch_sync(_queue, ^(void){
+        _eventHandler = [handler copy];
+    });
+
+    return [self sendStatusRequest:EOSDaemonOpcode_Subscribe body:body error:error];
+
+}
+
+-(BOOL)unsubscribe:(NSError *__autoreleasing *)error{
+
+    BOOL success = [self sendStatusRequest:EOSDaemonOpcode_Unsubscribe body:[NSData data] error:error];
+
+    dispatch_sync(_queue, ^(void){
+        _eventHandler = nil;
+    });
+
+    return success;
+
+}
+
+
+
+
+#pragma mark - Sharing Files and Frames
+
+-(EOSSharedRing*)attachSharedRing:(NSError *__autoreleasing *)error{
+
+    __block EOSSharedRing* ring;
+
+    dispatch_sync(_queue, ^(void){
+        ring = _sharedRing;
+    });
+
+    if (ring != nil)
+        return ring;
+
+    NSData* response;
+
+    if (![self sendRequest:EOSDaemonOpcode_AttachRing body:[NSData data] response:&response error:error])
+        return nil;
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(response, EOSDaemonFrameHeaderLength);
+    EOSError errorCode = EOSDaemonReadUInt32(&reader);
+    UInt32 consumerIndex = EOSDaemonReadUInt32(&reader);
+
+    if (reader.failed)
+        errorCode = EOSError_InvalidLength;
+
+    __block int descriptor = -1;
+
+    dispatch_sync(_queue, ^(void){
+
+        if ([_receivedDescriptors count] > 0){
+
+            descriptor = [[_receivedDescriptors firstObject] intValue];
+            [_receivedDescriptors removeObjectAtIndex:0];
+
+        }
+
+    });
+
+    if (errorCode == EOSError_OK && descriptor < 0)
+        errorCode = EOSError_InvalidHandle;
+
+    if (errorCode != EOSError_OK){
+
+        if (descriptor >= 0)
+            close(descriptor);
+
+        if (error)
+            *error = EOSCreateError(errorCode);
+        return nil;
+
+    }
+
+    ring = [[EOSSharedRing alloc] initWithFileDescriptor:descriptor consumerIndex:consumerIndex error:error];
+
+    if (ring == nil){
+
+        close(descriptor);
+        return nil;
+
+    }
+
+    dispatch_sync(_queue, ^(void){
+
+        _sharedRing = ring;
+
+        for (NSArray* earlySlot in _earlySlots)
+            [self deliverSlotAtIndex:[earlySlot[1] unsignedIntValue] camera:[earlySlot[0] unsignedIntValue]];
+
+        [_earlySlots removeAllObjects];
+
+    });
+
+    return ring;
+
+}
+
+//must be called on _queue
+-(void)deliverSlotAtIndex:(UInt32)index camera:(UInt32)camera{
+
+    EOSSharedSlot* slot = [_sharedRing slotAtIndex:index];
+    void (^handler)(UInt32, EOSSharedSlot*) = _slotHandler;
+
+    if (slot == nil)
+        return;
+
+    if (handler != nil){
+
+        dispatch_async(dispatch_get_main_queue(), ^(void){
+            handler(camera, slot);
+        });
+
+    }else{
+
+        [_sharedRing releaseSlot:slot];
+
+    }
+
+}
+
+-(void)setSlotHandler:(void (^)(UInt32, EOSSharedSlot *))handler{
+
+    dispatch_sync(_queue, ^(void){
+        _slotHandler = [handler copy];
+    });
+
+}
+
+-(BOOL)sendStatusRequest:(EOSDaemonOpcode)opcode body:(NSData*)body error:(NSError* __autoreleasing*)error{
+
+    NSData* response;
+
+    if (![self sendRequest:opcode body:body response:&response error:error])
+        return NO;
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(response, EOSDaemonFrameHeaderLength);
+    EOSError errorCode = EOSDaemonReadUInt32(&reader);
+
+    if (reader.failed)
+        errorCode = EOSError_InvalidLength;
+
+    if (errorCode != EOSError_OK){
+
+        if (error)
+            *error = EOSCreateError(errorCode);
+        return NO;
+
+    }
+
+    return YES;
+
+}
+
+@end
\ No newline at end of file
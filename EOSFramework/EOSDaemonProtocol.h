@@ -0,0 +1,309 @@
+//
+//  EOSDaemonProtocol.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+// Wire format shared by EOSDaemon and EOSDaemonClient. This header is not public.
+//
+// Every message is a frame: [u32 length][u32 request ID][u8 opcode][body], where length
+// counts the request ID, opcode and body. All integers are little endian and strings are
+// [u16 length][UTF-8 bytes]. Responses carry the request ID and opcode of their request;
+// events are sent with a request ID of 0.
+//
+// ListCameras     -> [u16 count]{[u32 camera][u8 isOpen][str serial][str description]}
+// GetProperties   [u16 count]{[u32 camera][u32 property][u32 parameter]}
+//                 -> [u16 count]{[u32 error][u32 dataType][u32 size][bytes]}
+// SetProperties   [u16 count]{[u32 camera][u32 property][u32 parameter][u32 size][bytes]}
+//                 -> [u16 count]{[u32 error]}
+// SendCommand     [u32 command][u32 parameter][u16 count]{[u32 camera]}
+//                 -> [u16 count]{[u32 error]}
+// Subscribe       [u16 count]{[u32 camera]}, a count of 0 subscribes to all cameras
+//                 -> [u32 error]
+// Unsubscribe     -> [u32 error]
+// AttachRing      -> [u32 error][u32 consumer][u32 slotCount][u32 slotSize], with the ring's
+//                    file descriptor attached to the response using SCM_RIGHTS
+// Event           [u32 camera][u8 event][u32 property]
+// SlotPublished   [u32 camera][u32 slot], sent to clients that attached the ring
+
+#import <Foundation/Foundation.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+#define EOSDaemonMaxFrameLength     (16 * 1024 * 1024)
+#define EOSDaemonFrameHeaderLength  9
+
+typedef NS_ENUM(UInt8, EOSDaemonOpcode){
+
+    EOSDaemonOpcode_ListCameras     = 1,
+    EOSDaemonOpcode_GetProperties   = 2,
+    EOSDaemonOpcode_SetProperties   = 3,
+    EOSDaemonOpcode_SendCommand     = 4,
+    EOSDaemonOpcode_Subscribe       = 5,
+    EOSDaemonOpcode_Unsubscribe     = 6,
+    EOSDaemonOpcode_AttachRing      = 7,
+    EOSDaemonOpcode_Event           = 0x80,
+    EOSDaemonOpcode_SlotPublished   = 0x81
+
+};
+
+
+
+static inline void EOSDaemonAppendUInt8(NSMutableData* data, UInt8 value){
+
+    [data appendBytes:&value length:sizeof(value)];
+
+}
+
+static inline void EOSDaemonAppendUInt16(NSMutableData* data, UInt16 value){
+
+    value = OSSwapHostToLittleInt16(value);
+    [data appendBytes:&value length:sizeof(value)];
+
+}
+
+static inline void EOSDaemonAppendUInt32(NSMutableData* data, UInt32 value){
+
+    value = OSSwapHostToLittleInt32(value);
+    [data appendBytes:&value length:sizeof(value)];
+
+}
+
+static inline void EOSDaemonAppendString(NSMutableData* data, NSString* string){
+
+    NSData* bytes = [(string != nil ? string : @"") dataUsingEncoding:NSUTF8StringEncoding];
+    NSUInteger length = MIN([bytes length], UINT16_MAX);
+
+    EOSDaemonAppendUInt16(data, (UInt16)length);
+    [data appendBytes:[bytes bytes] length:length];
+
+}
+
+//returns a frame with space for the header, which is filled in by EOSDaemonFinishFrame
+static inline NSMutableData* EOSDaemonCreateFrame(UInt32 requestID, EOSDaemonOpcode opcode){
+
+    NSMutableData* frame = [NSMutableData dataWithCapacity:64];
+
+    EOSDaemonAppendUInt32(frame, 0);
+    EOSDaemonAppendUInt32(frame, requestID);
+    EOSDaemonAppendUInt8(frame, opcode);
+
+    return frame;
+
+}
+
+static inline void EOSDaemonFinishFrame(NSMutableData* frame){
+
+    UInt32 length = OSSwapHostToLittleInt32((UInt32)[frame length] - sizeof(UInt32));
+    [frame replaceBytesInRange:NSMakeRange(0, sizeof(length)) withBytes:&length];
+
+}
+
+
+
+//reads values from a frame body, failing once the end is passed
+typedef struct{
+
+    const UInt8* bytes;
+    NSUInteger length;
+    NSUInteger offset;
+    BOOL failed;
+
+} EOSDaemonReader;
+
+static inline EOSDaemonReader EOSDaemonReaderCreate(NSData* data, NSUInteger offset){
+
+    EOSDaemonReader reader = {[data bytes], [data length], offset, NO};
+    return reader;
+
+}
+
+static inline const UInt8* EOSDaemonReadBytes(EOSDaemonReader* reader, NSUInteger length){
+
+    if (reader->failed || reader->offset + length > reader->length){
+
+        reader->failed = YES;
+        return NULL;
+
+    }
+
+    const UInt8* bytes = reader->bytes + reader->offset;
+    reader->offset += length;
+
+    return bytes;
+
+}
+
+static inline UInt8 EOSDaemonReadUInt8(EOSDaemonReader* reader){
+
+    const UInt8* bytes = EOSDaemonReadBytes(reader, sizeof(UInt8));
+    return bytes != NULL ? *bytes : 0;
+
+}
+
+static inline UInt16 EOSDaemonReadUInt16(EOSDaemonReader* reader){
+
+    UInt16 value = 0;
+    const UInt8* bytes = EOSDaemonReadBytes(reader, sizeof(value));
+
+    if (bytes != NULL)
+        memcpy(&value, bytes, sizeof(value));
+
+    return OSSwapLittleToHostInt16(value);
+
+}
+
+static inline UInt32 EOSDaemonReadUInt32(EOSDaemonReader* reader){
+
+    UInt32 value = 0;
+    const UInt8* bytes = EOSDaemonReadBytes(reader, sizeof(value));
+
+    if (bytes != NULL)
+        memcpy(&value, bytes, sizeof(value));
+
+    return OSSwapLittleToHostInt32(value);
+
+}
+
+static inline NSData* EOSDaemonReadData(EOSDaemonReader* reader, NSUInteger length){
+
+    const UInt8* bytes = EOSDaemonReadBytes(reader, length);
+    return bytes != NULL ? [NSData dataWithBytes:bytes length:length] : nil;
+
+}
+
+static inline NSString* EOSDaemonReadString(EOSDaemonReader* reader){
+
+    UInt16 length = EOSDaemonReadUInt16(reader);
+    const UInt8* bytes = EOSDaemonReadBytes(reader, length);
+
+    if (bytes == NULL)
+        return nil;
+
+    return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+
+}
+
+
+
+//writes a whole buffer to a blocking socket
+static inline BOOL EOSDaemonWriteAll(int fd, NSData* data){
+
+    const UInt8* bytes = [data bytes];
+    NSUInteger remaining = [data length];
+
+    while (remaining > 0){
+
+        ssize_t written = write(fd, bytes, remaining);
+
+        if (written < 0){
+
+            if (errno == EINTR)
+                continue;
+
+            return NO;
+
+        }
+
+        bytes += written;
+        remaining -= written;
+
+    }
+
+    return YES;
+
+}
+
+//writes a whole buffer to a blocking socket, attaching a file descriptor to the first byte
+static inline BOOL EOSDaemonWriteAllWithDescriptor(int fd, NSData* data, int descriptor){
+
+    char control[CMSG_SPACE(sizeof(int))];
+    memset(control, 0, sizeof(control));
+
+    struct iovec iov = {(void*)[data bytes], [data length]};
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &descriptor, sizeof(int));
+
+    ssize_t written;
+
+    do{
+        written = sendmsg(fd, &message, 0);
+    }while (written < 0 && errno == EINTR);
+
+    if (written <= 0)
+        return NO;
+
+    return EOSDaemonWriteAll(fd, [data subdataWithRange:NSMakeRange(written, [data length] - written)]);
+
+}
+
+//reads from a socket, returning any file descriptor that was attached in received
+static inline ssize_t EOSDaemonReadWithDescriptor(int fd, void* buffer, size_t length, int* received){
+
+    char control[CMSG_SPACE(sizeof(int))];
+
+    struct iovec iov = {buffer, length};
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    *received = -1;
+    ssize_t result = recvmsg(fd, &message, 0);
+
+    struct cmsghdr* header;
+
+    for (header = CMSG_FIRSTHDR(&message); result > 0 && header != NULL; header = CMSG_NXTHDR(&message, header)){
+
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS)
+            memcpy(received, CMSG_DATA(header), sizeof(int));
+
+    }
+
+    return result;
+
+}
+
+//removes and returns the first complete frame in a buffer, or nil if there isn't one
+static inline NSData* EOSDaemonTakeFrame(NSMutableData* buffer, BOOL* invalid){
+
+    if ([buffer length] < sizeof(UInt32))
+        return nil;
+
+    UInt32 length;
+    [buffer getBytes:&length length:sizeof(length)];
+    length = OSSwapLittleToHostInt32(length);
+
+    if (length < EOSDaemonFrameHeaderLength - sizeof(UInt32) || length > EOSDaemonMaxFrameLength){
+
+        *invalid = YES;
+        return nil;
+
+    }
+
+    if ([buffer length] < sizeof(UInt32) + length)
+        return nil;
+
+    NSData* frame = [buffer subdataWithRange:NSMakeRange(0, sizeof(UInt32) + length)];
+    [buffer replaceBytesInRange:NSMakeRange(0, sizeof(UInt32) + length) withBytes:NULL length:0];
+
+    return frame;
+
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+//
+//  EOSDeviceRegistry.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSCameraProfile;
+@class EOSFleetResult;
+
+/*!
+ @brief Posted on the main thread when the registry has revalidated a camera against its record. The object of the notification is the camera.
+ @discussion The user info dictionary contains the EOSDeviceRecordKey key.
+ */
+FOUNDATION_EXPORT NSString *const EOSDeviceRegistryDidRefreshCameraNotification;
+
+/*!
+ @brief The camera's EOSDeviceRecord, as it was after revalidation.
+ */
+FOUNDATION_EXPORT NSString *const EOSDeviceRecordKey;
+
+/*!
+ The EOSDeviceRecord class describes a camera that the registry has seen before.
+ */
+@interface EOSDeviceRecord : NSObject
+
+/*!
+ @brief The camera's serial number, which identifies the record.
+ */
+@property (readonly) NSString* serialNumber;
+
+/*!
+ @brief The camera's description, which is typically its model name.
+ */
+@property (readonly) NSString* cameraDescription;
+
+/*!
+ @brief The camera's port when it was last seen.
+ */
+@property (readonly) NSString* port;
+
+/*!
+ @brief The time that the camera was last revalidated.
+ */
+@property (readonly) NSDate* lastSeenDate;
+
+/*!
+ @brief The index of the first volume that had space available when the camera was last revalidated, or NSNotFound if it is unknown.
+ */
+@property (readonly) NSUInteger volumeIndex;
+
+/*!
+ @brief The camera's settings when it was last revalidated, or nil if they are unknown.
+ */
+@property (readonly, nullable) EOSCameraProfile* settings;
+
+@end
+
+
+
+/*!
+ The EOSDeviceRegistry class remembers the cameras that have been connected, so that they can be brought back quickly when the process restarts.
+ @discussion The registry stores the serial number, model, port, settings and volume index of each camera, in a file that outlives the process. When cameras are restored, every session is opened in parallel, and each camera is matched to its record by model and port. The record's serial number is then available from [EOSCamera provisionalSerialNumber] straight away, and the record's settings and volume index can be read with recordForCamera: immediately. The registry doesn't apply the settings to the camera.
+
+ Matching by port is a guess, because ports can change when cameras are reconnected. Each camera is revalidated in the background after it is restored: its serial number, settings and volumes are read from the camera, [EOSCamera serialNumber] is set, the record is corrected and saved, and EOSDeviceRegistryDidRefreshCameraNotification is posted.
+ */
+@interface EOSDeviceRegistry : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the singleton instance of EOSDeviceRegistry.
+ @return The singleton instance of EOSDeviceRegistry.
+ */
++(EOSDeviceRegistry*)sharedRegistry;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The location of the registry file. The default value is Devices.plist in the EOSFramework directory of the user's application support directory.
+ @discussion Setting this property discards the records in memory; they are loaded from the new location when they are next needed.
+ */
+@property (copy) NSURL* fileURL;
+
+/*!
+ @brief The maximum number of cameras that are restored or revalidated at once. The default value is 8.
+ */
+@property NSUInteger maxConcurrentOperations;
+
+/*!
+ @brief The records of every camera that has been seen, most recently seen first.
+ */
+@property (readonly) NSArray<EOSDeviceRecord*>* records;
+
+
+
+///------------------------
+/// @name Restoring Cameras
+///------------------------
+
+/*!
+ @brief Opens a session with every connected camera in parallel, and matches each camera to its record.
+ @discussion The EDSDK must be loaded. Cameras that already have an open session are matched without opening another one. Each camera is revalidated in the background once its session is open.
+ @param completion A block that is called on the main thread once every session has been opened. The value for each camera is its EOSDeviceRecord, or NSNull if the camera hasn't been seen before.
+ */
+-(void)restoreCamerasWithCompletion:(nullable void (^)(EOSFleetResult* result))completion;
+
+/*!
+ @brief Gets the record that matches a camera.
+ @discussion If the camera's serial number has been read, the record is matched by serial number, otherwise by model and port.
+ @param camera The camera.
+ @return The record, or nil if the camera doesn't match a record.
+ */
+-(nullable EOSDeviceRecord*)recordForCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Reads a camera's serial number, settings and volumes, and records them.
+ @discussion This method is synchronous. The camera must have an open session.
+ @param camera The camera.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The camera's updated record, or nil if the serial number couldn't be read.
+ */
+-(nullable EOSDeviceRecord*)refreshCamera:(EOSCamera*)camera error:(NSError* __autoreleasing*)error;
+
+
+
+///-----------------------
+/// @name Managing Records
+///-----------------------
+
+/*!
+ @brief Forgets a camera.
+ @param serialNumber The camera's serial number.
+ */
+-(void)removeRecordForSerialNumber:(NSString*)serialNumber;
+
+/*!
+ @brief Writes the records to the registry file.
+ @discussion Records are saved automatically when a camera is refreshed.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)save:(NSError* __autoreleasing*)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
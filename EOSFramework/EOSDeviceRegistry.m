@@ -0,0 +1,441 @@
+//
+//  EOSDeviceRegistry.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSDeviceRegistry.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSVolume.h>
+#import <EOSFramework/EOSManager.h>
+#import <EOSFramework/EOSFleetResult.h>
+#import <EOSFramework/EOSCameraProfile.h>
+#import <EOSFramework/EOSError.h>
+#import "EOSPrivate.h"
+
+#define EOSDeviceRegistryVersion            1
+#define EOSDeviceRegistryDefaultConcurrency 8
+
+NSString *const EOSDeviceRegistryDidRefreshCameraNotification = @"EOSDeviceRegistryDidRefreshCameraNotification";
+NSString *const EOSDeviceRecordKey = @"EOSDeviceRecordKey";
+
+static NSString *const EOSDeviceRegistryVersionKey = @"Version";
+static NSString *const EOSDeviceRegistryRecordsKey = @"Records";
+static NSString *const EOSDeviceSerialNumberKey = @"SerialNumber";
+static NSString *const EOSDeviceDescriptionKey = @"Description";
+static NSString *const EOSDevicePortKey = @"Port";
+static NSString *const EOSDeviceLastSeenDateKey = @"LastSeenDate";
+static NSString *const EOSDeviceVolumeIndexKey = @"VolumeIndex";
+static NSString *const EOSDeviceSettingsKey = @"Settings";
+
+@interface EOSDeviceRecord ()
+
+-(id)initWithSerialNumber:(NSString*)serialNumber cameraDescription:(NSString*)cameraDescription port:(NSString*)port lastSeenDate:(NSDate*)lastSeenDate volumeIndex:(NSUInteger)volumeIndex settingsData:(NSData*)settingsData;
+-(id)initWithPropertyList:(NSDictionary*)propertyList;
+-(NSDictionary*)propertyList;
+
+@end
+
+@implementation EOSDeviceRecord{
+
+    NSData* _settingsData;
+
+}
+
+-(id)initWithSerialNumber:(NSString *)serialNumber cameraDescription:(NSString *)cameraDescription port:(NSString *)port lastSeenDate:(NSDate *)lastSeenDate volumeIndex:(NSUInteger)volumeIndex settingsData:(NSData *)settingsData{
+
+    self = [super init];
+    if (self){
+
+        _serialNumber = serialNumber;
+        _cameraDescription = cameraDescription ?: @"";
+        _port = port ?: @"";
+        _lastSeenDate = lastSeenDate;
+        _volumeIndex = volumeIndex;
+        _settingsData = settingsData;
+
+        if (settingsData != nil)
+            _settings = [[EOSCameraProfile alloc] initWithData:settingsData error:nil];
+
+    }
+
+    return self;
+
+}
+
+-(id)initWithPropertyList:(NSDictionary *)propertyList{
+
+    NSString* serialNumber = [propertyList objectForKey:EOSDeviceSerialNumberKey];
+    NSDate* lastSeenDate = [propertyList objectForKey:EOSDeviceLastSeenDateKey];
+    NSNumber* volumeIndex = [propertyList objectForKey:EOSDeviceVolumeIndexKey];
+    NSData* settingsData = [propertyList objectForKey:EOSDeviceSettingsKey];
+
+    if (![serialNumber isKindOfClass:[NSString class]] || ![lastSeenDate isKindOfClass:[NSDate class]])
+        return nil;
+
+    return [self initWithSerialNumber:serialNumber
+                    cameraDescription:[propertyList objectForKey:EOSDeviceDescriptionKey]
+                                 port:[propertyList objectForKey:EOSDevicePortKey]
+                         lastSeenDate:lastSeenDate
+                          volumeIndex:volumeIndex != nil ? [volumeIndex unsignedIntegerValue] : NSNotFound
+                         settingsData:[settingsData isKindOfClass:[NSData class]] ? settingsData : nil];
+
+}
+
+-(NSDictionary*)propertyList{
+
+    NSMutableDictionary* propertyList = [NSMutableDictionary dictionary];
+
+    [propertyList setObject:_serialNumber forKey:EOSDeviceSerialNumberKey];
+    [propertyList setObject:_cameraDescription forKey:EOSDeviceDescriptionKey];
+    [propertyList setObject:_port forKey:EOSDevicePortKey];
+    [propertyList setObject:_lastSeenDate forKey:EOSDeviceLastSeenDateKey];
+
+    if (_volumeIndex != NSNotFound)
+        [propertyList setObject:@(_volumeIndex) forKey:EOSDeviceVolumeIndexKey];
+
+    if (_settingsData != nil)
+        [propertyList setObject:_settingsData forKey:EOSDeviceSettingsKey];
+
+    return propertyList;
+
+}
+
+-(NSString*)description{
+
+    return [NSString stringWithFormat:@"<%@: %@ %@ on %@>", [self class], _cameraDescription, _serialNumber, _port];
+
+}
+
+@end
+
+
+
+
+@implementation EOSDeviceRegistry{
+
+    dispatch_queue_t _queue;
+    NSMutableDictionary* _records;
+    BOOL _loaded;
+
+}
+
+@synthesize fileURL = _fileURL;
+
++(EOSDeviceRegistry*)sharedRegistry{
+
+    static EOSDeviceRegistry* sharedRegistry;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^(void){
+        sharedRegistry = [[EOSDeviceRegistry alloc] init];
+    });
+
+    return sharedRegistry;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _queue = dispatch_queue_create("com.EOSFramework.registry", DISPATCH_QUEUE_SERIAL);
+        _records = [NSMutableDictionary dictionary];
+        _maxConcurrentOperations = EOSDeviceRegistryDefaultConcurrency;
+
+        NSURL* supportURL = [[[NSFileManager defaultManager] URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask] firstObject];
+        _fileURL = [[supportURL URLByAppendingPathComponent:@"EOSFramework" isDirectory:YES] URLByAppendingPathComponent:@"Devices.plist"];
+
+    }
+
+    return self;
+
+}
+
+-(NSURL*)fileURL{
+
+    __block NSURL* fileURL;
+
+    dispatch_sync(_queue, ^(void){
+        fileURL = _fileURL;
+    });
+
+    return fileURL;
+
+}
+
+-(void)setFileURL:(NSURL *)fileURL{
+
+    dispatch_sync(_queue, ^(void){
+
+        _fileURL = [fileURL copy];
+        [_records removeAllObjects];
+        _loaded = NO;
+
+    });
+
+}
+
+-(NSArray*)records{
+
+    __block NSArray* records;
+
+    dispatch_sync(_queue, ^(void){
+
+        [self loadOnQueue];
+        records = [_records allValues];
+
+    });
+
+    return [records sortedArrayUsingComparator:^NSComparisonResult(EOSDeviceRecord* record1, EOSDeviceRecord* record2){
+        return [[record2 lastSeenDate] compare:[record1 lastSeenDate]];
+    }];
+
+}
+
+
+
+
+#pragma mark - Loading and Saving
+
+//must be called on the queue
+-(void)loadOnQueue{
+
+    if (_loaded)
+        return;
+
+    _loaded = YES;
+
+    NSData* data = [NSData dataWithContentsOfURL:_fileURL];
+
+    if (data == nil)
+        return;
+
+    NSDictionary* propertyList = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+
+    if (![propertyList isKindOfClass:[NSDictionary class]] || [[propertyList objectForKey:EOSDeviceRegistryVersionKey] integerValue] != EOSDeviceRegistryVersion)
+        return;
+
+    NSArray* records = [propertyList objectForKey:EOSDeviceRegistryRecordsKey];
+
+    if (![records isKindOfClass:[NSArray class]])
+        return;
+
+    for (NSDictionary* recordPropertyList in records){
+
+        if (![recordPropertyList isKindOfClass:[NSDictionary class]])
+            continue;
+
+        EOSDeviceRecord* record = [[EOSDeviceRecord alloc] initWithPropertyList:recordPropertyList];
+
+        if (record != nil)
+            [_records setObject:record forKey:[record serialNumber]];
+
+    }
+
+}
+
+//must be called on the queue
+-(BOOL)saveOnQueue:(NSError* __autoreleasing*)error{
+
+    NSMutableArray* records = [NSMutableArray arrayWithCapacity:[_records count]];
+
+    for (EOSDeviceRecord* record in [_records allValues])
+        [records addObject:[record propertyList]];
+
+    NSDictionary* propertyList = @{EOSDeviceRegistryVersionKey: @(EOSDeviceRegistryVersion), EOSDeviceRegistryRecordsKey: records};
+    NSData* data = [NSPropertyListSerialization dataWithPropertyList:propertyList format:NSPropertyListBinaryFormat_v1_0 options:0 error:error];
+
+    if (data == nil)
+        return NO;
+
+    if (![[NSFileManager defaultManager] createDirectoryAtURL:[_fileURL URLByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:error])
+        return NO;
+
+    return [data writeToURL:_fileURL options:NSDataWritingAtomic error:error];
+
+}
+
+-(BOOL)save:(NSError *__autoreleasing *)error{
+
+    __block BOOL success;
+    __block NSError* saveError;
+
+    dispatch_sync(_queue, ^(void){
+
+        [self loadOnQueue];
+        success = [self saveOnQueue:&saveError];
+
+    });
+
+    if (!success && error)
+        *error = saveError;
+
+    return success;
+
+}
+
+-(void)removeRecordForSerialNumber:(NSString *)serialNumber{
+
+    dispatch_async(_queue, ^(void){
+
+        [self loadOnQueue];
+        [_records removeObjectForKey:serialNumber];
+        [self saveOnQueue:nil];
+
+    });
+
+}
+
+
+
+
+#pragma mark - Matching Cameras
+
+//must be called on the queue
+-(EOSDeviceRecord*)recordForCameraDescription:(NSString*)cameraDescription port:(NSString*)port excludingSerialNumbers:(NSSet*)excludedSerialNumbers{
+
+    EOSDeviceRecord* match;
+
+    for (EOSDeviceRecord* record in [_records allValues]){
+
+        if ([excludedSerialNumbers containsObject:[record serialNumber]] || ![[record cameraDescription] isEqualToString:cameraDescription] || ![[record port] isEqualToString:port])
+            continue;
+
+        //two records on the same port can't be told apart
+        if (match != nil)
+            return nil;
+
+        match = record;
+
+    }
+
+    return match;
+
+}
+
+-(EOSDeviceRecord*)recordForCamera:(EOSCamera *)camera{
+
+    NSString* serialNumber = [camera serialNumber];
+    __block EOSDeviceRecord* record;
+
+    dispatch_sync(_queue, ^(void){
+
+        [self loadOnQueue];
+
+        if (serialNumber != nil)
+            record = [_records objectForKey:serialNumber];
+        else
+            record = [self recordForCameraDescription:[camera cameraDescription] port:[camera port] excludingSerialNumbers:nil];
+
+    });
+
+    return record;
+
+}
+
+
+
+
+#pragma mark - Restoring Cameras
+
+-(void)restoreCamerasWithCompletion:(void (^)(EOSFleetResult *))completion{
+
+    NSArray* cameras = [[EOSManager sharedManager] getCameras];
+    NSMutableSet* claimedSerialNumbers = [NSMutableSet set];
+
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        if (![camera isOpen] && ![camera openSession:error])
+            return nil;
+
+        __block EOSDeviceRecord* record;
+
+        //each record can only be claimed by one camera
+        dispatch_sync(_queue, ^(void){
+
+            [self loadOnQueue];
+            record = [self recordForCameraDescription:[camera cameraDescription] port:[camera port] excludingSerialNumbers:claimedSerialNumbers];
+
+            if (record != nil)
+                [claimedSerialNumbers addObject:[record serialNumber]];
+
+        });
+
+        //the match is a guess, so it isn't served as the camera's serial number until the camera has been revalidated
+        if (record != nil)
+            [camera setProvisionalSerialNumber:[record serialNumber]];
+
+        return record ?: [NSNull null];
+
+    } onCameras:cameras maxConcurrentOperations:_maxConcurrentOperations completion:^(EOSFleetResult* result){
+
+        if (completion)
+            completion(result);
+
+        [self revalidateCameras:[result succeededCameras]];
+
+    }];
+
+}
+
+-(void)revalidateCameras:(NSArray*)cameras{
+
+    if ([cameras count] == 0)
+        return;
+
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        return [self refreshCamera:camera error:error];
+
+    } onCameras:cameras maxConcurrentOperations:_maxConcurrentOperations completion:nil];
+
+}
+
+-(EOSDeviceRecord*)refreshCamera:(EOSCamera *)camera error:(NSError *__autoreleasing *)error{
+
+    //the serial number is read from the camera, as the cached one may belong to another camera
+    NSString* serialNumber = [camera stringValueForProperty:EOSProperty_SerialNumber error:error];
+
+    if (serialNumber == nil)
+        return nil;
+
+    [camera setCachedSerialNumber:serialNumber];
+
+    NSData* settingsData = [[[EOSCameraProfile alloc] initWithCamera:camera properties:nil error:nil] data];
+    NSUInteger volumeIndex = NSNotFound;
+    NSArray* volumes = [camera volumes];
+
+    for (NSUInteger i = 0; i < [volumes count]; i++){
+
+        if ([[[volumes objectAtIndex:i] info:nil] available] > 0){
+
+            volumeIndex = i;
+            break;
+
+        }
+
+    }
+
+    EOSDeviceRecord* record = [[EOSDeviceRecord alloc] initWithSerialNumber:serialNumber cameraDescription:[camera cameraDescription] port:[camera port] lastSeenDate:[NSDate date] volumeIndex:volumeIndex settingsData:settingsData];
+
+    dispatch_async(_queue, ^(void){
+
+        [self loadOnQueue];
+        [_records setObject:record forKey:serialNumber];
+        [self saveOnQueue:nil];
+
+    });
+
+    dispatch_async(dispatch_get_main_queue(), ^(void){
+        [[NSNotificationCenter defaultCenter] postNotificationName:EOSDeviceRegistryDidRefreshCameraNotification object:camera userInfo:@{EOSDeviceRecordKey: record}];
+    });
+
+    return record;
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,189 @@
+//
+//  EOSDirectTransfer.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSFile;
+@class EOSDirectTransfer;
+
+/*!
+ The EOSTransferMetrics class describes the throughput of a batch of transfers.
+ */
+@interface EOSTransferMetrics : NSObject
+
+/*!
+ @brief The number of files that were transferred.
+ */
+@property (readonly) NSUInteger fileCount;
+
+/*!
+ @brief The number of files that could not be transferred, or were cancelled by the camera.
+ */
+@property (readonly) NSUInteger failedCount;
+
+/*!
+ @brief The number of bytes that were transferred.
+ */
+@property (readonly) UInt64 byteCount;
+
+/*!
+ @brief The time from the camera's first request to the last file being written, in seconds.
+ */
+@property (readonly) NSTimeInterval duration;
+
+/*!
+ @brief The time spent transferring files over the camera's link, in seconds.
+ @discussion This includes the time taken to write the files that are streamed to disk.
+ */
+@property (readonly) NSTimeInterval linkDuration;
+
+/*!
+ @brief The number of bytes transferred per second of duration.
+ */
+@property (readonly) double bytesPerSecond;
+
+/*!
+ @brief The fraction of the duration for which the camera's link was busy, between 0 and 1.
+ @discussion A value close to 1 means that the batch ran at the speed of the link, and was not held up by the disk or the delegate.
+ */
+@property (readonly) double linkUtilization;
+
+/*!
+ @brief Returns a dictionary representation of the metrics, suitable for NSJSONSerialization.
+ */
+-(NSDictionary<NSString*, NSNumber*>*)dictionaryRepresentation;
+
+@end
+
+
+
+/*!
+ The EOSDirectTransferDelegate protocol receives the files sent by a camera in direct transfer mode.
+ @discussion The methods are called on a serial queue belonging to the transfer, not on the main thread.
+ */
+@protocol EOSDirectTransferDelegate <NSObject>
+
+@optional
+
+/*!
+ @brief Called when a file has been written to the transfer's directory.
+ @param transfer The transfer.
+ @param file The file on the camera.
+ @param url The location of the file.
+ */
+-(void)directTransfer:(EOSDirectTransfer*)transfer didTransferFile:(EOSFile*)file toURL:(NSURL*)url;
+
+/*!
+ @brief Called when a file could not be transferred, or the camera cancelled it.
+ @param transfer The transfer.
+ @param file The file on the camera.
+ @param error An instance of NSError describing the problem.
+ */
+-(void)directTransfer:(EOSDirectTransfer*)transfer didFailToTransferFile:(EOSFile*)file error:(NSError*)error;
+
+/*!
+ @brief Called when every file in a batch has been written or has failed, and the camera has made no further requests for batchTimeout seconds.
+ @param transfer The transfer.
+ @param metrics The throughput of the batch.
+ */
+-(void)directTransfer:(EOSDirectTransfer*)transfer didFinishBatchWithMetrics:(EOSTransferMetrics*)metrics;
+
+@end
+
+
+
+/*!
+ The EOSDirectTransfer class receives the files that the operator sends from the camera in direct transfer mode.
+ @discussion While the transfer is running, the camera is in direct transfer mode, and the operator chooses the images to send from the camera's menu. Each image that the camera asks to send is collected and transferred in the order that it was requested. Transfers and disk writes are pipelined: while one file is written to disk, the next is already being transferred into memory, so the camera's link is kept busy. Up to maxPendingWrites files may wait in memory for the disk, after which transfers wait, rather than letting the host's memory grow. Files larger than 32MB, such as movies, are streamed straight to disk instead of waiting in memory.
+
+ Requests that arrive close together form a batch, which ends once every file in it has been written and the camera has been quiet for batchTimeout seconds. The throughput of each batch is passed to the delegate.
+
+ The camera must have an open session.
+ */
+@interface EOSDirectTransfer : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Initializes a transfer.
+ @param camera The camera.
+ @param directoryURL The directory to write the files to. It is created if it doesn't exist.
+ @return The initialized EOSDirectTransfer.
+ */
+-(id)initWithCamera:(EOSCamera*)camera directoryURL:(NSURL*)directoryURL;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The camera.
+ */
+@property (readonly, weak) EOSCamera* camera;
+
+/*!
+ @brief The directory that files are written to.
+ */
+@property (readonly) NSURL* directoryURL;
+
+/*!
+ @brief The delegate.
+ */
+@property (weak, nullable) id<EOSDirectTransferDelegate> delegate;
+
+/*!
+ @brief The number of transferred files that may wait in memory to be written. The default value is 4.
+ @discussion Changes take effect when the transfer is started. Files larger than 32MB are streamed to disk, so they don't count towards this.
+ */
+@property NSUInteger maxPendingWrites;
+
+/*!
+ @brief The time after the last file of a batch is written with no further requests from the camera, after which the batch is finished, in seconds. The default value is 2.
+ */
+@property NSTimeInterval batchTimeout;
+
+/*!
+ @brief Indicates whether the transfer is running.
+ */
+@property (readonly) BOOL isRunning;
+
+/*!
+ @brief The number of files that the camera has asked to send and that have not yet been written or failed.
+ */
+@property (readonly) NSUInteger pendingCount;
+
+
+
+///--------------
+/// @name Running
+///--------------
+
+/*!
+ @brief Puts the camera in direct transfer mode, and starts receiving its files.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)start:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Stops receiving files, and takes the camera out of direct transfer mode once the files that it has already asked to send have been written.
+ @discussion A batch that is in progress is finished first, and its metrics are passed to the delegate.
+ @param completion A block that is called on the main thread once the camera has left direct transfer mode, with an error if it could not.
+ */
+-(void)stopWithCompletion:(nullable void (^)(NSError* _Nullable error))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
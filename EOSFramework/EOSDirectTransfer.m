@@ -0,0 +1,496 @@
+//
+//  EOSDirectTransfer.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSDirectTransfer.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSFile.h>
+#import <EOSFramework/EOSError.h>
+#import "EOSPrivate.h"
+
+#define EOSDirectTransferDefaultMaxPendingWrites    4
+#define EOSDirectTransferDefaultBatchTimeout        2.0
+
+//larger files are streamed to disk rather than waiting in memory, which bounds the memory used by pending writes
+#define EOSDirectTransferMaxBufferedSize            (32 * 1024 * 1024)
+
+@interface EOSTransferMetrics ()
+
+@property NSUInteger fileCount;
+@property NSUInteger failedCount;
+@property UInt64 byteCount;
+@property NSTimeInterval duration;
+@property NSTimeInterval linkDuration;
+
+@end
+
+@implementation EOSTransferMetrics
+
+-(double)bytesPerSecond{
+
+    return _duration > 0 ? _byteCount / _duration : 0;
+
+}
+
+-(double)linkUtilization{
+
+    return _duration > 0 ? MIN(_linkDuration / _duration, 1.0) : 0;
+
+}
+
+-(NSDictionary*)dictionaryRepresentation{
+
+    return @{@"files": @(_fileCount),
+             @"failed": @(_failedCount),
+             @"bytes": @(_byteCount),
+             @"duration": @(_duration),
+             @"linkDuration": @(_linkDuration),
+             @"bytesPerSecond": @([self bytesPerSecond]),
+             @"linkUtilization": @([self linkUtilization])};
+
+}
+
+@end
+
+
+
+
+@implementation EOSDirectTransfer{
+
+    //one transfer at a time, as they share the camera's link, while the disk writes run alongside
+    dispatch_queue_t _transferQueue;
+    dispatch_queue_t _writeQueue;
+    dispatch_queue_t _deliveryQueue;
+
+    //counts the transferred files that may wait for the disk
+    dispatch_semaphore_t _writeSemaphore;
+    dispatch_group_t _group;
+
+    NSHashTable* _cancelledFiles;
+
+    BOOL _isRunning;
+    NSUInteger _pendingCount;
+    NSUInteger _queuedCount;
+
+    //the batch in progress, which has started if its start time isn't 0
+    NSUInteger _batchGeneration;
+    NSTimeInterval _batchStartTime;
+    NSTimeInterval _batchEndTime;
+    EOSTransferMetrics* _batchMetrics;
+
+}
+
+-(id)initWithCamera:(EOSCamera *)camera directoryURL:(NSURL *)directoryURL{
+
+    self = [super init];
+    if (self){
+
+        _camera = camera;
+        _directoryURL = [directoryURL copy];
+        _maxPendingWrites = EOSDirectTransferDefaultMaxPendingWrites;
+        _batchTimeout = EOSDirectTransferDefaultBatchTimeout;
+        _transferQueue = dispatch_queue_create("com.EOSFramework.directtransfer.transfer", DISPATCH_QUEUE_SERIAL);
+        _writeQueue = dispatch_queue_create("com.EOSFramework.directtransfer.write", DISPATCH_QUEUE_CONCURRENT);
+        _deliveryQueue = dispatch_queue_create("com.EOSFramework.directtransfer.delivery", DISPATCH_QUEUE_SERIAL);
+        _group = dispatch_group_create();
+        _cancelledFiles = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        _batchMetrics = [[EOSTransferMetrics alloc] init];
+
+    }
+
+    return self;
+
+}
+
+-(BOOL)isRunning{
+
+    @synchronized(self){
+        return _isRunning;
+    }
+
+}
+
+-(NSUInteger)pendingCount{
+
+    @synchronized(self){
+        return _pendingCount;
+    }
+
+}
+
+
+
+
+#pragma mark - Running
+
+-(BOOL)start:(NSError *__autoreleasing *)error{
+
+    EOSCamera* camera = _camera;
+
+    @synchronized(self){
+
+        if (_isRunning)
+            return YES;
+
+    }
+
+    if (![[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:error])
+        return NO;
+
+    //the handler is installed first, so no request is missed
+    __weak EOSDirectTransfer* weakSelf = self;
+
+    [camera setDirectTransferHandler:^(EOSFile* file, BOOL cancelled){
+        [weakSelf enqueueFile:file cancelled:cancelled];
+    }];
+
+    if (![camera sendCommand:EOSCommand_EnterDirectTransfer error:error]){
+
+        [camera setDirectTransferHandler:nil];
+        return NO;
+
+    }
+
+    @synchronized(self){
+
+        _isRunning = YES;
+        _writeSemaphore = dispatch_semaphore_create(MAX([self maxPendingWrites], 1));
+
+    }
+
+    return YES;
+
+}
+
+-(void)stopWithCompletion:(void (^)(NSError *))completion{
+
+    EOSCamera* camera = _camera;
+
+    @synchronized(self){
+
+        if (!_isRunning){
+
+            if (completion){
+
+                dispatch_async(dispatch_get_main_queue(), ^(void){
+                    completion(nil);
+                });
+
+            }
+
+            return;
+
+        }
+
+        _isRunning = NO;
+
+    }
+
+    [camera setDirectTransferHandler:nil];
+
+    //the camera leaves the mode once the files that it has already sent are written
+    dispatch_group_notify(_group, _deliveryQueue, ^(void){
+
+        [self finishBatchOfGeneration:NSNotFound];
+
+        NSError* error;
+        [camera sendCommand:EOSCommand_ExitDirectTransfer error:&error];
+
+        if (completion){
+
+            dispatch_async(dispatch_get_main_queue(), ^(void){
+                completion(error);
+            });
+
+        }
+
+    });
+
+}
+
+
+
+
+#pragma mark - Transferring
+
+//called on the thread that delivers the camera's events, so it mustn't wait
+-(void)enqueueFile:(EOSFile*)file cancelled:(BOOL)cancelled{
+
+    NSUInteger queuedCount;
+
+    @synchronized(self){
+
+        //a file that is still queued is skipped; one that is being transferred completes anyway
+        if (cancelled){
+
+            [_cancelledFiles addObject:file];
+            return;
+
+        }
+
+        if (!_isRunning)
+            return;
+
+        _pendingCount++;
+        _batchGeneration++;
+        queuedCount = ++_queuedCount;
+
+        if (_batchStartTime == 0)
+            _batchStartTime = [NSDate timeIntervalSinceReferenceDate];
+
+    }
+
+    if (EOSFRAMEWORK_QUEUE_ENQUEUE_ENABLED())
+        EOSFRAMEWORK_QUEUE_ENQUEUE("directtransfer", EOSProbeSerialNumber(file), queuedCount);
+
+    dispatch_group_enter(_group);
+
+    dispatch_async(_transferQueue, ^(void){
+        [self transferFile:file];
+    });
+
+}
+
+-(void)transferFile:(EOSFile*)file{
+
+    dispatch_semaphore_t writeSemaphore;
+    NSUInteger queuedCount;
+    BOOL cancelled;
+
+    @synchronized(self){
+
+        writeSemaphore = _writeSemaphore;
+        queuedCount = --_queuedCount;
+        cancelled = [_cancelledFiles containsObject:file];
+        [_cancelledFiles removeObject:file];
+
+    }
+
+    if (EOSFRAMEWORK_QUEUE_DEQUEUE_ENABLED())
+        EOSFRAMEWORK_QUEUE_DEQUEUE("directtransfer", EOSProbeSerialNumber(file), queuedCount);
+
+    if (cancelled){
+
+        [self failToTransferFile:file error:EOSCreateError(EOSError_OperationCancelled)];
+        return;
+
+    }
+
+    NSError* error;
+    EOSFileInfo* info = [file info:&error];
+
+    if (info == nil){
+
+        [file cancelTransfer:nil];
+        [self failToTransferFile:file error:error];
+        return;
+
+    }
+
+    NSString* name = [info name];
+    uint64_t startTime;
+
+    if ([info size] > EOSDirectTransferMaxBufferedSize){
+
+        //the camera's link writes straight to disk, so the file never waits in memory
+        NSURL* url = [self reserveURLForName:name error:&error];
+        startTime = mach_absolute_time();
+
+        if (url == nil || ![file downloadToURL:url overwrite:YES error:&error]){
+
+            //the camera holds the file until the transfer is completed or cancelled
+            [file cancelTransfer:nil];
+            [self failToTransferFile:file error:error];
+            return;
+
+        }
+
+        [self addLinkDuration:EOSProbeNanosecondsSince(startTime)];
+        [self deliverFile:file toURL:url length:(NSUInteger)[info size]];
+        return;
+
+    }
+
+    //wait for the disk to catch up
+    dispatch_semaphore_wait(writeSemaphore, DISPATCH_TIME_FOREVER);
+
+    NSMutableData* buffer = [NSMutableData dataWithLength:[info size]];
+    NSUInteger length = 0;
+    startTime = mach_absolute_time();
+
+    if (![file downloadIntoBytes:[buffer mutableBytes] capacity:[buffer length] length:&length error:&error]){
+
+        dispatch_semaphore_signal(writeSemaphore);
+
+        [file cancelTransfer:nil];
+        [self failToTransferFile:file error:error];
+        return;
+
+    }
+
+    [self addLinkDuration:EOSProbeNanosecondsSince(startTime)];
+    [buffer setLength:length];
+
+    dispatch_async(_writeQueue, ^(void){
+
+        NSError* writeError;
+        NSURL* url = [self reserveURLForName:name error:&writeError];
+
+        BOOL written = url != nil && [buffer writeToURL:url options:0 error:&writeError];
+
+        dispatch_semaphore_signal(writeSemaphore);
+
+        if (!written){
+
+            if (url != nil)
+                [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+
+            [self failToTransferFile:file error:writeError];
+            return;
+
+        }
+
+        [self deliverFile:file toURL:url length:length];
+
+    });
+
+}
+
+-(void)addLinkDuration:(uint64_t)nanoseconds{
+
+    @synchronized(self){
+        [_batchMetrics setLinkDuration:[_batchMetrics linkDuration] + (double)nanoseconds / NSEC_PER_SEC];
+    }
+
+}
+
+-(void)deliverFile:(EOSFile*)file toURL:(NSURL*)url length:(NSUInteger)length{
+
+    dispatch_async(_deliveryQueue, ^(void){
+
+        id<EOSDirectTransferDelegate> delegate = [self delegate];
+
+        if ([delegate respondsToSelector:@selector(directTransfer:didTransferFile:toURL:)])
+            [delegate directTransfer:self didTransferFile:file toURL:url];
+
+        @synchronized(self){
+
+            [_batchMetrics setFileCount:[_batchMetrics fileCount] + 1];
+            [_batchMetrics setByteCount:[_batchMetrics byteCount] + length];
+
+        }
+
+        [self didFinishFile];
+
+    });
+
+}
+
+//writes run concurrently, so a name is claimed by creating the file before it is written
+-(NSURL*)reserveURLForName:(NSString*)name error:(NSError* __autoreleasing*)error{
+
+    @synchronized(self){
+
+        NSURL* url = [_directoryURL URLByAppendingPathComponent:name];
+
+        //the camera's file numbers wrap around, and the operator may send a file more than once
+        for (NSUInteger i = 1; [[NSFileManager defaultManager] fileExistsAtPath:[url path]]; i++){
+
+            NSString* uniqueName = [NSString stringWithFormat:@"%@-%lu.%@", [name stringByDeletingPathExtension], (unsigned long)i, [name pathExtension]];
+            url = [_directoryURL URLByAppendingPathComponent:uniqueName];
+
+        }
+
+        if (![[NSFileManager defaultManager] createFileAtPath:[url path] contents:nil attributes:nil]){
+
+            if (error)
+                *error = EOSCreateError(EOSError_File_OpenError);
+            return nil;
+
+        }
+
+        return url;
+
+    }
+
+}
+
+-(void)failToTransferFile:(EOSFile*)file error:(NSError*)error{
+
+    dispatch_async(_deliveryQueue, ^(void){
+
+        id<EOSDirectTransferDelegate> delegate = [self delegate];
+
+        if ([delegate respondsToSelector:@selector(directTransfer:didFailToTransferFile:error:)])
+            [delegate directTransfer:self didFailToTransferFile:file error:error ?: EOSCreateError(EOSError_InternalError)];
+
+        @synchronized(self){
+            [_batchMetrics setFailedCount:[_batchMetrics failedCount] + 1];
+        }
+
+        [self didFinishFile];
+
+    });
+
+}
+
+//called on the delivery queue
+-(void)didFinishFile{
+
+    NSUInteger generation;
+    BOOL isIdle;
+
+    @synchronized(self){
+
+        _pendingCount--;
+        _batchEndTime = [NSDate timeIntervalSinceReferenceDate];
+        generation = _batchGeneration;
+        isIdle = _pendingCount == 0;
+
+    }
+
+    //the batch is finished if the camera stays quiet
+    if (isIdle){
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)([self batchTimeout] * NSEC_PER_SEC)), _deliveryQueue, ^(void){
+            [self finishBatchOfGeneration:generation];
+        });
+
+    }
+
+    dispatch_group_leave(_group);
+
+}
+
+//called on the delivery queue; NSNotFound finishes whatever batch is in progress
+-(void)finishBatchOfGeneration:(NSUInteger)generation{
+
+    EOSTransferMetrics* metrics;
+
+    @synchronized(self){
+
+        if (_batchStartTime == 0 || _pendingCount > 0 || (generation != NSNotFound && generation != _batchGeneration))
+            return;
+
+        metrics = _batchMetrics;
+        [metrics setDuration:_batchEndTime - _batchStartTime];
+
+        _batchStartTime = 0;
+        _batchMetrics = [[EOSTransferMetrics alloc] init];
+
+    }
+
+    EOSLog(EOSLogLevel_Info, "directtransfer", _camera, (uint64_t)([metrics duration] * NSEC_PER_SEC), "%lu files, %llu bytes, %.0f bytes/s, link %.0f%% busy", (unsigned long)[metrics fileCount], (unsigned long long)[metrics byteCount], [metrics bytesPerSecond], [metrics linkUtilization] * 100);
+
+    id<EOSDirectTransferDelegate> delegate = [self delegate];
+
+    if ([delegate respondsToSelector:@selector(directTransfer:didFinishBatchWithMetrics:)])
+        [delegate directTransfer:self didFinishBatchWithMetrics:metrics];
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,219 @@
+//
+//  EOSDownloadJournal.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSFile;
+@class EOSFileInfo;
+
+/*!
+ @brief States of a journal entry.
+ */
+typedef NS_ENUM(NSUInteger, EOSJournalEntryState){
+
+    /** The download was started but has not completed. */
+    EOSJournalEntryState_InProgress,
+
+    /** The download completed successfully. */
+    EOSJournalEntryState_Completed,
+
+    /** The download completed successfully and the file was then removed from the camera. */
+    EOSJournalEntryState_Deleted,
+
+    /** The download did not complete, and any partial file has been removed. */
+    EOSJournalEntryState_Aborted
+
+};
+
+
+/*!
+ The EOSJournalEntry class describes the last recorded state of a single download. Instances of this class are created by EOSDownloadJournal.
+ */
+@interface EOSJournalEntry : NSObject
+
+/*!
+ @brief The identifier of the file, as returned by [EOSDownloadJournal identifierForFile:info:].
+ */
+@property (readonly) NSString* identifier;
+
+/*!
+ @brief The state of the download.
+ */
+@property (readonly) EOSJournalEntryState state;
+
+/*!
+ @brief The location that the file is downloaded to.
+ @discussion This is nil if the file was removed from the camera without being downloaded through the journal.
+ */
+@property (readonly, nullable) NSURL* destinationURL;
+
+/*!
+ @brief The size of the file, in bytes.
+ */
+@property (readonly) UInt64 size;
+
+/*!
+ @brief The SHA-256 checksum of the downloaded file.
+ @discussion This is nil unless the download has completed.
+ */
+@property (readonly, nullable) NSData* checksum;
+
+@end
+
+
+
+/*!
+ The EOSDownloadJournal class records the progress of file downloads in an append-only file, so that an interrupted ingest can be resumed.
+ @discussion The journal records the intent to download a file before the download starts, and the completion (along with the file's checksum) once the download has finished. Each record is written with a checksum and flushed to disk before the download continues, so a record that was torn by a crash is detected and discarded. When a journal is opened, it is replayed; any download that was in progress is marked as aborted and its partial file is removed, so only the in-flight work of the previous process needs to be repeated. The journal is compacted periodically, rewriting each download as a single record and dropping aborted downloads, so replaying it costs one record per file rather than one per change.
+
+ To use a journal with downloads, pass it in the options dictionary of [EOSFile downloadWithOptions:delegate:contextInfo:] with the EOSDownloadJournalKey key.
+ */
+@interface EOSDownloadJournal : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Opens the journal at a URL, creating it if necessary.
+ @discussion The journal is replayed before this method returns. Downloads that were in progress when the journal was last closed are marked as aborted, their partial files are removed and they are made available in the recoveredEntries property.
+ @param url The URL of the journal file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSDownloadJournal, or nil if the journal could not be opened.
+ */
+-(nullable id)initWithURL:(NSURL*)url error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Returns the identifier used by the journal to identify a file.
+ @discussion The identifier is made up of the serial number of the file's camera, and the file's name, group ID and size.
+ @param file The file.
+ @param info The information of the file, as returned by [EOSFile info:].
+ @return The identifier.
+ */
++(NSString*)identifierForFile:(EOSFile*)file info:(EOSFileInfo*)info;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The URL of the journal file.
+ */
+@property (readonly) NSURL* URL;
+
+/*!
+ @brief The entries of downloads that were interrupted before the journal was opened.
+ @discussion These files need to be downloaded again.
+ */
+@property (readonly) NSArray<EOSJournalEntry*>* recoveredEntries;
+
+/*!
+ @brief The number of records that may be appended before the journal is compacted.
+ @discussion The default value is 4096.
+ */
+@property NSUInteger compactionThreshold;
+
+
+
+///-----------------------
+/// @name Querying Entries
+///-----------------------
+
+/*!
+ @brief Gets the entry with an identifier.
+ @param identifier The identifier of the file.
+ @return The entry, or nil if the journal has no record of the file.
+ */
+-(nullable EOSJournalEntry*)entryForIdentifier:(NSString*)identifier;
+
+/*!
+ @brief Filters a list of files, removing any that have already been downloaded.
+ @discussion Use this method after a restart to resume an ingest. Files whose info cannot be retrieved are kept.
+ @param files An array of EOSFile objects.
+ @return An array containing the files which have not been downloaded.
+ */
+-(NSArray<EOSFile*>*)filesNeedingDownload:(NSArray<EOSFile*>*)files;
+
+
+
+///------------------------
+/// @name Recording Records
+///------------------------
+
+/*!
+ @brief Records the intent to download a file.
+ @param identifier The identifier of the file.
+ @param destinationURL The location that the file will be downloaded to.
+ @param size The size of the file, in bytes.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if the record was written to disk, otherwise NO.
+ */
+-(BOOL)recordIntentForIdentifier:(NSString*)identifier destinationURL:(NSURL*)destinationURL size:(UInt64)size error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Records the completion of a download.
+ @param identifier The identifier of the file.
+ @param checksum The SHA-256 checksum of the downloaded file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if the record was written to disk, otherwise NO.
+ */
+-(BOOL)recordCompletionForIdentifier:(NSString*)identifier checksum:(NSData*)checksum error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Records that a download did not complete.
+ @discussion The partial file at the entry's destination URL is removed.
+ @param identifier The identifier of the file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if the record was written to disk, otherwise NO.
+ */
+-(BOOL)recordAbortForIdentifier:(NSString*)identifier error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Records that a downloaded file was removed from the camera.
+ @discussion The deletion is recorded even if the journal has no entry for the file.
+ @param identifier The identifier of the file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if the record was written to disk, otherwise NO.
+ */
+-(BOOL)recordDeletionForIdentifier:(NSString*)identifier error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Removes a file from the camera and records the deletion.
+ @param file The file to remove.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)removeFile:(EOSFile*)file error:(NSError* __autoreleasing*)error;
+
+
+
+///-------------------------
+/// @name Managing the File
+///-------------------------
+
+/*!
+ @brief Rewrites the journal so that it only contains the records that are still needed.
+ @discussion This method is called automatically once compactionThreshold records have been appended. Each download that is in progress, completed or deleted is kept as a single record; aborted downloads are dropped.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)compact:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Closes the journal file.
+ @discussion Any further records will fail to be written.
+ */
+-(void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,813 @@
+//
+//  EOSDownloadJournal.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSDownloadJournal.h>
+#import <EOSFramework/EOSFile.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSError.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ Journal format (all integers are little endian)
+
+ header:    "EOSJ" uint32 version
+ record:    uint32 length, uint32 crc32 of body, body[length]
+ body:      uint8 type, uint16 identifier length, identifier (UTF-8), type specific fields
+
+ intent:     uint64 size, uint16 path length, path (UTF-8)
+ completion: uint8 checksum length, checksum
+ abort:      -
+ deletion:   -
+ snapshot:   uint8 state, uint64 size, uint16 path length, path (UTF-8), uint8 checksum length, checksum
+
+ snapshots are only written by compaction, to carry forward downloads that have completed or been deleted
+ */
+
+#define EOSJournalMagic "EOSJ"
+#define EOSJournalVersion 2
+#define EOSJournalHeaderSize 8
+
+typedef NS_ENUM(uint8_t, EOSJournalRecordType){
+    EOSJournalRecordType_Intent       = 1,
+    EOSJournalRecordType_Completion   = 2,
+    EOSJournalRecordType_Abort        = 3,
+    EOSJournalRecordType_Deletion     = 4,
+    EOSJournalRecordType_Snapshot     = 5
+};
+
+static uint32_t EOSJournalCRC32(const uint8_t* bytes, NSUInteger length){
+
+    static uint32_t table[256];
+    static dispatch_once_t pred = 0;
+    dispatch_once(&pred, ^{
+        for (uint32_t i=0; i<256; i++){
+            uint32_t c = i;
+            for (int k=0; k<8; k++)
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+    });
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (NSUInteger i=0; i<length; i++)
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFF;
+
+}
+
+static uint32_t EOSJournalReadUInt32(const uint8_t* bytes){
+
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+
+}
+
+static void EOSJournalAppendString(NSMutableData* data, NSString* string){
+
+    NSData* utf8 = [string dataUsingEncoding:NSUTF8StringEncoding];
+    uint16_t length = CFSwapInt16HostToLittle((uint16_t)[utf8 length]);
+    [data appendBytes:&length length:sizeof(length)];
+    [data appendData:utf8];
+
+}
+
+static NSString* EOSJournalReadString(const uint8_t* bytes, NSUInteger length, NSUInteger* offset){
+
+    if (*offset + 2 > length)
+        return nil;
+
+    uint16_t stringLength;
+    memcpy(&stringLength, bytes + *offset, sizeof(stringLength));
+    stringLength = CFSwapInt16LittleToHost(stringLength);
+    *offset += 2;
+
+    if (*offset + stringLength > length)
+        return nil;
+
+    NSString* string = [[NSString alloc] initWithBytes:bytes + *offset length:stringLength encoding:NSUTF8StringEncoding];
+    *offset += stringLength;
+
+    return string;
+
+}
+
+
+
+
+@interface EOSJournalEntry ()
+
+@property NSString* identifier;
+@property EOSJournalEntryState state;
+@property NSURL* destinationURL;
+@property UInt64 size;
+@property (nullable) NSData* checksum;
+
+@end
+
+@implementation EOSJournalEntry
+
+@end
+
+
+
+
+@implementation EOSDownloadJournal{
+
+    int _fd;
+    dispatch_queue_t _queue;
+    NSMutableDictionary* _entries;
+    NSUInteger _appendedRecords;
+
+}
+
++(NSString*)identifierForFile:(EOSFile *)file info:(EOSFileInfo *)info{
+
+    NSString* serialNumber = [[file camera] serialNumber];
+
+    return [NSString stringWithFormat:@"%@/%@/%lu/%lu", serialNumber != nil ? serialNumber : @"", [info name], (unsigned long)[info groupID], (unsigned long)[info size]];
+
+}
+
+-(id)initWithURL:(NSURL *)url error:(NSError *__autoreleasing *)error{
+
+    self = [super init];
+    if (self){
+
+        _URL = url;
+        _fd = -1;
+        _compactionThreshold = 4096;
+        _appendedRecords = 0;
+        _entries = [NSMutableDictionary dictionary];
+        _queue = dispatch_queue_create("com.EOSFramework.journal", DISPATCH_QUEUE_SERIAL);
+
+        if (![self replay:error])
+            return nil;
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    if (_fd >= 0)
+        close(_fd);
+
+}
+
+
+
+
+#pragma mark - Replay
+
+-(BOOL)replay:(NSError* __autoreleasing*)error{
+
+    NSFileManager* fileManager = [NSFileManager defaultManager];
+    const char* path = [[_URL path] fileSystemRepresentation];
+
+    _fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+
+    if (_fd < 0){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_OpenError);
+        return NO;
+
+    }
+
+    NSData* data = [NSData dataWithContentsOfURL:_URL options:NSDataReadingMappedIfSafe error:nil];
+    const uint8_t* bytes = [data bytes];
+    NSUInteger length = [data length];
+    NSUInteger offset = 0;
+
+    if (length < EOSJournalHeaderSize){
+
+        //new (or torn) journal, write the header
+        ftruncate(_fd, 0);
+
+        uint8_t header[EOSJournalHeaderSize];
+        uint32_t version = CFSwapInt32HostToLittle(EOSJournalVersion);
+        memcpy(header, EOSJournalMagic, 4);
+        memcpy(header + 4, &version, 4);
+
+        if (write(_fd, header, EOSJournalHeaderSize) != EOSJournalHeaderSize || fsync(_fd) != 0){
+
+            if (error)
+                *error = EOSCreateError(EOSError_File_WriteError);
+            return NO;
+
+        }
+
+        length = 0;
+
+    }else{
+
+        //version 1 journals have no snapshots, and are otherwise the same
+        uint32_t version = EOSJournalReadUInt32(bytes + 4);
+
+        if (memcmp(bytes, EOSJournalMagic, 4) != 0 || version < 1 || version > EOSJournalVersion){
+
+            if (error)
+                *error = EOSCreateError(EOSError_File_FormatUnrecognized);
+            return NO;
+
+        }
+
+        offset = EOSJournalHeaderSize;
+
+    }
+
+
+    //apply each complete record
+    while (offset + 8 <= length){
+
+        uint32_t recordLength = EOSJournalReadUInt32(bytes + offset);
+        uint32_t crc = EOSJournalReadUInt32(bytes + offset + 4);
+
+        if (offset + 8 + recordLength > length || EOSJournalCRC32(bytes + offset + 8, recordLength) != crc)
+            break;
+
+        [self applyRecord:bytes + offset + 8 length:recordLength];
+        offset += 8 + recordLength;
+
+    }
+
+    //discard a record that was torn by a crash
+    if (length > 0 && offset < length)
+        ftruncate(_fd, offset);
+
+    data = nil;
+
+
+    //abort downloads that were in progress
+    NSMutableArray* recoveredEntries = [NSMutableArray array];
+
+    for (EOSJournalEntry* entry in [_entries allValues]){
+
+        if ([entry state] == EOSJournalEntryState_InProgress){
+
+            [fileManager removeItemAtURL:[entry destinationURL] error:nil];
+            [recoveredEntries addObject:entry];
+
+        }
+
+    }
+
+    _recoveredEntries = [NSArray arrayWithArray:recoveredEntries];
+
+    for (EOSJournalEntry* entry in _recoveredEntries){
+
+        if (![self recordAbortForIdentifier:[entry identifier] error:error])
+            return NO;
+
+    }
+
+    return YES;
+
+}
+
+-(void)applyRecord:(const uint8_t*)bytes length:(NSUInteger)length{
+
+    NSUInteger offset = 1;
+
+    if (length < 1)
+        return;
+
+    EOSJournalRecordType type = bytes[0];
+    NSString* identifier = EOSJournalReadString(bytes, length, &offset);
+
+    if (identifier == nil)
+        return;
+
+    EOSJournalEntry* entry = [_entries objectForKey:identifier];
+
+    switch (type){
+
+        case EOSJournalRecordType_Intent:{
+
+            if (offset + 8 > length)
+                return;
+
+            uint64_t size;
+            memcpy(&size, bytes + offset, sizeof(size));
+            size = CFSwapInt64LittleToHost(size);
+            offset += 8;
+
+            NSString* path = EOSJournalReadString(bytes, length, &offset);
+            if (path == nil)
+                return;
+
+            entry = [[EOSJournalEntry alloc] init];
+            [entry setIdentifier:identifier];
+            [entry setDestinationURL:[NSURL fileURLWithPath:path]];
+            [entry setSize:size];
+            [entry setState:EOSJournalEntryState_InProgress];
+            [_entries setObject:entry forKey:identifier];
+
+            break;
+
+        }
+
+        case EOSJournalRecordType_Completion:{
+
+            if (entry == nil || offset + 1 > length || offset + 1 + bytes[offset] > length)
+                return;
+
+            [entry setChecksum:[NSData dataWithBytes:bytes + offset + 1 length:bytes[offset]]];
+            [entry setState:EOSJournalEntryState_Completed];
+
+            break;
+
+        }
+
+        case EOSJournalRecordType_Abort:
+            [entry setState:EOSJournalEntryState_Aborted];
+            break;
+
+        case EOSJournalRecordType_Deletion:
+
+            //a file may be removed without having been downloaded through the journal
+            if (entry == nil){
+
+                entry = [[EOSJournalEntry alloc] init];
+                [entry setIdentifier:identifier];
+                [_entries setObject:entry forKey:identifier];
+
+            }
+
+            [entry setState:EOSJournalEntryState_Deleted];
+            break;
+
+        case EOSJournalRecordType_Snapshot:{
+
+            if (offset + 9 > length)
+                return;
+
+            EOSJournalEntryState state = bytes[offset];
+            uint64_t size;
+            memcpy(&size, bytes + offset + 1, sizeof(size));
+            size = CFSwapInt64LittleToHost(size);
+            offset += 9;
+
+            NSString* path = EOSJournalReadString(bytes, length, &offset);
+            if (path == nil || offset + 1 > length || offset + 1 + bytes[offset] > length)
+                return;
+
+            if (state != EOSJournalEntryState_Completed && state != EOSJournalEntryState_Deleted)
+                return;
+
+            entry = [[EOSJournalEntry alloc] init];
+            [entry setIdentifier:identifier];
+            [entry setDestinationURL:[path length] > 0 ? [NSURL fileURLWithPath:path] : nil];
+            [entry setSize:size];
+            [entry setState:state];
+            [entry setChecksum:bytes[offset] > 0 ? [NSData dataWithBytes:bytes + offset + 1 length:bytes[offset]] : nil];
+            [_entries setObject:entry forKey:identifier];
+
+            break;
+
+        }
+
+    }
+
+}
+
+
+
+
+#pragma mark - Writing
+
+-(NSData*)frameForRecord:(NSData*)body{
+
+    NSMutableData* frame = [NSMutableData dataWithCapacity:[body length] + 8];
+
+    uint32_t length = CFSwapInt32HostToLittle((uint32_t)[body length]);
+    uint32_t crc = CFSwapInt32HostToLittle(EOSJournalCRC32([body bytes], [body length]));
+
+    [frame appendBytes:&length length:4];
+    [frame appendBytes:&crc length:4];
+    [frame appendData:body];
+
+    return frame;
+
+}
+
+-(NSData*)intentRecordForEntry:(EOSJournalEntry*)entry{
+
+    NSMutableData* body = [NSMutableData data];
+
+    uint8_t type = EOSJournalRecordType_Intent;
+    uint64_t size = CFSwapInt64HostToLittle([entry size]);
+
+    [body appendBytes:&type length:1];
+    EOSJournalAppendString(body, [entry identifier]);
+    [body appendBytes:&size length:8];
+    EOSJournalAppendString(body, [[entry destinationURL] path]);
+
+    return [self frameForRecord:body];
+
+}
+
+-(NSData*)completionRecordForEntry:(EOSJournalEntry*)entry{
+
+    NSMutableData* body = [NSMutableData data];
+
+    uint8_t type = EOSJournalRecordType_Completion;
+    uint8_t checksumLength = (uint8_t)[[entry checksum] length];
+
+    [body appendBytes:&type length:1];
+    EOSJournalAppendString(body, [entry identifier]);
+    [body appendBytes:&checksumLength length:1];
+    [body appendData:[entry checksum]];
+
+    return [self frameForRecord:body];
+
+}
+
+-(NSData*)snapshotRecordForEntry:(EOSJournalEntry*)entry{
+
+    NSMutableData* body = [NSMutableData data];
+
+    uint8_t type = EOSJournalRecordType_Snapshot;
+    uint8_t state = (uint8_t)[entry state];
+    uint64_t size = CFSwapInt64HostToLittle([entry size]);
+    uint8_t checksumLength = (uint8_t)[[entry checksum] length];
+
+    [body appendBytes:&type length:1];
+    EOSJournalAppendString(body, [entry identifier]);
+    [body appendBytes:&state length:1];
+    [body appendBytes:&size length:8];
+    EOSJournalAppendString(body, [entry destinationURL] != nil ? [[entry destinationURL] path] : @"");
+    [body appendBytes:&checksumLength length:1];
+
+    if ([entry checksum] != nil)
+        [body appendData:[entry checksum]];
+
+    return [self frameForRecord:body];
+
+}
+
+-(NSData*)stateRecordOfType:(EOSJournalRecordType)type forIdentifier:(NSString*)identifier{
+
+    NSMutableData* body = [NSMutableData data];
+
+    [body appendBytes:&type length:1];
+    EOSJournalAppendString(body, identifier);
+
+    return [self frameForRecord:body];
+
+}
+
+//must be called on _queue
+-(BOOL)appendFrame:(NSData*)frame error:(NSError* __autoreleasing*)error{
+
+    const uint8_t* bytes = [frame bytes];
+    NSUInteger remaining = [frame length];
+
+    while (remaining > 0){
+
+        ssize_t written = _fd >= 0 ? write(_fd, bytes, remaining) : -1;
+
+        if (written < 0){
+
+            if (errno == EINTR)
+                continue;
+
+            if (error)
+                *error = EOSCreateError(errno == ENOSPC ? EOSError_File_DiskFull : EOSError_File_WriteError);
+            return NO;
+
+        }
+
+        bytes += written;
+        remaining -= written;
+
+    }
+
+    if (fsync(_fd) != 0){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_WriteError);
+        return NO;
+
+    }
+
+    _appendedRecords++;
+
+    return YES;
+
+}
+
+//must be called on _queue, once the entries reflect the appended record, or the compacted journal would lose it
+-(void)compactIfNeededOnQueue{
+
+    if (_appendedRecords >= _compactionThreshold)
+        [self compactOnQueue:nil];
+
+}
+
+-(BOOL)recordIntentForIdentifier:(NSString *)identifier destinationURL:(NSURL *)destinationURL size:(UInt64)size error:(NSError *__autoreleasing *)error{
+
+    __block BOOL success;
+    __block NSError* blockError;
+
+    dispatch_sync(_queue, ^(void){
+
+        EOSJournalEntry* entry = [[EOSJournalEntry alloc] init];
+        [entry setIdentifier:identifier];
+        [entry setDestinationURL:destinationURL];
+        [entry setSize:size];
+        [entry setState:EOSJournalEntryState_InProgress];
+
+        success = [self appendFrame:[self intentRecordForEntry:entry] error:&blockError];
+
+        if (success){
+
+            [_entries setObject:entry forKey:identifier];
+            [self compactIfNeededOnQueue];
+
+        }
+
+    });
+
+    if (!success && error)
+        *error = blockError;
+
+    return success;
+
+}
+
+-(BOOL)recordCompletionForIdentifier:(NSString *)identifier checksum:(NSData *)checksum error:(NSError *__autoreleasing *)error{
+
+    __block BOOL success;
+    __block NSError* blockError;
+
+    dispatch_sync(_queue, ^(void){
+
+        EOSJournalEntry* entry = [_entries objectForKey:identifier];
+
+        if (entry == nil){
+
+            blockError = EOSCreateError(EOSError_InvalidParameter);
+            success = NO;
+            return;
+
+        }
+
+        [entry setChecksum:checksum];
+        success = [self appendFrame:[self completionRecordForEntry:entry] error:&blockError];
+
+        if (success){
+
+            [entry setState:EOSJournalEntryState_Completed];
+            [self compactIfNeededOnQueue];
+
+        }
+
+    });
+
+    if (!success && error)
+        *error = blockError;
+
+    return success;
+
+}
+
+-(BOOL)recordState:(EOSJournalEntryState)state ofType:(EOSJournalRecordType)type forIdentifier:(NSString*)identifier error:(NSError* __autoreleasing*)error{
+
+    __block BOOL success;
+    __block NSError* blockError;
+
+    dispatch_sync(_queue, ^(void){
+
+        EOSJournalEntry* entry = [_entries objectForKey:identifier];
+
+        //a file may be removed without having been downloaded through the journal, but only known downloads can be aborted
+        if (entry == nil && type != EOSJournalRecordType_Deletion){
+
+            blockError = EOSCreateError(EOSError_InvalidParameter);
+            success = NO;
+            return;
+
+        }
+
+        success = [self appendFrame:[self stateRecordOfType:type forIdentifier:identifier] error:&blockError];
+
+        if (success){
+
+            if (entry == nil){
+
+                entry = [[EOSJournalEntry alloc] init];
+                [entry setIdentifier:identifier];
+                [_entries setObject:entry forKey:identifier];
+
+            }
+
+            [entry setState:state];
+            [self compactIfNeededOnQueue];
+
+        }
+
+    });
+
+    if (!success && error)
+        *error = blockError;
+
+    return success;
+
+}
+
+-(BOOL)recordAbortForIdentifier:(NSString *)identifier error:(NSError *__autoreleasing *)error{
+
+    EOSJournalEntry* entry = [self entryForIdentifier:identifier];
+
+    if (entry != nil)
+        [[NSFileManager defaultManager] removeItemAtURL:[entry destinationURL] error:nil];
+
+    return [self recordState:EOSJournalEntryState_Aborted ofType:EOSJournalRecordType_Abort forIdentifier:identifier error:error];
+
+}
+
+-(BOOL)recordDeletionForIdentifier:(NSString *)identifier error:(NSError *__autoreleasing *)error{
+
+    return [self recordState:EOSJournalEntryState_Deleted ofType:EOSJournalRecordType_Deletion forIdentifier:identifier error:error];
+
+}
+
+-(BOOL)removeFile:(EOSFile *)file error:(NSError *__autoreleasing *)error{
+
+    EOSFileInfo* info = [file info:error];
+    if (info == nil)
+        return NO;
+
+    if (![file remove:error])
+        return NO;
+
+    return [self recordDeletionForIdentifier:[EOSDownloadJournal identifierForFile:file info:info] error:error];
+
+}
+
+
+
+
+#pragma mark - Querying
+
+-(EOSJournalEntry*)entryForIdentifier:(NSString *)identifier{
+
+    __block EOSJournalEntry* entry;
+
+    dispatch_sync(_queue, ^(void){
+        entry = [_entries objectForKey:identifier];
+    });
+
+    return entry;
+
+}
+
+-(NSArray*)filesNeedingDownload:(NSArray *)files{
+
+    NSMutableArray* array = [NSMutableArray arrayWithCapacity:[files count]];
+
+    for (EOSFile* file in files){
+
+        EOSFileInfo* info = [file info:nil];
+
+        if (info != nil){
+
+            EOSJournalEntry* entry = [self entryForIdentifier:[EOSDownloadJournal identifierForFile:file info:info]];
+            EOSJournalEntryState state = [entry state];
+
+            if (entry != nil && (state == EOSJournalEntryState_Completed || state == EOSJournalEntryState_Deleted))
+                continue;
+
+        }
+
+        [array addObject:file];
+
+    }
+
+    return [NSArray arrayWithArray:array];
+
+}
+
+
+
+
+#pragma mark - Compaction
+
+-(BOOL)compact:(NSError *__autoreleasing *)error{
+
+    __block BOOL success;
+    __block NSError* blockError;
+
+    dispatch_sync(_queue, ^(void){
+        success = [self compactOnQueue:&blockError];
+    });
+
+    if (!success && error)
+        *error = blockError;
+
+    return success;
+
+}
+
+//must be called on _queue
+-(BOOL)compactOnQueue:(NSError* __autoreleasing*)error{
+
+    if (_fd < 0){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_CloseError);
+        return NO;
+
+    }
+
+    NSString* temporaryPath = [[_URL path] stringByAppendingString:@".compact"];
+    int fd = open([temporaryPath fileSystemRepresentation], O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_OpenError);
+        return NO;
+
+    }
+
+
+    //each entry is written as a single record, superseding the records that led to it; aborted entries are dropped as they need downloading anyway
+    NSMutableData* data = [NSMutableData data];
+    NSMutableDictionary* entries = [NSMutableDictionary dictionary];
+
+    uint32_t version = CFSwapInt32HostToLittle(EOSJournalVersion);
+    [data appendBytes:EOSJournalMagic length:4];
+    [data appendBytes:&version length:4];
+
+    for (EOSJournalEntry* entry in [_entries allValues]){
+
+        switch ([entry state]){
+
+            case EOSJournalEntryState_InProgress:
+                [data appendData:[self intentRecordForEntry:entry]];
+                break;
+
+            case EOSJournalEntryState_Completed:
+            case EOSJournalEntryState_Deleted:
+                [data appendData:[self snapshotRecordForEntry:entry]];
+                break;
+
+            default:
+                continue;
+
+        }
+
+        [entries setObject:entry forKey:[entry identifier]];
+
+    }
+
+    BOOL written = write(fd, [data bytes], [data length]) == (ssize_t)[data length] && fsync(fd) == 0;
+    close(fd);
+
+    if (!written || rename([temporaryPath fileSystemRepresentation], [[_URL path] fileSystemRepresentation]) != 0){
+
+        unlink([temporaryPath fileSystemRepresentation]);
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_WriteError);
+        return NO;
+
+    }
+
+
+    //continue appending to the compacted journal
+    close(_fd);
+    _fd = open([[_URL path] fileSystemRepresentation], O_RDWR | O_APPEND);
+
+    _entries = entries;
+    _appendedRecords = 0;
+
+    return _fd >= 0;
+
+}
+
+-(void)close{
+
+    dispatch_sync(_queue, ^(void){
+
+        if (_fd >= 0)
+            close(_fd);
+        _fd = -1;
+
+    });
+
+}
+
+@end
\ No newline at end of file
@@ -12,6 +12,11 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class EOSCamera;
+@class EOSVolume;
+@class EOSSharedRing;
+@class EOSSharedSlot;
+
 /*!
  @brief File attributes
  */
@@ -61,6 +66,63 @@ FOUNDATION_EXPORT NSString *const EOSSavedFilenameKey;
 FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
 
 
+/*!
+ @const      EOSArchiveDirectoryURLKey
+ @abstract   Archive directory URL.
+ @discussion The value for this key should be an NSURL object referencing a directory on a slower storage tier. When this key is present, the directory referenced by EOSDownloadDirectoryURLKey is treated as a fast scratch directory. The file is downloaded to the scratch directory, and is then moved to the archive directory in the background by the shared EOSFileMigrator. The delegate's didArchiveFile:withOptions:contextInfo:error: method is called when the move is complete.
+ */
+FOUNDATION_EXPORT NSString *const EOSArchiveDirectoryURLKey;
+
+/*!
+ @const      EOSLandingFileURLKey
+ @abstract   Landing file URL.
+ @discussion The value for this key will be an NSURL object referencing the location that the file was downloaded to. When EOSArchiveDirectoryURLKey is used, this is the location in the scratch directory. The options dictionary returned in the EOSDownloadDelegate methods will have this key.
+ */
+FOUNDATION_EXPORT NSString *const EOSLandingFileURLKey;
+
+/*!
+ @const      EOSArchivedFileURLKey
+ @abstract   Archived file URL.
+ @discussion The value for this key will be an NSURL object referencing the final location of the file in the archive directory. The options dictionary returned in the didArchiveFile:withOptions:contextInfo:error: method will have this key if the move was successful.
+ */
+FOUNDATION_EXPORT NSString *const EOSArchivedFileURLKey;
+
+/*!
+ @const      EOSFileChecksumKey
+ @abstract   File checksum.
+ @discussion The value for this key will be an NSData object containing the SHA-256 checksum of the downloaded file. The options dictionary returned in the didArchiveFile:withOptions:contextInfo:error: method will have this key if the move was successful, as will the options dictionary returned in the didDownloadFile:withOptions:contextInfo:error: method if EOSDownloadJournalKey was used.
+ */
+FOUNDATION_EXPORT NSString *const EOSFileChecksumKey;
+
+/*!
+ @const      EOSDownloadJournalKey
+ @abstract   Download journal.
+ @discussion The value for this key should be an EOSDownloadJournal object. The intent to download the file is recorded in the journal before the file is created, and the completion of the download (along with the file's checksum) is recorded afterwards. If the download fails, the partial file is removed. When this key is present, the options dictionary returned in the didDownloadFile:withOptions:contextInfo:error: method will have the EOSFileChecksumKey key if the download was successful.
+ */
+FOUNDATION_EXPORT NSString *const EOSDownloadJournalKey;
+
+/*!
+ @const      EOSDownloadCatalogKey
+ @abstract   Download catalog.
+ @discussion The value for this key should be an EOSCatalog object. A record of the file is added to the catalog once the download has completed, and its location is updated if the file is moved to an archive directory. A failure to update the catalog does not cause the download to fail.
+ */
+FOUNDATION_EXPORT NSString *const EOSDownloadCatalogKey;
+
+/*!
+ @const      EOSDownloadProcessingPipelineKey
+ @abstract   Post-download processing.
+ @discussion The value for this key should be an EOSProcessingPipeline object. Once the download has completed and didDownloadFile:withOptions:contextInfo:error: has returned, the downloaded file is passed through the pipeline, and the delegate's didProcessFile:withOptions:contextInfo:error: method is called when every stage is done. When EOSArchiveDirectoryURLKey is also used, the file is processed in the scratch directory and is moved to the archive directory afterwards.
+ */
+FOUNDATION_EXPORT NSString *const EOSDownloadProcessingPipelineKey;
+
+/*!
+ @const      EOSProcessingResultsKey
+ @abstract   Processing results.
+ @discussion The value for this key will be an NSDictionary object containing the results of the processing stages that completed, keyed by the names of the stages. The options dictionary returned in the didProcessFile:withOptions:contextInfo:error: method will have this key.
+ */
+FOUNDATION_EXPORT NSString *const EOSProcessingResultsKey;
+
+
 
 
 
@@ -102,11 +164,11 @@ FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
  */
 @property EOSImageFormat imageFormat;
 
-
-/*
- Not in documentation
+/*!
+ @brief The date that the file was created on the camera.
+ @discussion This value will be nil if the camera does not report a date.
  */
-//@property NSUInteger dateTime;
+@property (nullable) NSDate* captureDate;
 
 
 
@@ -150,9 +212,28 @@ FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
 
 /*!
  The EOSFile class is used to represent a file that is stored on a camera.
+ @discussion While an EOSFile exists, every lookup or event for the same file on the same camera returns that object, so its info is only fetched once.
  */
 @interface EOSFile : EOSObject
 
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The camera that the file is stored on.
+ @discussion This is nil if the file was not retrieved through an EOSCamera, EOSVolume or EOSFile object.
+ */
+@property (readonly, weak, nullable) EOSCamera* camera;
+
+/*!
+ @brief The volume that the file is stored on.
+ @discussion This is nil if the file was not retrieved through an EOSVolume or EOSFile object, such as files passed to the EOSCameraDelegate methods.
+ */
+@property (readonly, nullable) EOSVolume* volume;
+
+
+
 ///---------------------
 /// @name Initialization
 ///---------------------
@@ -235,7 +316,7 @@ FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
 
 /*!
  @brief Downloads the file asynchronously.
- @discussion When the download is completed, the didDownloadFile:withOptions:contextInfo:error method of the delegate object is called. The content of the error returned should be examined to determine if the download completed successfully. See EOSDownloadDelegate for more information. The options dictionary may contain the keys; EOSDownloadDirectoryURLKey, EOSSaveAsFilenameKey and EOSOverwriteKey.
+ @discussion When the download is completed, the didDownloadFile:withOptions:contextInfo:error method of the delegate object is called. The content of the error returned should be examined to determine if the download completed successfully. See EOSDownloadDelegate for more information. The options dictionary may contain the keys; EOSDownloadDirectoryURLKey, EOSSaveAsFilenameKey, EOSOverwriteKey, EOSArchiveDirectoryURLKey, EOSDownloadJournalKey, EOSDownloadCatalogKey and EOSDownloadProcessingPipelineKey.
  @param options A dictionary of options.
  @param delegate The download delegate.
  @param contextInfo An object that will be passed to the delegate methods. Can be nil.
@@ -250,6 +331,15 @@ FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
 */
 -(void)readDataWithDelegate:(id<EOSReadDataDelegate>)delegate contextInfo:(nullable id)contextInfo;
 
+/*!
+ @brief Downloads the file into a slot of a shared ring.
+ @discussion The file is downloaded straight into the shared memory, so it can be handed to other processes without being copied. This method is synchronous. The length of the returned slot is the size of the file. The slot has not been published; publish it with [EOSSharedRing publishSlot:consumers:], or pass it to [EOSDaemon publishSlot:camera:].
+ @param ring A ring that was created by this process.
+ @param error If unsuccessful, an instance of NSError describes the problem. If the file is larger than the slot size of the ring, the error code will be EOSError_InvalidLength.
+ @return The slot containing the file, or nil if unsuccessful.
+ */
+-(nullable EOSSharedSlot*)downloadToSharedRing:(EOSSharedRing*)ring error:(NSError* __autoreleasing*)error;
+
 /**
  Untested!
  */
@@ -281,7 +371,7 @@ FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
 
 /*!
  @brief Invoked when the download is complete.
- @discussion The content of error returned should be examined to determine if the download completed successfully. The options dictionary will contain the additional key; EOSSavedFilenameKey.
+ @discussion The content of error returned should be examined to determine if the download completed successfully. The options dictionary will contain the additional keys; EOSSavedFilenameKey and EOSLandingFileURLKey.
  @param file The file that was downloaded.
  @param options The dictionary of download options.
  @param contextInfo The object that was passed to the download method.
@@ -301,6 +391,26 @@ FOUNDATION_EXPORT NSString *const EOSOverwriteKey;
  */
 -(void)didReceiveDownloadProgress:(NSUInteger)progress forFile:(EOSFile*)file withOptions:(NSDictionary*)options contextInfo:(nullable id)contextInfo;
 
+/*!
+ @brief Invoked when a downloaded file has been moved to the archive directory.
+ @discussion This method is only called for downloads that were started with the EOSArchiveDirectoryURLKey option, and only after didDownloadFile:withOptions:contextInfo:error: reported a successful download. The options dictionary will contain the additional keys; EOSSavedFilenameKey and EOSLandingFileURLKey, as well as EOSArchivedFileURLKey and EOSFileChecksumKey if the move was successful. If the move failed, the file remains at its landing location.
+ @param file The file that was downloaded.
+ @param options The dictionary of download options.
+ @param contextInfo The object that was passed to the download method.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ */
+-(void)didArchiveFile:(EOSFile*)file withOptions:(NSDictionary*)options contextInfo:(nullable id)contextInfo error:(nullable NSError*)error;
+
+/*!
+ @brief Invoked on the main thread when a downloaded file has passed through every stage of its processing pipeline.
+ @discussion This method is only called for downloads that were started with the EOSDownloadProcessingPipelineKey option, and only after didDownloadFile:withOptions:contextInfo:error: reported a successful download. The options dictionary will contain the additional keys; EOSSavedFilenameKey, EOSLandingFileURLKey and EOSProcessingResultsKey.
+ @param file The file that was downloaded.
+ @param options The dictionary of download options.
+ @param contextInfo The object that was passed to the download method.
+ @param error If a stage failed, an instance of NSError describes the first failure.
+ */
+-(void)didProcessFile:(EOSFile*)file withOptions:(NSDictionary*)options contextInfo:(nullable id)contextInfo error:(nullable NSError*)error;
+
 
 @end
 
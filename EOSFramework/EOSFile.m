@@ -9,11 +9,46 @@
 #import <EOSFramework/EOSFile.h>
 #import <EDSDK/EDSDK.h>
 #import <EOSFramework/EOSError.h>
+#import <EOSFramework/EOSFileMigrator.h>
+#import <EOSFramework/EOSDownloadJournal.h>
+#import <EOSFramework/EOSCatalog.h>
+#import <EOSFramework/EOSSharedRing.h>
+#import <EOSFramework/EOSProcessingPipeline.h>
+#import "EOSPrivate.h"
 
 NSString *const EOSDownloadDirectoryURLKey = @"EOSDownloadDirectoryURLKey";
 NSString *const EOSSaveAsFilenameKey = @"EOSSaveAsFilenameKey";
 NSString *const EOSSavedFilenameKey = @"EOSSavedFilenameKey";
 NSString *const EOSOverwriteKey = @"EOSOverwriteKey";
+NSString *const EOSArchiveDirectoryURLKey = @"EOSArchiveDirectoryURLKey";
+NSString *const EOSLandingFileURLKey = @"EOSLandingFileURLKey";
+NSString *const EOSArchivedFileURLKey = @"EOSArchivedFileURLKey";
+NSString *const EOSFileChecksumKey = @"EOSFileChecksumKey";
+NSString *const EOSDownloadJournalKey = @"EOSDownloadJournalKey";
+NSString *const EOSDownloadCatalogKey = @"EOSDownloadCatalogKey";
+NSString *const EOSDownloadProcessingPipelineKey = @"EOSDownloadProcessingPipelineKey";
+NSString *const EOSProcessingResultsKey = @"EOSProcessingResultsKey";
+
+//reports a transfer's progress to the transfer-chunk probe
+static void EOSFileProbeProgress(EOSFile* file, EdsUInt32 percent){
+    
+    if (EOSFRAMEWORK_TRANSFER_CHUNK_ENABLED()){
+        
+        EOSFileInfo* info = [file info:nil];
+        EOSFRAMEWORK_TRANSFER_CHUNK(EOSProbeSerialNumber(file), (char*)[[info name] UTF8String], (uint64_t)[info size] * percent / 100, (uint64_t)[info size]);
+        
+    }
+    
+}
+
+//only installed while the transfer-chunk probe is enabled and the delegate doesn't want progress
+EDSCALLBACK EdsError probeProgressCallback(EdsUInt32 inPercent, EdsVoid* inContext, EdsBool* outCancel){
+    
+    EOSFileProbeProgress((__bridge EOSFile *)(inContext), inPercent);
+    
+    return EDS_ERR_OK;
+    
+};
 
 EDSCALLBACK EdsError downloadProgressCallback(EdsUInt32 inPercent, EdsVoid* inContext, EdsBool* outCancel){
     
@@ -31,6 +66,7 @@ EDSCALLBACK EdsError downloadProgressCallback(EdsUInt32 inPercent, EdsVoid* inCo
     
     EOSFile* file = [array objectAtIndex:1];
     NSDictionary* options = [array objectAtIndex:2];
+    EOSFileProbeProgress(file, inPercent);
     id contextInfo = [array count] > 3 ? [array objectAtIndex:3] : nil;
     
     [inv setArgument:&file atIndex:3];
@@ -59,6 +95,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
     
     EOSFile* file = [array objectAtIndex:1];
     id contextInfo = [array count] > 2 ? [array objectAtIndex:2] : nil;
+    EOSFileProbeProgress(file, inPercent);
     
     [inv setArgument:&file atIndex:3];
     [inv setArgument:&contextInfo atIndex:4];
@@ -69,21 +106,47 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
     
 };
 
-@implementation EOSFile
+@implementation EOSFile{
+
+    //a directory item's info doesn't change while it exists, so it is only fetched once
+    EOSFileInfo* _info;
+
+}
 
 //@synthesize baseRef = _baseRef;
 
 -(id)initWithDirectoryItemRef:(EdsDirectoryItemRef)fileRef{
     
-    return [self initWithBaseRef:fileRef];
+    return [self initWithDirectoryItemRef:fileRef camera:nil volume:nil];
+    
+}
+
+-(id)initWithDirectoryItemRef:(EdsDirectoryItemRef)fileRef camera:(EOSCamera *)camera volume:(EOSVolume *)volume{
+    
+    self = [self initWithBaseRef:fileRef];
+    if (self){
+        
+        _camera = camera;
+        _volume = volume;
+        
+    }
+    
+    return self;
     
 }
 
 -(EOSFileInfo*)info:(NSError *__autoreleasing *)error{
 
+    @synchronized(self){
+
+        if (_info != nil)
+            return _info;
+
+    }
+
     EdsDirectoryItemInfo directoryItemInfo;
 
-    EOSError errorCode = EdsGetDirectoryItemInfo(_baseRef, &directoryItemInfo);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetDirectoryItemInfo(_baseRef, &directoryItemInfo));
     
     if (errorCode != EOSError_OK){
         
@@ -93,7 +156,13 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         
     }
     
-    return [[EOSFileInfo alloc] initWithDirectoryItemInfo:directoryItemInfo];
+    EOSFileInfo* info = [[EOSFileInfo alloc] initWithDirectoryItemInfo:directoryItemInfo];
+
+    @synchronized(self){
+        _info = info;
+    }
+
+    return info;
     
 }
 
@@ -101,7 +170,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
     
     EdsFileAttributes attribute;
     
-    EOSError errorCode = EdsGetAttribute(_baseRef, &attribute);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetAttribute(_baseRef, &attribute));
     
     if (errorCode != EOSError_OK){
         
@@ -117,7 +186,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
 
 -(BOOL)setAttribute:(EOSFileAttribute)attribute error:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsSetAttribute(_baseRef, (EdsFileAttributes)attribute);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSetAttribute(_baseRef, (EdsFileAttributes)attribute));
     
     if (errorCode != EOSError_OK){
         
@@ -135,7 +204,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
     
     EdsUInt32 count;
     
-    EOSError errorCode = EdsGetChildCount(_baseRef, &count);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetChildCount(_baseRef, &count));
     
     if (errorCode != EOSError_OK){
         
@@ -153,7 +222,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
     
     EdsDirectoryItemRef fileRef;
     
-    EOSError errorCode = EdsGetChildAtIndex(_baseRef, (int)index, &fileRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetChildAtIndex(_baseRef, (int)index, &fileRef));
     
     if (errorCode != EOSError_OK){
         if (error)
@@ -162,7 +231,12 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         
     }
     
-    return [[EOSFile alloc] initWithDirectoryItemRef:fileRef];
+    EOSCamera* camera = _camera;
+
+    if (camera == nil)
+        return [[EOSFile alloc] initWithDirectoryItemRef:fileRef camera:nil volume:_volume];
+
+    return [camera internDirectoryItemRef:fileRef volume:_volume];
     
 }
 
@@ -204,6 +278,9 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         NSDictionary* newOptions;
         NSError* error;
         
+        EOSDownloadJournal* journal = [options objectForKey:EOSDownloadJournalKey];
+        NSString* journalIdentifier;
+        
         
         //get info
         EOSFileInfo* info = [self info:&error];
@@ -239,20 +316,50 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
             }
             
             
-            //update options to include savedFilename
+            //full download URL
+            NSURL* downloadURL = [NSURL URLWithString:saveAsFilename relativeToURL:downloadDirectoryURL];
+            
+            
+            //update options to include savedFilename and landingFileURL
             NSMutableDictionary* newOptionsM = [NSMutableDictionary dictionaryWithDictionary:options];
             [newOptionsM setObject:saveAsFilename forKey:EOSSavedFilenameKey];
+            [newOptionsM setObject:[downloadURL absoluteURL] forKey:EOSLandingFileURLKey];
             newOptions = [NSDictionary dictionaryWithDictionary:newOptionsM];
             
-            //full download URL
-            NSURL* downloadURL = [NSURL URLWithString:saveAsFilename relativeToURL:downloadDirectoryURL];
-            
             //disposition (overwrite or not)
-            EdsFileCreateDisposition disposition = [[options objectForKey:EOSOverwriteKey] boolValue] == YES ? kEdsFileCreateDisposition_CreateAlways : kEdsFileCreateDisposition_CreateNew;
+            BOOL overwrite = [[options objectForKey:EOSOverwriteKey] boolValue];
+            EdsFileCreateDisposition disposition = overwrite == YES ? kEdsFileCreateDisposition_CreateAlways : kEdsFileCreateDisposition_CreateNew;
+            
+            
+            //record the intent before the file is created
+            if (journal != nil){
+                
+                if (!overwrite && [[NSFileManager defaultManager] fileExistsAtPath:[downloadURL path]]){
+                    
+                    errorCode = EOSError_File_AlreadyExists;
+                    
+                }else{
+                    
+                    journalIdentifier = [EOSDownloadJournal identifierForFile:self info:info];
+                    
+                    if (![journal recordIntentForIdentifier:journalIdentifier destinationURL:[downloadURL absoluteURL] size:size error:&error]){
+                        
+                        journalIdentifier = nil;
+                        errorCode = [error code];
+                        
+                    }
+                    
+                }
+                
+            }
             
             
             //create file stream
-            errorCode = EdsCreateFileStreamEx((__bridge CFURLRef)downloadURL, disposition, kEdsAccess_Write, &stream);
+            if (errorCode == EOSError_OK)
+                errorCode = EdsCreateFileStreamEx((__bridge CFURLRef)downloadURL, disposition, kEdsAccess_Write, &stream);
+            
+            if (errorCode == EOSError_OK)
+                EOSRefTrackerAddRef(stream, @"EdsStream", _camera);
             
         }
 
@@ -282,14 +389,14 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         if (errorCode == EOSError_OK){
             
             //download
-            errorCode = EdsDownload(_baseRef, (EdsUInt32)size, stream);
+            errorCode = [self downloadSize:size toStream:stream hasProgressCallback:delegateRespondsToProgress];
             
         }
         
         if (errorCode == EOSError_OK){
             
             //complete download
-            errorCode = EdsDownloadComplete(_baseRef);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsDownloadComplete(_baseRef));
             
         }
         
@@ -297,11 +404,58 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         //release stream
         if (stream != NULL){
             
-            EdsRelease(stream);
+            EOSRefTrackerRelease(stream);
             stream = NULL;
             
         }
         
+        
+        //record the outcome
+        if (journalIdentifier != nil){
+            
+            NSData* checksum;
+            
+            if (errorCode == EOSError_OK){
+                
+                checksum = EOSChecksumForFileAtURL([newOptions objectForKey:EOSLandingFileURLKey], &error);
+                
+                if (checksum == nil || ![journal recordCompletionForIdentifier:journalIdentifier checksum:checksum error:&error])
+                    errorCode = [error code];
+                
+            }
+            
+            if (errorCode == EOSError_OK){
+                
+                NSMutableDictionary* newOptionsM = [NSMutableDictionary dictionaryWithDictionary:newOptions];
+                [newOptionsM setObject:checksum forKey:EOSFileChecksumKey];
+                newOptions = [NSDictionary dictionaryWithDictionary:newOptionsM];
+                
+            }else{
+                
+                //removes the partial file
+                [journal recordAbortForIdentifier:journalIdentifier error:nil];
+                
+            }
+            
+        }
+        
+        
+        //add to the catalog
+        EOSCatalog* catalog = [options objectForKey:EOSDownloadCatalogKey];
+        
+        if (errorCode == EOSError_OK && catalog != nil){
+            
+            NSURL* landingFileURL = [newOptions objectForKey:EOSLandingFileURLKey];
+            NSData* checksum = [newOptions objectForKey:EOSFileChecksumKey];
+            
+            if (checksum == nil)
+                checksum = EOSChecksumForFileAtURL(landingFileURL, nil);
+            
+            //the file has been downloaded, so a catalog failure isn't reported as a download failure
+            [catalog addRecordForFile:self info:info localURL:landingFileURL checksum:checksum error:nil];
+            
+        }
+        
             
         error = EOSCreateError(errorCode);
         
@@ -327,6 +481,65 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         [inv performSelectorOnMainThread:@selector(invoke) withObject:nil waitUntilDone:YES];
         
         
+        //move the file to the archive tier in the background
+        NSURL* archiveDirectoryURL = [options objectForKey:EOSArchiveDirectoryURLKey];
+        
+        void (^archive)(void) = ^(void){
+            
+            if (errorCode != EOSError_OK || archiveDirectoryURL == nil)
+                return;
+            
+            BOOL overwrite = [[options objectForKey:EOSOverwriteKey] boolValue];
+            
+            [[EOSFileMigrator sharedMigrator] migrateFileAtURL:[newOptions objectForKey:EOSLandingFileURLKey] toDirectoryURL:archiveDirectoryURL overwrite:overwrite completion:^(NSURL* archivedURL, NSData* checksum, NSError* archiveError){
+                
+                if (archivedURL != nil)
+                    [catalog moveRecordAtURL:[newOptions objectForKey:EOSLandingFileURLKey] toURL:archivedURL error:nil];
+                
+                if (![delegate respondsToSelector:@selector(didArchiveFile:withOptions:contextInfo:error:)])
+                    return;
+                
+                NSMutableDictionary* archiveOptions = [NSMutableDictionary dictionaryWithDictionary:newOptions];
+                
+                if (archivedURL != nil){
+                    
+                    [archiveOptions setObject:archivedURL forKey:EOSArchivedFileURLKey];
+                    [archiveOptions setObject:checksum forKey:EOSFileChecksumKey];
+                    
+                }
+                
+                [delegate didArchiveFile:self withOptions:[NSDictionary dictionaryWithDictionary:archiveOptions] contextInfo:contextInfo error:archiveError];
+                
+            }];
+            
+        };
+        
+        
+        //process the file on the pipeline's workers, so neither this thread nor the main thread waits for it
+        EOSProcessingPipeline* pipeline = [options objectForKey:EOSDownloadProcessingPipelineKey];
+        
+        if (errorCode == EOSError_OK && pipeline != nil){
+            
+            [pipeline processFileAtURL:[newOptions objectForKey:EOSLandingFileURLKey] file:self completion:^(NSDictionary* results, NSError* processingError){
+                
+                if ([delegate respondsToSelector:@selector(didProcessFile:withOptions:contextInfo:error:)]){
+                    
+                    NSMutableDictionary* processOptions = [NSMutableDictionary dictionaryWithDictionary:newOptions];
+                    [processOptions setObject:results forKey:EOSProcessingResultsKey];
+                    
+                    [delegate didProcessFile:self withOptions:[NSDictionary dictionaryWithDictionary:processOptions] contextInfo:contextInfo error:processingError];
+                    
+                }
+                
+                //the file is archived once it has been processed on the scratch tier
+                archive();
+                
+            }];
+            
+        }else
+            archive();
+        
+        
     });
     
 }
@@ -364,6 +577,9 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
             //create memory stream
             errorCode = EdsCreateMemoryStream((EdsUInt32)size, &stream);
             
+            if (errorCode == EOSError_OK)
+                EOSRefTrackerAddRef(stream, @"EdsStream", _camera);
+            
         }
 
         if (errorCode == EOSError_OK){
@@ -388,14 +604,14 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         if (errorCode == EOSError_OK){
             
             //start download
-            errorCode = EdsDownload(_baseRef, (EdsUInt32)size, stream);
+            errorCode = [self downloadSize:size toStream:stream hasProgressCallback:delegateRespondsToProgress];
             
         }
 
         if (errorCode == EOSError_OK){
             
             //complete download
-            errorCode = EdsDownloadComplete(_baseRef);
+            errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsDownloadComplete(_baseRef));
             
         }
 
@@ -417,7 +633,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
 
         if (stream != NULL){
             
-            EdsRelease(stream);
+            EOSRefTrackerRelease(stream);
             stream = NULL;
             
         }
@@ -449,9 +665,153 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
 
 }
 
+//transfers the file into a stream under the watchdog and the transfer probes
+-(EOSError)downloadSize:(NSUInteger)size toStream:(EdsStreamRef)stream hasProgressCallback:(BOOL)hasProgressCallback{
+    
+    EOSFileInfo* info = (EOSFRAMEWORK_TRANSFER_START_ENABLED() || EOSFRAMEWORK_TRANSFER_FINISH_ENABLED()) ? [self info:nil] : nil;
+    uint64_t start = mach_absolute_time();
+    
+    if (EOSFRAMEWORK_TRANSFER_START_ENABLED())
+        EOSFRAMEWORK_TRANSFER_START(EOSProbeSerialNumber(self), (char*)[[info name] UTF8String], (uint64_t)size);
+    
+    //the stream only exists for this transfer, so the callback can't outlive the file
+    if (!hasProgressCallback && EOSFRAMEWORK_TRANSFER_CHUNK_ENABLED())
+        EdsSetProgressCallback(stream, probeProgressCallback, kEdsProgressOption_Periodically, (__bridge EdsVoid *)(self));
+    
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Transfer, EdsDownload(_baseRef, (EdsUInt32)size, stream));
+    
+    if (EOSFRAMEWORK_TRANSFER_FINISH_ENABLED())
+        EOSFRAMEWORK_TRANSFER_FINISH(EOSProbeSerialNumber(self), (char*)[[info name] UTF8String], (uint64_t)size, (int)errorCode, EOSProbeNanosecondsSince(start));
+    
+    return errorCode;
+    
+}
+
+-(BOOL)downloadIntoBytes:(void *)bytes capacity:(NSUInteger)capacity length:(NSUInteger *)length error:(NSError *__autoreleasing *)error{
+    
+    EdsStreamRef stream = NULL;
+    EOSError errorCode = EOSError_OK;
+    NSUInteger size = 0;
+    
+    EOSFileInfo* info = [self info:error];
+    if (info == nil)
+        return NO;
+    
+    size = [info size];
+    
+    if (size > capacity){
+        
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidLength);
+        return NO;
+        
+    }
+    
+    //the stream writes directly into the caller's memory
+    errorCode = EdsCreateMemoryStreamFromPointer(bytes, (EdsUInt32)capacity, &stream);
+    
+    if (errorCode == EOSError_OK)
+        EOSRefTrackerAddRef(stream, @"EdsStream", _camera);
+    
+    if (errorCode == EOSError_OK)
+        errorCode = [self downloadSize:size toStream:stream hasProgressCallback:NO];
+    
+    if (errorCode == EOSError_OK)
+        errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsDownloadComplete(_baseRef));
+    
+    if (stream != NULL){
+        
+        EOSRefTrackerRelease(stream);
+        stream = NULL;
+        
+    }
+    
+    if (errorCode != EOSError_OK){
+        
+        if (error)
+            *error = EOSCreateError(errorCode);
+        return NO;
+        
+    }
+    
+    *length = size;
+    return YES;
+    
+}
+
+-(BOOL)downloadToURL:(NSURL *)url error:(NSError *__autoreleasing *)error{
+    
+    return [self downloadToURL:url overwrite:NO error:error];
+    
+}
+
+-(BOOL)downloadToURL:(NSURL *)url overwrite:(BOOL)overwrite error:(NSError *__autoreleasing *)error{
+    
+    EdsStreamRef stream = NULL;
+    EOSError errorCode = EOSError_OK;
+    
+    EOSFileInfo* info = [self info:error];
+    if (info == nil)
+        return NO;
+    
+    errorCode = EdsCreateFileStreamEx((__bridge CFURLRef)url, overwrite ? kEdsFileCreateDisposition_CreateAlways : kEdsFileCreateDisposition_CreateNew, kEdsAccess_Write, &stream);
+    BOOL isCreated = errorCode == EOSError_OK;
+    
+    if (isCreated)
+        EOSRefTrackerAddRef(stream, @"EdsStream", _camera);
+    
+    if (errorCode == EOSError_OK)
+        errorCode = [self downloadSize:[info size] toStream:stream hasProgressCallback:NO];
+    
+    if (errorCode == EOSError_OK)
+        errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsDownloadComplete(_baseRef));
+    
+    if (stream != NULL){
+        
+        EOSRefTrackerRelease(stream);
+        stream = NULL;
+        
+    }
+    
+    if (errorCode != EOSError_OK){
+        
+        //a file that was already at the url wasn't created by this call, and is left alone
+        if (isCreated)
+            [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        
+        if (error)
+            *error = EOSCreateError(errorCode);
+        return NO;
+        
+    }
+    
+    return YES;
+    
+}
+
+-(EOSSharedSlot*)downloadToSharedRing:(EOSSharedRing *)ring error:(NSError *__autoreleasing *)error{
+    
+    EOSSharedSlot* slot = [ring acquireSlot:error];
+    if (slot == nil)
+        return nil;
+    
+    NSUInteger length = 0;
+    
+    if (![self downloadIntoBytes:[slot bytes] capacity:[slot capacity] length:&length error:error]){
+        
+        [ring abandonSlot:slot];
+        return nil;
+        
+    }
+    
+    [slot setLength:length];
+    return slot;
+    
+}
+
 -(BOOL)cancelTransfer:(NSError* __autoreleasing*)error{
     
-    EOSError errorCode = EdsDownloadCancel(_baseRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Recovery, EdsDownloadCancel(_baseRef));
     
     if (errorCode != EOSError_OK){
         
@@ -469,7 +829,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
 
 -(BOOL)remove:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsDeleteDirectoryItem(_baseRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsDeleteDirectoryItem(_baseRef));
     
     if (errorCode != EOSError_OK){
         
@@ -504,6 +864,7 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
         _groupID = groupID;
         _name = name;
         _imageFormat = imageFormat;
+        _captureDate = nil;
         
     }
     
@@ -513,7 +874,16 @@ EDSCALLBACK EdsError readProgressCallback(EdsUInt32 inPercent, EdsVoid* inContex
 
 -(id)initWithDirectoryItemInfo:(EdsDirectoryItemInfo)fileInfo{
     
-    return [self initWithSize:fileInfo.size isDirectory:fileInfo.isFolder groupID:fileInfo.groupID name:[NSString stringWithUTF8String:fileInfo.szFileName] imageFormat:fileInfo.format];
+    self = [self initWithSize:fileInfo.size isDirectory:fileInfo.isFolder groupID:fileInfo.groupID name:[NSString stringWithUTF8String:fileInfo.szFileName] imageFormat:fileInfo.format];
+    if (self){
+        
+        //seconds since 1970, or 0 if the camera doesn't report it
+        if (fileInfo.dateTime != 0)
+            _captureDate = [NSDate dateWithTimeIntervalSince1970:fileInfo.dateTime];
+        
+    }
+    
+    return self;
     
 }
 
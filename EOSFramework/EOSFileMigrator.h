@@ -0,0 +1,80 @@
+//
+//  EOSFileMigrator.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @brief Calculates the SHA-256 checksum of a file.
+ @param url The URL of a local file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return If successful, a 32 byte NSData object containing the checksum, otherwise nil.
+ */
+FOUNDATION_EXPORT NSData* _Nullable EOSChecksumForFileAtURL(NSURL* url, NSError* __autoreleasing* error);
+
+
+/*!
+ The EOSFileMigrator class moves downloaded files from a fast scratch directory to a slower archive directory in the background.
+ @discussion Files are copied with the kernel's file copy routine, the copy is verified against the checksum of the original, and only then is the original removed. The number of migrations performing I/O at the same time is bounded, so a slow archive tier is never flooded with requests. Migrations are typically queued by [EOSFile downloadWithOptions:delegate:contextInfo:] when the EOSArchiveDirectoryURLKey option is provided.
+ */
+@interface EOSFileMigrator : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the shared migrator used by file downloads.
+ @discussion The shared migrator allows two migrations to perform I/O at once.
+ @return The shared instance of EOSFileMigrator.
+ */
++(EOSFileMigrator*)sharedMigrator;
+
+/*!
+ @brief Initializes a newly allocated EOSFileMigrator instance.
+ @param maxConcurrentMigrations The maximum number of migrations that may perform I/O at the same time. Must be at least 1.
+ @return The initialized EOSFileMigrator.
+ */
+-(id)initWithMaxConcurrentMigrations:(NSUInteger)maxConcurrentMigrations;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The maximum number of migrations that may perform I/O at the same time.
+ */
+@property (readonly) NSUInteger maxConcurrentMigrations;
+
+/*!
+ @brief The number of migrations that have been queued but have not yet completed.
+ */
+@property (readonly) NSUInteger pendingMigrationCount;
+
+
+
+///-----------------------
+/// @name Migrating Files
+///-----------------------
+
+/*!
+ @brief Moves a file into a directory asynchronously.
+ @discussion The file is copied next to its final location under a temporary name, verified, renamed into place and then removed from its original location. The directory is created if it does not exist. If verification fails, the original file is left untouched. The completion handler is invoked on the main thread.
+ @param sourceURL The URL of the file to move.
+ @param directoryURL The URL of the destination directory.
+ @param overwrite If YES, an existing file with the same name in the destination directory will be replaced.
+ @param completion A block invoked when the migration has finished. On success, destinationURL is the final location of the file and checksum is its SHA-256 checksum. Otherwise, error describes the problem.
+ */
+-(void)migrateFileAtURL:(NSURL*)sourceURL toDirectoryURL:(NSURL*)directoryURL overwrite:(BOOL)overwrite completion:(void (^)(NSURL* _Nullable destinationURL, NSData* _Nullable checksum, NSError* _Nullable error))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
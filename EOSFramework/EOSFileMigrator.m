@@ -0,0 +1,237 @@
+//
+//  EOSFileMigrator.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSFileMigrator.h>
+#import <EOSFramework/EOSError.h>
+#import <CommonCrypto/CommonDigest.h>
+#include <copyfile.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define EOSChecksumBufferSize (1024 * 1024)
+
+NSData* EOSChecksumForFileAtURL(NSURL* url, NSError* __autoreleasing* error){
+
+    int fd = open([[url path] fileSystemRepresentation], O_RDONLY);
+
+    if (fd < 0){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_OpenError);
+        return nil;
+
+    }
+
+    //the file is read once, so don't pollute the cache
+    fcntl(fd, F_NOCACHE, 1);
+
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+
+    void* buffer = malloc(EOSChecksumBufferSize);
+    ssize_t length;
+
+    while ((length = read(fd, buffer, EOSChecksumBufferSize)) > 0){
+
+        CC_SHA256_Update(&context, buffer, (CC_LONG)length);
+
+    }
+
+    free(buffer);
+    close(fd);
+
+    if (length < 0){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_ReadError);
+        return nil;
+
+    }
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &context);
+
+    return [NSData dataWithBytes:digest length:CC_SHA256_DIGEST_LENGTH];
+
+}
+
+@implementation EOSFileMigrator{
+
+    dispatch_queue_t _admissionQueue;
+    dispatch_queue_t _ioQueue;
+    dispatch_semaphore_t _ioSemaphore;
+    NSUInteger _pendingMigrationCount;
+
+}
+
++(EOSFileMigrator*)sharedMigrator{
+
+    static dispatch_once_t pred = 0;
+    __strong static id _sharedObject = nil;
+    dispatch_once(&pred, ^{
+        _sharedObject = [[self alloc] initWithMaxConcurrentMigrations:2];
+    });
+    return _sharedObject;
+
+}
+
+-(id)init{
+
+    return [self initWithMaxConcurrentMigrations:2];
+
+}
+
+-(id)initWithMaxConcurrentMigrations:(NSUInteger)maxConcurrentMigrations{
+
+    self = [super init];
+    if (self){
+
+        _maxConcurrentMigrations = MAX(maxConcurrentMigrations, 1);
+        _pendingMigrationCount = 0;
+
+        //migrations are admitted one at a time, and each admission waits for an I/O slot
+        _admissionQueue = dispatch_queue_create("com.EOSFramework.migrator.admission", DISPATCH_QUEUE_SERIAL);
+        _ioQueue = dispatch_queue_create("com.EOSFramework.migrator.io", DISPATCH_QUEUE_CONCURRENT);
+        _ioSemaphore = dispatch_semaphore_create(_maxConcurrentMigrations);
+
+    }
+
+    return self;
+
+}
+
+-(NSUInteger)pendingMigrationCount{
+
+    @synchronized(self){
+        return _pendingMigrationCount;
+    }
+
+}
+
+-(void)migrateFileAtURL:(NSURL *)sourceURL toDirectoryURL:(NSURL *)directoryURL overwrite:(BOOL)overwrite completion:(void (^)(NSURL * _Nullable, NSData * _Nullable, NSError * _Nullable))completion{
+
+    @synchronized(self){
+        _pendingMigrationCount++;
+    }
+
+    dispatch_async(_admissionQueue, ^(void){
+
+        //wait for an I/O slot
+        dispatch_semaphore_wait(_ioSemaphore, DISPATCH_TIME_FOREVER);
+
+        dispatch_async(_ioQueue, ^(void){
+
+            NSData* checksum;
+            NSError* error;
+            NSURL* destinationURL = [self moveFileAtURL:sourceURL toDirectoryURL:directoryURL overwrite:overwrite checksum:&checksum error:&error];
+
+            dispatch_semaphore_signal(_ioSemaphore);
+
+            @synchronized(self){
+                _pendingMigrationCount--;
+            }
+
+            if (completion){
+
+                dispatch_async(dispatch_get_main_queue(), ^(void){
+                    completion(destinationURL, checksum, error);
+                });
+
+            }
+
+        });
+
+    });
+
+}
+
+-(NSURL*)moveFileAtURL:(NSURL*)sourceURL toDirectoryURL:(NSURL*)directoryURL overwrite:(BOOL)overwrite checksum:(NSData* __autoreleasing*)checksum error:(NSError* __autoreleasing*)error{
+
+    NSFileManager* fileManager = [NSFileManager defaultManager];
+    NSString* filename = [sourceURL lastPathComponent];
+
+    NSURL* destinationURL = [directoryURL URLByAppendingPathComponent:filename];
+    NSURL* temporaryURL = [directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@".%@.eosmigrate", filename]];
+
+
+    //create directory if it doesn't exist
+    if (![fileManager fileExistsAtPath:[directoryURL path]]){
+
+        [fileManager createDirectoryAtPath:[directoryURL path] withIntermediateDirectories:YES attributes:nil error:nil];
+
+    }
+
+    if (!overwrite && [fileManager fileExistsAtPath:[destinationURL path]]){
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_AlreadyExists);
+        return nil;
+
+    }
+
+
+    //checksum of the original
+    NSData* sourceChecksum = EOSChecksumForFileAtURL(sourceURL, error);
+    if (sourceChecksum == nil)
+        return nil;
+
+
+    //copy next to the destination
+    [fileManager removeItemAtURL:temporaryURL error:nil];
+
+    if (copyfile([[sourceURL path] fileSystemRepresentation], [[temporaryURL path] fileSystemRepresentation], NULL, COPYFILE_DATA | COPYFILE_STAT) != 0){
+
+        //removing the partial copy may overwrite errno
+        BOOL isDiskFull = errno == ENOSPC;
+
+        [fileManager removeItemAtURL:temporaryURL error:nil];
+
+        if (error)
+            *error = EOSCreateError(isDiskFull ? EOSError_File_DiskFull : EOSError_File_WriteError);
+        return nil;
+
+    }
+
+
+    //verify the copy
+    NSData* copyChecksum = EOSChecksumForFileAtURL(temporaryURL, error);
+
+    if (copyChecksum == nil || ![copyChecksum isEqualToData:sourceChecksum]){
+
+        [fileManager removeItemAtURL:temporaryURL error:nil];
+
+        if (copyChecksum != nil && error)
+            *error = EOSCreateError(EOSError_File_DataCorrupt);
+        return nil;
+
+    }
+
+
+    //move into place
+    if (rename([[temporaryURL path] fileSystemRepresentation], [[destinationURL path] fileSystemRepresentation]) != 0){
+
+        [fileManager removeItemAtURL:temporaryURL error:nil];
+
+        if (error)
+            *error = EOSCreateError(EOSError_File_WriteError);
+        return nil;
+
+    }
+
+
+    //remove the original
+    [fileManager removeItemAtURL:sourceURL error:nil];
+
+    if (checksum)
+        *checksum = sourceChecksum;
+
+    return destinationURL;
+
+}
+
+@end
\ No newline at end of file
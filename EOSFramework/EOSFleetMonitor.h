@@ -0,0 +1,179 @@
+//
+//  EOSFleetMonitor.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSFleetMonitor;
+
+/*!
+ @brief The resources that a camera consumes as it shoots.
+ */
+typedef NS_ENUM(NSUInteger, EOSMonitorResource){
+
+    EOSMonitorResource_Storage,
+    EOSMonitorResource_Battery
+
+};
+
+
+
+
+/*!
+ The EOSConsumptionEstimate class describes how quickly a camera is using its storage and battery, and how long they will last.
+ */
+@interface EOSConsumptionEstimate : NSObject
+
+/*!
+ @brief The camera.
+ */
+@property (readonly) EOSCamera* camera;
+
+/*!
+ @brief The space available on the camera's volume, in bytes.
+ */
+@property (readonly) UInt64 availableBytes;
+
+/*!
+ @brief The camera's EOSProperty_BatteryLevel, or NSNotFound if it is unknown or the camera is on mains power.
+ */
+@property (readonly) NSUInteger batteryLevel;
+
+/*!
+ @brief The average size of a shot, in bytes, or 0 if no shots have been seen.
+ */
+@property (readonly) double bytesPerShot;
+
+/*!
+ @brief The average drop in battery level per shot, or 0 if none has been seen.
+ */
+@property (readonly) double batteryPerShot;
+
+/*!
+ @brief The recent shooting rate, or 0 if it is unknown.
+ */
+@property (readonly) double shotsPerMinute;
+
+/*!
+ @brief The number of shots until the resource that will run out first runs out, or NSNotFound if it can't be predicted yet.
+ */
+@property (readonly) NSUInteger shotsRemaining;
+
+/*!
+ @brief The time until the resource that will run out first runs out at the recent shooting rate, in minutes, or -1 if it can't be predicted yet.
+ */
+@property (readonly) double minutesRemaining;
+
+/*!
+ @brief The resource that will run out first.
+ */
+@property (readonly) EOSMonitorResource limitingResource;
+
+/*!
+ @brief Gets the number of shots until a resource runs out.
+ @param resource The resource.
+ @return The number of shots, or NSNotFound if it can't be predicted yet.
+ */
+-(NSUInteger)shotsRemainingForResource:(EOSMonitorResource)resource;
+
+@end
+
+
+
+
+/*!
+ The EOSFleetMonitorDelegate protocol receives the alerts of an EOSFleetMonitor.
+ @discussion The methods are called on the main thread.
+ */
+@protocol EOSFleetMonitorDelegate <NSObject>
+
+@optional
+
+/*!
+ @brief Called when a camera's storage or battery is predicted to run out within the monitor's thresholds.
+ @discussion The alert is made once. It is made again only after the prediction has risen above the thresholds, such as when the card is replaced or the battery is charged.
+ @param monitor The monitor.
+ @param camera The camera.
+ @param resource The resource that will run out.
+ @param estimate The camera's estimate.
+ */
+-(void)fleetMonitor:(EOSFleetMonitor*)monitor camera:(EOSCamera*)camera willRunOutOfResource:(EOSMonitorResource)resource estimate:(EOSConsumptionEstimate*)estimate;
+
+@end
+
+
+
+
+/*!
+ The EOSFleetMonitor class watches the storage and battery of several cameras, and predicts when they will run out.
+ @discussion The monitor listens to each camera's volume info and battery level events, and reads the camera only when one arrives. A camera that hasn't sent an event within pollInterval is read once as a fallback, so a fleet is watched with little traffic to the cameras.
+
+ Each drop in a volume's available space is counted as a shot, or as several shots if it is much larger than the average. From these, the monitor learns the average size of a shot, the drop in battery level per shot, and the recent shooting rate of each camera, and predicts how many shots and minutes remain before the storage or battery runs out. The application must run the run loop that the EDSDK delivers events on.
+ */
+@interface EOSFleetMonitor : NSObject
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The delegate.
+ */
+@property (weak, nullable) id<EOSFleetMonitorDelegate> delegate;
+
+/*!
+ @brief The cameras being monitored.
+ */
+@property (readonly) NSArray<EOSCamera*>* cameras;
+
+/*!
+ @brief The time after a camera's last event that it is read as a fallback, in seconds. The default value is 300.
+ */
+@property (nonatomic) NSTimeInterval pollInterval;
+
+/*!
+ @brief Alerts are made when fewer shots than this remain. The default value is 50.
+ */
+@property NSUInteger shotsRemainingThreshold;
+
+/*!
+ @brief Alerts are made when fewer minutes than this remain. The default value is 10.
+ */
+@property double minutesRemainingThreshold;
+
+
+
+///-------------------------
+/// @name Monitoring Cameras
+///-------------------------
+
+/*!
+ @brief Starts monitoring a camera, and reads its volume and battery level.
+ @discussion The camera must have an open session. While it is monitored, the camera's volume info events are registered whether or not its delegate handles them.
+ @param camera The camera.
+ */
+-(void)startMonitoringCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Stops monitoring a camera.
+ @param camera The camera.
+ */
+-(void)stopMonitoringCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Gets a camera's current estimate.
+ @param camera The camera.
+ @return The estimate, or nil if the camera isn't monitored.
+ */
+-(nullable EOSConsumptionEstimate*)estimateForCamera:(EOSCamera*)camera;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
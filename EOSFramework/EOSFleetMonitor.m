@@ -0,0 +1,507 @@
+//
+//  EOSFleetMonitor.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSFleetMonitor.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSVolume.h>
+#import "EOSPrivate.h"
+
+#define EOSFleetMonitorDefaultPollInterval      300.0
+#define EOSFleetMonitorDefaultShotsThreshold    50
+#define EOSFleetMonitorDefaultMinutesThreshold  10.0
+
+//the weight of the newest sample in each running average
+#define EOSFleetMonitorSmoothing                0.3
+
+//the battery level reported while a camera is on mains power
+#define EOSFleetMonitorMainsPower               0xFFFFFFFF
+
+//the consumption model of one camera, guarded by the monitor's queue
+@interface EOSMonitorRecord : NSObject
+
+@property (weak) EOSCamera* camera;
+@property EOSVolume* volume;
+@property BOOL hasAvailableBytes;
+@property UInt64 availableBytes;
+@property NSUInteger batteryLevel;
+@property NSUInteger shotCount;
+@property NSUInteger batteryShotCount;
+@property double bytesPerShot;
+@property double batteryPerShot;
+@property double shotsPerMinute;
+@property NSDate* lastShotDate;
+@property NSDate* lastEventDate;
+@property NSMutableIndexSet* alertedResources;
+
+@end
+
+@implementation EOSMonitorRecord
+@end
+
+
+
+
+@interface EOSConsumptionEstimate ()
+
+-(id)initWithRecord:(EOSMonitorRecord*)record camera:(EOSCamera*)camera;
+
+@end
+
+@implementation EOSConsumptionEstimate{
+
+    NSUInteger _storageShotsRemaining;
+    NSUInteger _batteryShotsRemaining;
+
+}
+
+-(id)initWithRecord:(EOSMonitorRecord *)record camera:(EOSCamera *)camera{
+
+    self = [super init];
+    if (self){
+
+        _camera = camera;
+        _availableBytes = [record availableBytes];
+        _batteryLevel = [record batteryLevel];
+        _bytesPerShot = [record bytesPerShot];
+        _batteryPerShot = [record batteryPerShot];
+        _shotsPerMinute = [record shotsPerMinute];
+
+        _storageShotsRemaining = NSNotFound;
+        _batteryShotsRemaining = NSNotFound;
+
+        if ([record hasAvailableBytes] && _bytesPerShot > 0)
+            _storageShotsRemaining = (NSUInteger)(_availableBytes / _bytesPerShot);
+
+        if (_batteryLevel != NSNotFound && _batteryPerShot > 0)
+            _batteryShotsRemaining = (NSUInteger)(_batteryLevel / _batteryPerShot);
+
+        //NSNotFound is the largest value, so an unknown resource never limits
+        _limitingResource = (_batteryShotsRemaining < _storageShotsRemaining) ? EOSMonitorResource_Battery : EOSMonitorResource_Storage;
+        _shotsRemaining = MIN(_storageShotsRemaining, _batteryShotsRemaining);
+        _minutesRemaining = -1;
+
+        if (_shotsRemaining != NSNotFound && _shotsPerMinute > 0)
+            _minutesRemaining = _shotsRemaining / _shotsPerMinute;
+
+    }
+
+    return self;
+
+}
+
+-(NSUInteger)shotsRemainingForResource:(EOSMonitorResource)resource{
+
+    return (resource == EOSMonitorResource_Battery) ? _batteryShotsRemaining : _storageShotsRemaining;
+
+}
+
+@end
+
+
+
+
+@implementation EOSFleetMonitor{
+
+    dispatch_queue_t _queue;
+    dispatch_source_t _pollTimer;
+    NSMapTable* _records;
+
+}
+
+@synthesize pollInterval = _pollInterval;
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _pollInterval = EOSFleetMonitorDefaultPollInterval;
+        _shotsRemainingThreshold = EOSFleetMonitorDefaultShotsThreshold;
+        _minutesRemainingThreshold = EOSFleetMonitorDefaultMinutesThreshold;
+
+        _queue = dispatch_queue_create("com.EOSFramework.fleetmonitor", DISPATCH_QUEUE_SERIAL);
+
+        //cameras are compared by identity, as they are unique per device
+        _records = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    if (_pollTimer != nil)
+        dispatch_source_cancel(_pollTimer);
+
+    for (EOSCamera* camera in _records){
+
+        [camera setVolumeChangeHandler:nil];
+        [camera setPropertyChangeHandler:nil];
+
+    }
+
+}
+
+-(NSArray*)cameras{
+
+    __block NSArray* cameras;
+
+    dispatch_sync(_queue, ^(void){
+        cameras = [[_records keyEnumerator] allObjects];
+    });
+
+    return cameras;
+
+}
+
+-(void)setPollInterval:(NSTimeInterval)pollInterval{
+
+    dispatch_sync(_queue, ^(void){
+
+        _pollInterval = pollInterval;
+
+        if (_pollTimer != nil)
+            [self schedulePollTimer];
+
+    });
+
+}
+
+-(NSTimeInterval)pollInterval{
+
+    __block NSTimeInterval pollInterval;
+
+    dispatch_sync(_queue, ^(void){
+        pollInterval = _pollInterval;
+    });
+
+    return pollInterval;
+
+}
+
+
+
+
+#pragma mark - Monitoring Cameras
+
+-(void)startMonitoringCamera:(EOSCamera *)camera{
+
+    __block BOOL isMonitored;
+
+    dispatch_sync(_queue, ^(void){
+
+        isMonitored = ([_records objectForKey:camera] != nil);
+
+        if (!isMonitored){
+
+            EOSMonitorRecord* record = [[EOSMonitorRecord alloc] init];
+            [record setCamera:camera];
+            [record setBatteryLevel:NSNotFound];
+            [record setLastEventDate:[NSDate date]];
+            [record setAlertedResources:[NSMutableIndexSet indexSet]];
+            [_records setObject:record forKey:camera];
+
+            if (_pollTimer == nil){
+
+                _pollTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+
+                __weak EOSFleetMonitor* weakSelf = self;
+                dispatch_source_set_event_handler(_pollTimer, ^(void){
+                    [weakSelf pollQuietCameras];
+                });
+
+                [self schedulePollTimer];
+                dispatch_resume(_pollTimer);
+
+            }
+
+        }
+
+    });
+
+    if (isMonitored)
+        return;
+
+    __weak EOSFleetMonitor* weakSelf = self;
+    __weak EOSCamera* weakCamera = camera;
+
+    [camera setVolumeChangeHandler:^(EOSVolume* volume){
+        [weakSelf readVolume:volume ofCamera:weakCamera];
+    }];
+
+    [camera setPropertyChangeHandler:^(EOSProperty property){
+
+        if (property == EOSProperty_BatteryLevel)
+            [weakSelf readBatteryLevelOfCamera:weakCamera];
+
+    }];
+
+    //the first readings are the baseline that later events are compared with
+    [self readVolume:nil ofCamera:camera];
+    [self readBatteryLevelOfCamera:camera];
+
+}
+
+-(void)stopMonitoringCamera:(EOSCamera *)camera{
+
+    dispatch_sync(_queue, ^(void){
+        [_records removeObjectForKey:camera];
+    });
+
+    [camera setVolumeChangeHandler:nil];
+    [camera setPropertyChangeHandler:nil];
+
+}
+
+-(EOSConsumptionEstimate*)estimateForCamera:(EOSCamera *)camera{
+
+    __block EOSConsumptionEstimate* estimate;
+
+    dispatch_sync(_queue, ^(void){
+
+        EOSMonitorRecord* record = [_records objectForKey:camera];
+
+        if (record != nil)
+            estimate = [[EOSConsumptionEstimate alloc] initWithRecord:record camera:camera];
+
+    });
+
+    return estimate;
+
+}
+
+
+
+
+#pragma mark - Reading Cameras
+
+//events arrive on the EDSDK's thread, so the camera is read in the background
+-(void)readVolume:(EOSVolume*)volume ofCamera:(EOSCamera*)camera{
+
+    if (camera == nil)
+        return;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
+
+        __block EOSVolume* readVolume = volume;
+
+        if (readVolume == nil){
+
+            dispatch_sync(_queue, ^(void){
+                readVolume = [[_records objectForKey:camera] volume];
+            });
+
+        }
+
+        if (readVolume == nil)
+            readVolume = [camera volumeAtIndex:0 error:nil];
+
+        EOSVolumeInfo* info = [readVolume info:nil];
+
+        if (info == nil)
+            return;
+
+        dispatch_async(_queue, ^(void){
+            [self recordVolumeInfo:info ofVolume:readVolume camera:camera];
+        });
+
+    });
+
+}
+
+-(void)readBatteryLevelOfCamera:(EOSCamera*)camera{
+
+    if (camera == nil)
+        return;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
+
+        NSNumber* batteryLevel = [camera numberValueForProperty:EOSProperty_BatteryLevel error:nil];
+
+        if (batteryLevel == nil)
+            return;
+
+        dispatch_async(_queue, ^(void){
+            [self recordBatteryLevel:[batteryLevel unsignedIntegerValue] camera:camera];
+        });
+
+    });
+
+}
+
+//called on the queue
+-(void)schedulePollTimer{
+
+    uint64_t interval = (uint64_t)(_pollInterval * NSEC_PER_SEC);
+    dispatch_source_set_timer(_pollTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 10);
+
+}
+
+//called on the queue
+-(void)pollQuietCameras{
+
+    NSDate* now = [NSDate date];
+
+    for (EOSCamera* camera in [[_records keyEnumerator] allObjects]){
+
+        EOSMonitorRecord* record = [_records objectForKey:camera];
+
+        if ([now timeIntervalSinceDate:[record lastEventDate]] < _pollInterval)
+            continue;
+
+        //the poll counts as an event, so a camera that never sends one is read once per interval
+        [record setLastEventDate:now];
+
+        [self readVolume:nil ofCamera:camera];
+        [self readBatteryLevelOfCamera:camera];
+
+    }
+
+}
+
+
+
+
+#pragma mark - Modelling Consumption
+
+//called on the queue
+-(void)recordVolumeInfo:(EOSVolumeInfo*)info ofVolume:(EOSVolume*)volume camera:(EOSCamera*)camera{
+
+    EOSMonitorRecord* record = [_records objectForKey:camera];
+
+    if (record == nil)
+        return;
+
+    NSDate* now = [NSDate date];
+    [record setLastEventDate:now];
+
+    //a different volume, or more space than before, means a new card or deleted files rather than shots
+    if ([record hasAvailableBytes] && [record volume] == volume && [info available] < [record availableBytes]){
+
+        double consumed = [record availableBytes] - [info available];
+        double bytesPerShot = [record bytesPerShot];
+        NSUInteger shots = 1;
+
+        //a polled reading can span several shots
+        if (bytesPerShot > 0)
+            shots = MAX((NSUInteger)llround(consumed / bytesPerShot), 1);
+
+        bytesPerShot = (bytesPerShot > 0) ? bytesPerShot + EOSFleetMonitorSmoothing * (consumed / shots - bytesPerShot) : consumed / shots;
+        [record setBytesPerShot:bytesPerShot];
+
+        if ([record lastShotDate] != nil){
+
+            double minutes = [now timeIntervalSinceDate:[record lastShotDate]] / 60.0;
+
+            if (minutes > 0){
+
+                double rate = shots / minutes;
+                double shotsPerMinute = [record shotsPerMinute];
+                [record setShotsPerMinute:(shotsPerMinute > 0) ? shotsPerMinute + EOSFleetMonitorSmoothing * (rate - shotsPerMinute) : rate];
+
+            }
+
+        }
+
+        [record setShotCount:[record shotCount] + shots];
+        [record setLastShotDate:now];
+
+    }
+
+    [record setVolume:volume];
+    [record setAvailableBytes:[info available]];
+    [record setHasAvailableBytes:YES];
+
+    [self checkRecord:record camera:camera];
+
+}
+
+//called on the queue
+-(void)recordBatteryLevel:(NSUInteger)batteryLevel camera:(EOSCamera*)camera{
+
+    EOSMonitorRecord* record = [_records objectForKey:camera];
+
+    if (record == nil)
+        return;
+
+    [record setLastEventDate:[NSDate date]];
+
+    if (batteryLevel == EOSFleetMonitorMainsPower){
+
+        [record setBatteryLevel:NSNotFound];
+        [self checkRecord:record camera:camera];
+        return;
+
+    }
+
+    NSUInteger previousLevel = [record batteryLevel];
+    NSUInteger shots = [record shotCount] - [record batteryShotCount];
+
+    //the level is coarse, so the drain is spread over every shot since it last changed
+    if (previousLevel != NSNotFound && batteryLevel < previousLevel && shots > 0){
+
+        double drain = (double)(previousLevel - batteryLevel) / shots;
+        double batteryPerShot = [record batteryPerShot];
+        [record setBatteryPerShot:(batteryPerShot > 0) ? batteryPerShot + EOSFleetMonitorSmoothing * (drain - batteryPerShot) : drain];
+
+    }
+
+    if (previousLevel == NSNotFound || batteryLevel != previousLevel)
+        [record setBatteryShotCount:[record shotCount]];
+
+    [record setBatteryLevel:batteryLevel];
+
+    [self checkRecord:record camera:camera];
+
+}
+
+//called on the queue
+-(void)checkRecord:(EOSMonitorRecord*)record camera:(EOSCamera*)camera{
+
+    EOSConsumptionEstimate* estimate = [[EOSConsumptionEstimate alloc] initWithRecord:record camera:camera];
+
+    for (EOSMonitorResource resource = EOSMonitorResource_Storage; resource <= EOSMonitorResource_Battery; resource++){
+
+        NSUInteger shotsRemaining = [estimate shotsRemainingForResource:resource];
+        BOOL isLow = NO;
+
+        if (shotsRemaining != NSNotFound){
+
+            double minutesRemaining = ([estimate shotsPerMinute] > 0) ? shotsRemaining / [estimate shotsPerMinute] : -1;
+            isLow = (shotsRemaining < [self shotsRemainingThreshold] || (minutesRemaining >= 0 && minutesRemaining < [self minutesRemainingThreshold]));
+
+        }
+
+        if (!isLow){
+
+            [[record alertedResources] removeIndex:resource];
+            continue;
+
+        }
+
+        if ([[record alertedResources] containsIndex:resource])
+            continue;
+
+        [[record alertedResources] addIndex:resource];
+
+        dispatch_async(dispatch_get_main_queue(), ^(void){
+
+            id<EOSFleetMonitorDelegate> delegate = [self delegate];
+
+            if ([delegate respondsToSelector:@selector(fleetMonitor:camera:willRunOutOfResource:estimate:)])
+                [delegate fleetMonitor:self camera:camera willRunOutOfResource:resource estimate:estimate];
+
+        });
+
+    }
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,98 @@
+//
+//  EOSFleetResult.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+
+/*!
+ The EOSFleetResult class reports the outcome of an operation performed on several cameras. Instances of this class are created by the fleet methods of EOSManager.
+ */
+@interface EOSFleetResult : NSObject
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The cameras that the operation was performed on.
+ */
+@property (readonly) NSArray<EOSCamera*>* cameras;
+
+/*!
+ @brief The cameras on which the operation succeeded.
+ */
+@property (readonly) NSArray<EOSCamera*>* succeededCameras;
+
+/*!
+ @brief The cameras on which the operation failed.
+ */
+@property (readonly) NSArray<EOSCamera*>* failedCameras;
+
+/*!
+ @brief The time taken to perform the operation on all cameras, in seconds.
+ */
+@property (readonly) NSTimeInterval duration;
+
+/*!
+ @brief Gets the value returned by the operation for a camera.
+ @discussion The type of the value depends on the operation. For example, when a profile is applied, the value is an array of the properties that were changed.
+ @param camera The camera.
+ @return The value, or nil if the operation failed or did not return a value.
+ */
+-(nullable id)valueForCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Gets the error that caused the operation to fail on a camera.
+ @param camera The camera.
+ @return The error, or nil if the operation succeeded.
+ */
+-(nullable NSError*)errorForCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Gets the number of attempts made on a camera.
+ @discussion Attempts that fail because the camera is busy are retried.
+ @param camera The camera.
+ @return The number of attempts.
+ */
+-(NSUInteger)attemptsForCamera:(EOSCamera*)camera;
+
+
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Initializes a newly allocated EOSFleetResult instance.
+ @param cameras The cameras that the operation will be performed on.
+ @return The initialized EOSFleetResult.
+ */
+-(id)initWithCameras:(NSArray<EOSCamera*>*)cameras;
+
+/*!
+ @brief Records the outcome of the operation on a camera.
+ @discussion This method is thread safe.
+ @param camera The camera.
+ @param value The value returned by the operation, or nil.
+ @param error The error that caused the operation to fail, or nil if it succeeded.
+ @param attempts The number of attempts made.
+ */
+-(void)setValue:(nullable id)value error:(nullable NSError*)error attempts:(NSUInteger)attempts forCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Records the time taken to perform the operation on all cameras.
+ @param duration The duration, in seconds.
+ */
+-(void)setDuration:(NSTimeInterval)duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
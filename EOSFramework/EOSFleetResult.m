@@ -0,0 +1,115 @@
+//
+//  EOSFleetResult.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSFleetResult.h>
+#import <EOSFramework/EOSCamera.h>
+
+@implementation EOSFleetResult{
+
+    NSMapTable* _values;
+    NSMapTable* _errors;
+    NSMapTable* _attempts;
+
+}
+
+-(id)initWithCameras:(NSArray *)cameras{
+
+    self = [super init];
+    if (self){
+
+        _cameras = [NSArray arrayWithArray:cameras];
+        _duration = 0;
+
+        //cameras are compared by identity, as they are unique per device
+        _values = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _errors = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _attempts = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+
+    }
+
+    return self;
+
+}
+
+-(void)setValue:(id)value error:(NSError *)error attempts:(NSUInteger)attempts forCamera:(EOSCamera *)camera{
+
+    @synchronized(self){
+
+        if (value != nil)
+            [_values setObject:value forKey:camera];
+
+        if (error != nil)
+            [_errors setObject:error forKey:camera];
+
+        [_attempts setObject:@(attempts) forKey:camera];
+
+    }
+
+}
+
+-(void)setDuration:(NSTimeInterval)duration{
+
+    _duration = duration;
+
+}
+
+-(id)valueForCamera:(EOSCamera *)camera{
+
+    @synchronized(self){
+        return [_values objectForKey:camera];
+    }
+
+}
+
+-(NSError*)errorForCamera:(EOSCamera *)camera{
+
+    @synchronized(self){
+        return [_errors objectForKey:camera];
+    }
+
+}
+
+-(NSUInteger)attemptsForCamera:(EOSCamera *)camera{
+
+    @synchronized(self){
+        return [[_attempts objectForKey:camera] unsignedIntegerValue];
+    }
+
+}
+
+-(NSArray*)succeededCameras{
+
+    NSMutableArray* cameras = [NSMutableArray array];
+
+    for (EOSCamera* camera in _cameras){
+
+        if ([self errorForCamera:camera] == nil)
+            [cameras addObject:camera];
+
+    }
+
+    return [NSArray arrayWithArray:cameras];
+
+}
+
+-(NSArray*)failedCameras{
+
+    NSMutableArray* cameras = [NSMutableArray array];
+
+    for (EOSCamera* camera in _cameras){
+
+        if ([self errorForCamera:camera] != nil)
+            [cameras addObject:camera];
+
+    }
+
+    return [NSArray arrayWithArray:cameras];
+
+}
+
+@end
\ No newline at end of file
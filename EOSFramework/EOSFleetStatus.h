@@ -0,0 +1,140 @@
+//
+//  EOSFleetStatus.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSVolumeInfo;
+
+/*!
+ @brief The fields of an EOSCameraStatus.
+ */
+typedef NS_OPTIONS(NSUInteger, EOSStatusField){
+
+    EOSStatusField_BatteryLevel     = 1 << 0,
+    EOSStatusField_AvailableShots   = 1 << 1,
+    EOSStatusField_VolumeInfo       = 1 << 2,
+    EOSStatusField_AEMode           = 1 << 3,
+    EOSStatusField_LensName         = 1 << 4,
+
+    EOSStatusField_All              = EOSStatusField_BatteryLevel | EOSStatusField_AvailableShots | EOSStatusField_VolumeInfo | EOSStatusField_AEMode | EOSStatusField_LensName
+
+};
+
+
+
+
+/*!
+ The EOSCameraStatus class describes the health of one camera in an EOSFleetStatus.
+ @discussion A field is stale if the camera didn't answer it before the deadline. A stale field holds the value from the most recent snapshot in which it was read, or nil if it has never been read.
+ */
+@interface EOSCameraStatus : NSObject
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The camera.
+ */
+@property (readonly) EOSCamera* camera;
+
+/*!
+ @brief The camera's EOSProperty_BatteryLevel.
+ */
+@property (readonly, nullable) NSNumber* batteryLevel;
+
+/*!
+ @brief The camera's EOSProperty_AvailableShots.
+ */
+@property (readonly, nullable) NSNumber* availableShots;
+
+/*!
+ @brief The information of the camera's first volume.
+ */
+@property (readonly, nullable) EOSVolumeInfo* volumeInfo;
+
+/*!
+ @brief The camera's EOSProperty_AEMode.
+ */
+@property (readonly, nullable) NSNumber* aeMode;
+
+/*!
+ @brief The camera's EOSProperty_LensName.
+ */
+@property (readonly, nullable) NSString* lensName;
+
+/*!
+ @brief The fields that weren't read before the deadline.
+ */
+@property (readonly) EOSStatusField staleFields;
+
+/*!
+ @brief Indicates whether any field is stale.
+ */
+@property (readonly) BOOL isStale;
+
+/*!
+ @brief The error from the first field that the camera failed to read, or nil if there was none.
+ @discussion A field that failed to read is also stale.
+ */
+@property (readonly, nullable) NSError* error;
+
+/*!
+ @brief Gets the time that a field was read.
+ @param field A single EOSStatusField.
+ @return The time, or nil if the field has never been read.
+ */
+-(nullable NSDate*)dateForField:(EOSStatusField)field;
+
+@end
+
+
+
+
+/*!
+ The EOSFleetStatus class is an immutable snapshot of the health of several cameras. Instances of this class are created by [EOSManager collectStatusOfCameras:deadline:completion:].
+ */
+@interface EOSFleetStatus : NSObject
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The time that the snapshot was taken.
+ */
+@property (readonly) NSDate* date;
+
+/*!
+ @brief The time taken to collect the snapshot, in seconds.
+ */
+@property (readonly) NSTimeInterval duration;
+
+/*!
+ @brief The status of each camera, in the order that the cameras were given.
+ */
+@property (readonly) NSArray<EOSCameraStatus*>* cameraStatuses;
+
+/*!
+ @brief The cameras that have at least one stale field.
+ */
+@property (readonly) NSArray<EOSCamera*>* staleCameras;
+
+/*!
+ @brief Gets the status of a camera.
+ @param camera The camera.
+ @return The status, or nil if the camera isn't part of the snapshot.
+ */
+-(nullable EOSCameraStatus*)statusForCamera:(EOSCamera*)camera;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
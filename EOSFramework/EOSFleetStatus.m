@@ -0,0 +1,117 @@
+//
+//  EOSFleetStatus.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSFleetStatus.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSVolume.h>
+#import "EOSPrivate.h"
+
+@implementation EOSCameraStatus{
+
+    NSDictionary* _values;
+    NSDictionary* _dates;
+
+}
+
+-(id)initWithCamera:(EOSCamera *)camera values:(NSDictionary *)values dates:(NSDictionary *)dates staleFields:(EOSStatusField)staleFields error:(NSError *)error{
+
+    self = [super init];
+    if (self){
+
+        _camera = camera;
+        _values = [values copy];
+        _dates = [dates copy];
+        _staleFields = staleFields;
+        _error = error;
+
+    }
+
+    return self;
+
+}
+
+-(NSNumber*)batteryLevel{
+    return [_values objectForKey:@(EOSStatusField_BatteryLevel)];
+}
+
+-(NSNumber*)availableShots{
+    return [_values objectForKey:@(EOSStatusField_AvailableShots)];
+}
+
+-(EOSVolumeInfo*)volumeInfo{
+    return [_values objectForKey:@(EOSStatusField_VolumeInfo)];
+}
+
+-(NSNumber*)aeMode{
+    return [_values objectForKey:@(EOSStatusField_AEMode)];
+}
+
+-(NSString*)lensName{
+    return [_values objectForKey:@(EOSStatusField_LensName)];
+}
+
+-(BOOL)isStale{
+    return _staleFields != 0;
+}
+
+-(NSDate*)dateForField:(EOSStatusField)field{
+    return [_dates objectForKey:@(field)];
+}
+
+@end
+
+
+
+
+@implementation EOSFleetStatus
+
+-(id)initWithDate:(NSDate *)date duration:(NSTimeInterval)duration cameraStatuses:(NSArray *)cameraStatuses{
+
+    self = [super init];
+    if (self){
+
+        _date = date;
+        _duration = duration;
+        _cameraStatuses = [NSArray arrayWithArray:cameraStatuses];
+
+    }
+
+    return self;
+
+}
+
+-(NSArray*)staleCameras{
+
+    NSMutableArray* cameras = [NSMutableArray array];
+
+    for (EOSCameraStatus* status in _cameraStatuses){
+
+        if ([status isStale])
+            [cameras addObject:[status camera]];
+
+    }
+
+    return [NSArray arrayWithArray:cameras];
+
+}
+
+-(EOSCameraStatus*)statusForCamera:(EOSCamera *)camera{
+
+    //cameras are compared by identity, as they are unique per device
+    for (EOSCameraStatus* status in _cameraStatuses){
+
+        if ([status camera] == camera)
+            return status;
+
+    }
+
+    return nil;
+
+}
+
+@end
\ No newline at end of file
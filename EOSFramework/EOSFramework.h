@@ -20,5 +20,26 @@ FOUNDATION_EXPORT const unsigned char EOSFrameworkVersionString[];
 #import <EOSFramework/EOSVolume.h>
 #import <EOSFramework/EOSFile.h>
 #import <EOSFramework/EOSImage.h>
+#import <EOSFramework/EOSFileMigrator.h>
+#import <EOSFramework/EOSDownloadJournal.h>
+#import <EOSFramework/EOSCatalog.h>
+#import <EOSFramework/EOSCameraProfile.h>
+#import <EOSFramework/EOSFleetResult.h>
+#import <EOSFramework/EOSFleetStatus.h>
+#import <EOSFramework/EOSFleetMonitor.h>
+#import <EOSFramework/EOSDaemon.h>
+#import <EOSFramework/EOSDaemonClient.h>
+#import <EOSFramework/EOSSharedRing.h>
+#import <EOSFramework/EOSClockSync.h>
+#import <EOSFramework/EOSGeotag.h>
+#import <EOSFramework/EOSWatchdog.h>
+#import <EOSFramework/EOSRefTracker.h>
+#import <EOSFramework/EOSCapabilityCache.h>
+#import <EOSFramework/EOSDeviceRegistry.h>
+#import <EOSFramework/EOSHostCapture.h>
+#import <EOSFramework/EOSDirectTransfer.h>
+#import <EOSFramework/EOSPropertyHistory.h>
+#import <EOSFramework/EOSLogger.h>
+#import <EOSFramework/EOSProcessingPipeline.h>
 
 #import <EOSFramework/EOSError.h>
\ No newline at end of file
@@ -0,0 +1,122 @@
+//
+//  EOSGeotag.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+#import <EOSFramework/EOSPropertyObject.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSFleetResult;
+
+/*!
+ The EOSGeotag class describes a GPS position, packed into the values of the camera's GPS properties.
+ @discussion The position is packed once, when the geotag is created, into the rational arrays and strings that the camera expects: EOSProperty_GPSLatitude and EOSProperty_GPSLongitude as degrees, minutes and seconds with their references, EOSProperty_GPSAltitude with its reference, and the UTC date and time of the fix. Geotags are immutable, so one geotag can be written to any number of cameras.
+ */
+@interface EOSGeotag : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Initializes a geotag.
+ @param latitude The latitude in degrees, positive to the north.
+ @param longitude The longitude in degrees, positive to the east.
+ @param altitude The altitude in metres above sea level, or NAN if it is unknown.
+ @param date The time of the fix.
+ @return The initialized EOSGeotag, or nil if the latitude or longitude is out of range.
+ */
+-(nullable id)initWithLatitude:(double)latitude longitude:(double)longitude altitude:(double)altitude date:(NSDate*)date;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The latitude in degrees, positive to the north.
+ */
+@property (readonly) double latitude;
+
+/*!
+ @brief The longitude in degrees, positive to the east.
+ */
+@property (readonly) double longitude;
+
+/*!
+ @brief The altitude in metres above sea level, or NAN if it is unknown.
+ */
+@property (readonly) double altitude;
+
+/*!
+ @brief The time of the fix.
+ */
+@property (readonly) NSDate* date;
+
+/*!
+ @brief The GPS properties written by the geotag, in the order that they are written.
+ @discussion An array of NSNumber objects containing EOSProperty values. EOSProperty_GPSStatus is written last, so the position is only marked as valid once every other field has been written.
+ */
+@property (readonly) NSArray<NSNumber*>* properties;
+
+/*!
+ @brief Gets the packed value of a property.
+ @param property The property.
+ @return The value, or nil if the geotag doesn't write the property.
+ */
+-(nullable NSData*)valueForProperty:(EOSProperty)property;
+
+@end
+
+
+
+/*!
+ The EOSGeotagWriter class writes geotags to cameras.
+ @discussion The writer remembers the values that it last wrote to each camera, and only writes the fields that have changed. A moving rig only has to update its position and time, not the datum, references and version. If a write fails, the camera's state is unknown, so every field is written the next time.
+
+ When geotags are written to several cameras, each camera writes the newest geotag at the time that its write starts. Updates that arrive faster than a camera can be written are coalesced, rather than queued behind each other, so position updates never build up and delay other camera operations.
+
+ Cameras must have an open session.
+ */
+@interface EOSGeotagWriter : NSObject
+
+/*!
+ @brief The maximum number of cameras that are written to at once. The default value is 8.
+ */
+@property NSUInteger maxConcurrentOperations;
+
+/*!
+ @brief Writes a geotag to a camera.
+ @discussion This method is synchronous.
+ @param geotag The geotag.
+ @param camera The camera.
+ @param changedProperties If not NULL, on return this contains the properties that were written.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)writeGeotag:(EOSGeotag*)geotag toCamera:(EOSCamera*)camera changedProperties:(NSArray<NSNumber*>* __autoreleasing _Nullable * _Nullable)changedProperties error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Writes a geotag to several cameras in parallel.
+ @param geotag The geotag.
+ @param cameras The cameras.
+ @param completion A block that is called on the main thread once every camera has been written to. The value for each camera is an array of the properties that were written, which is empty if a newer geotag had already been written.
+ */
+-(void)writeGeotag:(EOSGeotag*)geotag toCameras:(NSArray<EOSCamera*>*)cameras completion:(nullable void (^)(EOSFleetResult* result))completion;
+
+/*!
+ @brief Forgets the values written to a camera, so that every field is written the next time.
+ @param camera The camera.
+ */
+-(void)resetCamera:(EOSCamera*)camera;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,251 @@
+//
+//  EOSGeotag.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSGeotag.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSManager.h>
+#import <EOSFramework/EOSFleetResult.h>
+#import <EOSFramework/EOSError.h>
+#import <EDSDK/EDSDK.h>
+
+#define EOSGeotagDefaultConcurrency 8
+
+static NSData* EOSGeotagString(const char* string){
+
+    //strings are written with their terminator
+    return [NSData dataWithBytes:string length:strlen(string) + 1];
+
+}
+
+//degrees, minutes and thousandths of seconds
+static NSData* EOSGeotagDegrees(double value){
+
+    double degrees = fabs(value);
+    UInt32 milliseconds = (UInt32)llround(degrees * 3600000.0);
+
+    EdsRational rationals[3];
+    rationals[0] = (EdsRational){(EdsInt32)(milliseconds / 3600000), 1};
+    rationals[1] = (EdsRational){(EdsInt32)(milliseconds / 60000 % 60), 1};
+    rationals[2] = (EdsRational){(EdsInt32)(milliseconds % 60000), 1000};
+
+    return [NSData dataWithBytes:rationals length:sizeof(rationals)];
+
+}
+
+@implementation EOSGeotag{
+
+    NSDictionary* _values;
+
+}
+
+-(id)initWithLatitude:(double)latitude longitude:(double)longitude altitude:(double)altitude date:(NSDate *)date{
+
+    if (!(fabs(latitude) <= 90) || !(fabs(longitude) <= 180))
+        return nil;
+
+    self = [super init];
+    if (self){
+
+        _latitude = latitude;
+        _longitude = longitude;
+        _altitude = altitude;
+        _date = date;
+
+        NSMutableArray* properties = [NSMutableArray array];
+        NSMutableDictionary* values = [NSMutableDictionary dictionary];
+
+        void (^add)(EOSProperty, NSData*) = ^(EOSProperty property, NSData* value){
+
+            [properties addObject:@(property)];
+            [values setObject:value forKey:@(property)];
+
+        };
+
+        UInt8 version[4] = {2, 3, 0, 0};
+
+        add(EOSProperty_GPSVersionID, [NSData dataWithBytes:version length:sizeof(version)]);
+        add(EOSProperty_GPSMapDatum, EOSGeotagString("WGS-84"));
+        add(EOSProperty_GPSLatitudeRef, EOSGeotagString(latitude < 0 ? "S" : "N"));
+        add(EOSProperty_GPSLatitude, EOSGeotagDegrees(latitude));
+        add(EOSProperty_GPSLongitudeRef, EOSGeotagString(longitude < 0 ? "W" : "E"));
+        add(EOSProperty_GPSLongitude, EOSGeotagDegrees(longitude));
+
+        if (!isnan(altitude)){
+
+            UInt8 altitudeRef = altitude < 0 ? 1 : 0;
+            EdsRational altitudeRational = {(EdsInt32)llround(fabs(altitude) * 100), 100};
+
+            add(EOSProperty_GPSAltitudeRef, [NSData dataWithBytes:&altitudeRef length:sizeof(altitudeRef)]);
+            add(EOSProperty_GPSAltitude, [NSData dataWithBytes:&altitudeRational length:sizeof(altitudeRational)]);
+
+        }
+
+        //the date and time are UTC
+        NSCalendar* calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+        [calendar setTimeZone:[NSTimeZone timeZoneWithAbbreviation:@"UTC"]];
+
+        NSCalendarUnit units = NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay | NSCalendarUnitHour | NSCalendarUnitMinute | NSCalendarUnitSecond | NSCalendarUnitNanosecond;
+        NSDateComponents* components = [calendar components:units fromDate:date];
+
+        EdsRational timeStamp[3];
+        timeStamp[0] = (EdsRational){(EdsInt32)[components hour], 1};
+        timeStamp[1] = (EdsRational){(EdsInt32)[components minute], 1};
+        timeStamp[2] = (EdsRational){(EdsInt32)([components second] * 1000 + [components nanosecond] / 1000000), 1000};
+
+        char dateStamp[16];
+        snprintf(dateStamp, sizeof(dateStamp), "%04ld:%02ld:%02ld", (long)[components year], (long)[components month], (long)[components day]);
+
+        add(EOSProperty_GPSDateStamp, EOSGeotagString(dateStamp));
+        add(EOSProperty_GPSTimeStamp, [NSData dataWithBytes:timeStamp length:sizeof(timeStamp)]);
+        add(EOSProperty_GPSStatus, EOSGeotagString("A"));
+
+        _properties = [NSArray arrayWithArray:properties];
+        _values = [NSDictionary dictionaryWithDictionary:values];
+
+    }
+
+    return self;
+
+}
+
+-(NSData*)valueForProperty:(EOSProperty)property{
+
+    return [_values objectForKey:@(property)];
+
+}
+
+-(NSString*)description{
+
+    return [NSString stringWithFormat:@"<%@: %.6f, %.6f>", [self class], _latitude, _longitude];
+
+}
+
+@end
+
+
+
+
+@implementation EOSGeotagWriter{
+
+    dispatch_queue_t _queue;
+    NSMapTable* _writtenValues;
+    NSMapTable* _latestGeotags;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _maxConcurrentOperations = EOSGeotagDefaultConcurrency;
+        _queue = dispatch_queue_create("com.EOSFramework.geotag", DISPATCH_QUEUE_SERIAL);
+        _writtenValues = [NSMapTable weakToStrongObjectsMapTable];
+        _latestGeotags = [NSMapTable weakToStrongObjectsMapTable];
+
+    }
+
+    return self;
+
+}
+
+-(BOOL)writeGeotag:(EOSGeotag *)geotag toCamera:(EOSCamera *)camera changedProperties:(NSArray *__autoreleasing *)changedProperties error:(NSError *__autoreleasing *)error{
+
+    __block NSMutableDictionary* writtenValues;
+
+    dispatch_sync(_queue, ^(void){
+
+        writtenValues = [_writtenValues objectForKey:camera];
+
+        if (writtenValues == nil){
+
+            writtenValues = [NSMutableDictionary dictionary];
+            [_writtenValues setObject:writtenValues forKey:camera];
+
+        }
+
+    });
+
+    NSMutableArray* changed = [NSMutableArray array];
+    BOOL success = YES;
+
+    @synchronized(writtenValues){
+
+        for (NSNumber* property in [geotag properties]){
+
+            NSData* value = [geotag valueForProperty:[property unsignedIntegerValue]];
+
+            if ([[writtenValues objectForKey:property] isEqualToData:value])
+                continue;
+
+            if (![camera setValue:[value bytes] ofSize:[value length] forProperty:[property unsignedIntegerValue] withParameter:0 error:error]){
+
+                success = NO;
+                break;
+
+            }
+
+            [writtenValues setObject:value forKey:property];
+            [changed addObject:property];
+
+        }
+
+        //the camera may hold a mixture of old and new values
+        if (!success)
+            [writtenValues removeAllObjects];
+
+    }
+
+    if (changedProperties)
+        *changedProperties = [NSArray arrayWithArray:changed];
+
+    return success;
+
+}
+
+-(void)writeGeotag:(EOSGeotag *)geotag toCameras:(NSArray *)cameras completion:(void (^)(EOSFleetResult *))completion{
+
+    dispatch_sync(_queue, ^(void){
+
+        for (EOSCamera* camera in cameras)
+            [_latestGeotags setObject:geotag forKey:camera];
+
+    });
+
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        //a newer geotag may have arrived while this write was waiting
+        __block EOSGeotag* latestGeotag;
+
+        dispatch_sync(_queue, ^(void){
+            latestGeotag = [_latestGeotags objectForKey:camera];
+        });
+
+        NSArray* changedProperties;
+
+        if (![self writeGeotag:latestGeotag ?: geotag toCamera:camera changedProperties:&changedProperties error:error])
+            return nil;
+
+        return changedProperties;
+
+    } onCameras:cameras maxConcurrentOperations:_maxConcurrentOperations completion:completion];
+
+}
+
+-(void)resetCamera:(EOSCamera *)camera{
+
+    dispatch_sync(_queue, ^(void){
+
+        [_writtenValues removeObjectForKey:camera];
+        [_latestGeotags removeObjectForKey:camera];
+
+    });
+
+}
+
+@end
\ No newline at end of file
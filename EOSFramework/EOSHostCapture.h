@@ -0,0 +1,146 @@
+//
+//  EOSHostCapture.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+@class EOSFile;
+@class EOSHostCapture;
+
+/*!
+ The EOSHostCaptureDelegate protocol receives the images captured by an EOSHostCapture.
+ @discussion The methods are called on a serial queue belonging to the capture, not on the main thread.
+ */
+@protocol EOSHostCaptureDelegate <NSObject>
+
+@optional
+
+/*!
+ @brief Called when an image has been transferred into memory.
+ @discussion The data is backed by one of the capture's buffers, which is reused as soon as this method returns. Copy the data to keep it. Transfers wait for a free buffer, so a slow implementation slows the camera rather than using more memory.
+ @param capture The capture.
+ @param data The image.
+ @param name The image's filename on the camera.
+ */
+-(void)hostCapture:(EOSHostCapture*)capture didCaptureData:(NSData*)data name:(NSString*)name;
+
+/*!
+ @brief Called when an image has been transferred to disk.
+ @param capture The capture.
+ @param url The location of the image.
+ */
+-(void)hostCapture:(EOSHostCapture*)capture didCaptureFileAtURL:(NSURL*)url;
+
+/*!
+ @brief Called when an image could not be transferred. The camera discards the image.
+ @param capture The capture.
+ @param file The image on the camera.
+ @param error An instance of NSError describing the problem.
+ */
+-(void)hostCapture:(EOSHostCapture*)capture didFailToCaptureFile:(EOSFile*)file error:(NSError*)error;
+
+@end
+
+
+
+/*!
+ The EOSHostCapture class captures images straight to the host, bypassing the camera's memory card.
+ @discussion While the capture is running, the camera's EOSProperty_CaptureDestination is set to EOSCaptureDestination_Host, and the free space on the host is advertised to the camera, so it doesn't stop shooting when its card is full or missing. Each image that the camera asks to transfer is downloaded in the order it was shot, either into a pool of reusable memory buffers or straight to a file in directoryURL, and passed to the delegate.
+
+ During a burst, the camera's buffer holds the images that are waiting to be transferred. When every memory buffer is in use, transfers wait, which lets the camera's buffer fill and the camera slow down, rather than letting the host's memory grow. A sustained burst is limited by the speed of the USB link rather than by the card.
+
+ The camera must have an open session. Capture requests made through the delegate method camera:didRequestTransferOfFile: of EOSCameraDelegate are not made while a capture is running.
+ */
+@interface EOSHostCapture : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Initializes a capture.
+ @param camera The camera.
+ @return The initialized EOSHostCapture.
+ */
+-(id)initWithCamera:(EOSCamera*)camera;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The camera.
+ */
+@property (readonly, weak) EOSCamera* camera;
+
+/*!
+ @brief The delegate.
+ */
+@property (weak, nullable) id<EOSHostCaptureDelegate> delegate;
+
+/*!
+ @brief The directory to write images to, or nil to capture them into memory. The default value is nil.
+ @discussion Changes take effect when the capture is started.
+ */
+@property (copy, nullable) NSURL* directoryURL;
+
+/*!
+ @brief The number of memory buffers in the pool. The default value is 4.
+ @discussion Changes take effect when the capture is started.
+ */
+@property NSUInteger bufferCount;
+
+/*!
+ @brief The size of each memory buffer, in bytes. The default value is 64MB.
+ @discussion An image larger than a buffer is transferred into a buffer of its own, which still counts against the pool. Changes take effect when the capture is started.
+ */
+@property NSUInteger bufferSize;
+
+/*!
+ @brief Indicates whether the capture is running.
+ */
+@property (readonly) BOOL isRunning;
+
+/*!
+ @brief The number of images that the camera has asked to transfer and that have not yet been passed to the delegate.
+ */
+@property (readonly) NSUInteger pendingCount;
+
+/*!
+ @brief The number of images that have been captured since the capture was started.
+ */
+@property (readonly) NSUInteger capturedCount;
+
+
+
+///--------------
+/// @name Running
+///--------------
+
+/*!
+ @brief Starts capturing to the host.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)start:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Stops capturing to the host, and restores the camera's previous capture destination.
+ @discussion Images that the camera has already asked to transfer are still passed to the delegate.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)stop:(NSError* __autoreleasing*)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,408 @@
+//
+//  EOSHostCapture.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSHostCapture.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSFile.h>
+#import <EOSFramework/EOSError.h>
+#import <EDSDK/EDSDK.h>
+#import "EOSPrivate.h"
+
+#define EOSHostCaptureDefaultBufferCount    4
+#define EOSHostCaptureDefaultBufferSize     (64 * 1024 * 1024)
+#define EOSHostCaptureBytesPerSector        512
+
+@implementation EOSHostCapture{
+
+    //one transfer at a time, as they share the camera's link
+    dispatch_queue_t _transferQueue;
+    dispatch_queue_t _deliveryQueue;
+
+    //counts the free buffers, so transfers wait when the delegate falls behind
+    dispatch_semaphore_t _bufferSemaphore;
+    NSMutableArray* _buffers;
+    NSUInteger _poolBufferSize;
+
+    NSURL* _captureDirectoryURL;
+    NSNumber* _previousDestination;
+
+    BOOL _isRunning;
+    NSUInteger _pendingCount;
+    NSUInteger _capturedCount;
+    NSUInteger _queuedCount;
+
+}
+
+-(id)initWithCamera:(EOSCamera *)camera{
+
+    self = [super init];
+    if (self){
+
+        _camera = camera;
+        _bufferCount = EOSHostCaptureDefaultBufferCount;
+        _bufferSize = EOSHostCaptureDefaultBufferSize;
+        _transferQueue = dispatch_queue_create("com.EOSFramework.hostcapture.transfer", DISPATCH_QUEUE_SERIAL);
+        _deliveryQueue = dispatch_queue_create("com.EOSFramework.hostcapture.delivery", DISPATCH_QUEUE_SERIAL);
+
+    }
+
+    return self;
+
+}
+
+-(BOOL)isRunning{
+
+    @synchronized(self){
+        return _isRunning;
+    }
+
+}
+
+-(NSUInteger)pendingCount{
+
+    @synchronized(self){
+        return _pendingCount;
+    }
+
+}
+
+-(NSUInteger)capturedCount{
+
+    @synchronized(self){
+        return _capturedCount;
+    }
+
+}
+
+
+
+
+#pragma mark - Running
+
+-(BOOL)start:(NSError *__autoreleasing *)error{
+
+    EOSCamera* camera = _camera;
+
+    @synchronized(self){
+
+        if (_isRunning)
+            return YES;
+
+    }
+
+    NSNumber* previousDestination = [camera numberValueForProperty:EOSProperty_CaptureDestination error:error];
+
+    if (previousDestination == nil)
+        return NO;
+
+    NSURL* directoryURL = [self directoryURL];
+
+    if (directoryURL != nil && ![[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:error])
+        return NO;
+
+    //the handler is installed first, so no transfer request is missed
+    __weak EOSHostCapture* weakSelf = self;
+
+    [camera setTransferRequestHandler:^(EOSFile* file){
+        [weakSelf enqueueFile:file];
+    }];
+
+    EdsUInt32 destination = EOSCaptureDestination_Host;
+
+    if (![camera setValue:&destination ofSize:sizeof(destination) forProperty:EOSProperty_CaptureDestination withParameter:0 error:error] || ![self advertiseCapacityOfCamera:camera directoryURL:directoryURL error:error]){
+
+        [camera setTransferRequestHandler:nil];
+
+        EdsUInt32 previous = [previousDestination unsignedIntValue];
+        [camera setValue:&previous ofSize:sizeof(previous) forProperty:EOSProperty_CaptureDestination withParameter:0 error:nil];
+
+        return NO;
+
+    }
+
+    @synchronized(self){
+
+        _isRunning = YES;
+        _capturedCount = 0;
+        _previousDestination = previousDestination;
+        _captureDirectoryURL = directoryURL;
+
+        //transfers still waiting from a previous run hold their own buffers
+        if (directoryURL == nil){
+
+            NSUInteger bufferCount = MAX([self bufferCount], 1);
+
+            _poolBufferSize = [self bufferSize];
+            _buffers = [NSMutableArray arrayWithCapacity:bufferCount];
+            _bufferSemaphore = dispatch_semaphore_create(bufferCount);
+
+            //the pages aren't touched until an image is transferred into them
+            for (NSUInteger i = 0; i < bufferCount; i++)
+                [_buffers addObject:[NSMutableData dataWithLength:_poolBufferSize]];
+
+        }
+
+    }
+
+    return YES;
+
+}
+
+-(BOOL)stop:(NSError *__autoreleasing *)error{
+
+    EOSCamera* camera = _camera;
+    NSNumber* previousDestination;
+
+    @synchronized(self){
+
+        if (!_isRunning)
+            return YES;
+
+        _isRunning = NO;
+        previousDestination = _previousDestination;
+
+    }
+
+    [camera setTransferRequestHandler:nil];
+
+    EdsUInt32 destination = [previousDestination unsignedIntValue];
+
+    return [camera setValue:&destination ofSize:sizeof(destination) forProperty:EOSProperty_CaptureDestination withParameter:0 error:error];
+
+}
+
+//the camera stops shooting when it believes the host is full
+-(BOOL)advertiseCapacityOfCamera:(EOSCamera*)camera directoryURL:(NSURL*)directoryURL error:(NSError* __autoreleasing*)error{
+
+    UInt64 available = (UInt64)INT32_MAX * EOSHostCaptureBytesPerSector;
+
+    if (directoryURL != nil){
+
+        NSNumber* capacity;
+
+        if ([directoryURL getResourceValue:&capacity forKey:NSURLVolumeAvailableCapacityKey error:nil] && capacity != nil)
+            available = MIN([capacity unsignedLongLongValue], available);
+
+    }
+
+    EdsCapacity capacity;
+    capacity.numberOfFreeClusters = (EdsInt32)(available / EOSHostCaptureBytesPerSector);
+    capacity.bytesPerSector = EOSHostCaptureBytesPerSector;
+    capacity.reset = true;
+
+    EOSError errorCode = EOSWatchdogCall(camera, EOSWatchdogDeadline_Call, EdsSetCapacity([camera baseRef], capacity));
+
+    if (errorCode != EOSError_OK){
+
+        if (error)
+            *error = EOSCreateError(errorCode);
+        return NO;
+
+    }
+
+    return YES;
+
+}
+
+
+
+
+#pragma mark - Transferring
+
+//called on the thread that delivers the camera's events, so it mustn't wait
+-(void)enqueueFile:(EOSFile*)file{
+
+    NSUInteger queuedCount;
+
+    @synchronized(self){
+
+        _pendingCount++;
+        queuedCount = ++_queuedCount;
+
+    }
+
+    if (EOSFRAMEWORK_QUEUE_ENQUEUE_ENABLED())
+        EOSFRAMEWORK_QUEUE_ENQUEUE("hostcapture", EOSProbeSerialNumber(file), queuedCount);
+
+    dispatch_async(_transferQueue, ^(void){
+        [self transferFile:file];
+    });
+
+}
+
+-(void)transferFile:(EOSFile*)file{
+
+    NSURL* directoryURL;
+    dispatch_semaphore_t bufferSemaphore;
+    NSUInteger queuedCount;
+
+    @synchronized(self){
+
+        directoryURL = _captureDirectoryURL;
+        bufferSemaphore = _bufferSemaphore;
+        queuedCount = --_queuedCount;
+
+    }
+
+    if (EOSFRAMEWORK_QUEUE_DEQUEUE_ENABLED())
+        EOSFRAMEWORK_QUEUE_DEQUEUE("hostcapture", EOSProbeSerialNumber(file), queuedCount);
+
+    NSError* error;
+
+    if (directoryURL != nil){
+
+        NSURL* url = [self destinationURLForFile:file directoryURL:directoryURL error:&error];
+
+        if (url == nil || ![file downloadToURL:url error:&error]){
+
+            [self failToTransferFile:file error:error];
+            return;
+
+        }
+
+        dispatch_async(_deliveryQueue, ^(void){
+
+            id<EOSHostCaptureDelegate> delegate = [self delegate];
+
+            if ([delegate respondsToSelector:@selector(hostCapture:didCaptureFileAtURL:)])
+                [delegate hostCapture:self didCaptureFileAtURL:url];
+
+            [self didDeliverFile];
+
+        });
+
+        return;
+
+    }
+
+    //wait for the delegate to return a buffer
+    dispatch_semaphore_wait(bufferSemaphore, DISPATCH_TIME_FOREVER);
+
+    NSMutableData* buffer = [self takeBufferForFile:file error:&error];
+    NSUInteger length = 0;
+
+    if (buffer == nil || ![file downloadIntoBytes:[buffer mutableBytes] capacity:[buffer length] length:&length error:&error]){
+
+        [self returnBuffer:buffer semaphore:bufferSemaphore];
+        [self failToTransferFile:file error:error];
+        return;
+
+    }
+
+    NSString* name = [[file info:nil] name] ?: @"";
+
+    dispatch_async(_deliveryQueue, ^(void){
+
+        id<EOSHostCaptureDelegate> delegate = [self delegate];
+
+        if ([delegate respondsToSelector:@selector(hostCapture:didCaptureData:name:)]){
+
+            NSData* data = [NSData dataWithBytesNoCopy:[buffer mutableBytes] length:length freeWhenDone:NO];
+            [delegate hostCapture:self didCaptureData:data name:name];
+
+        }
+
+        [self returnBuffer:buffer semaphore:bufferSemaphore];
+        [self didDeliverFile];
+
+    });
+
+}
+
+-(NSMutableData*)takeBufferForFile:(EOSFile*)file error:(NSError* __autoreleasing*)error{
+
+    EOSFileInfo* info = [file info:error];
+
+    if (info == nil)
+        return nil;
+
+    NSMutableData* buffer;
+
+    @synchronized(self){
+
+        //an oversized image gets a buffer of its own, but still takes a place in the pool
+        if ([info size] > _poolBufferSize)
+            return [NSMutableData dataWithLength:[info size]];
+
+        buffer = [_buffers lastObject];
+        [_buffers removeLastObject];
+
+    }
+
+    return buffer;
+
+}
+
+-(void)returnBuffer:(NSMutableData*)buffer semaphore:(dispatch_semaphore_t)semaphore{
+
+    @synchronized(self){
+
+        //buffers from a previous run, or oversized ones, aren't kept
+        if (buffer != nil && semaphore == _bufferSemaphore && [buffer length] == _poolBufferSize)
+            [_buffers addObject:buffer];
+
+    }
+
+    dispatch_semaphore_signal(semaphore);
+
+}
+
+-(NSURL*)destinationURLForFile:(EOSFile*)file directoryURL:(NSURL*)directoryURL error:(NSError* __autoreleasing*)error{
+
+    EOSFileInfo* info = [file info:error];
+
+    if (info == nil)
+        return nil;
+
+    NSString* name = [info name];
+    NSURL* url = [directoryURL URLByAppendingPathComponent:name];
+
+    //the camera's file numbers wrap around during long sessions
+    for (NSUInteger i = 1; [[NSFileManager defaultManager] fileExistsAtPath:[url path]]; i++){
+
+        NSString* uniqueName = [NSString stringWithFormat:@"%@-%lu.%@", [name stringByDeletingPathExtension], (unsigned long)i, [name pathExtension]];
+        url = [directoryURL URLByAppendingPathComponent:uniqueName];
+
+    }
+
+    return url;
+
+}
+
+-(void)failToTransferFile:(EOSFile*)file error:(NSError*)error{
+
+    //the camera holds the image in its buffer until the transfer is completed or cancelled
+    [file cancelTransfer:nil];
+
+    dispatch_async(_deliveryQueue, ^(void){
+
+        id<EOSHostCaptureDelegate> delegate = [self delegate];
+
+        if ([delegate respondsToSelector:@selector(hostCapture:didFailToCaptureFile:error:)])
+            [delegate hostCapture:self didFailToCaptureFile:file error:error ?: EOSCreateError(EOSError_InternalError)];
+
+        @synchronized(self){
+            _pendingCount--;
+        }
+
+    });
+
+}
+
+-(void)didDeliverFile{
+
+    @synchronized(self){
+
+        _pendingCount--;
+        _capturedCount++;
+
+    }
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,129 @@
+//
+//  EOSLogger.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @brief Log levels. A message is logged if its level is at or below the logger's level.
+ */
+typedef NS_ENUM(NSInteger, EOSLogLevel){
+
+    EOSLogLevel_Off,
+    EOSLogLevel_Error,
+    EOSLogLevel_Warning,
+    EOSLogLevel_Info,
+    EOSLogLevel_Debug
+
+};
+
+/*!
+ @brief Log formats.
+ */
+typedef NS_ENUM(NSUInteger, EOSLogFormat){
+
+    EOSLogFormat_JSONLines,     //one JSON object per line, with the keys time, level, op, camera, latencyNanoseconds and message
+    EOSLogFormat_Binary         //consecutive EOSLogRecord structs, in the host's byte order
+
+};
+
+/*!
+ @brief The layout of a log entry in EOSLogFormat_Binary.
+ @discussion Strings are UTF-8, and are truncated to fit and terminated with a zero byte.
+ */
+typedef struct{
+
+    uint64_t time;                  //nanoseconds since 1970
+    uint64_t latencyNanoseconds;    //0 if the entry has no latency
+    uint32_t level;                 //an EOSLogLevel
+    char op[28];
+    char camera[32];
+    char message[184];
+
+} EOSLogRecord;
+
+
+
+
+/*!
+ The EOSLogger class controls the framework's log.
+ @discussion The framework logs its sessions, its EDSDK calls (at EOSLogLevel_Debug, with their latency) and cameras that hang. Each thread that logs writes into a ring of its own without taking a lock, and a background thread drains the rings into the log file. When a thread logs faster than the rings are drained, its newest entries are dropped rather than slowing it down. A message that is above the logger's level costs a single comparison, so logging can be left on.
+ */
+@interface EOSLogger : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the singleton instance of EOSLogger.
+ @return The singleton instance of EOSLogger.
+ */
++(EOSLogger*)sharedLogger;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The most detailed level that is logged. The default value is EOSLogLevel_Off.
+ @discussion This can be changed at any time, and takes effect immediately on every thread.
+ */
+@property EOSLogLevel level;
+
+/*!
+ @brief The format of the log. The default value is EOSLogFormat_JSONLines.
+ */
+@property EOSLogFormat format;
+
+/*!
+ @brief The file that entries are appended to, or nil to write them to the standard error. The default value is nil.
+ */
+@property (copy, nullable) NSURL* fileURL;
+
+/*!
+ @brief The interval at which the rings are drained, in seconds. The default value is 0.1.
+ */
+@property (nonatomic) NSTimeInterval flushInterval;
+
+/*!
+ @brief The number of entries that have been dropped because a ring was full.
+ */
+@property (readonly) UInt64 droppedCount;
+
+/*!
+ @brief The number of entries that have been lost because they couldn't be written to the log file, such as when the disk is full or the standard error is a closed pipe.
+ */
+@property (readonly) UInt64 failedCount;
+
+
+
+///--------------
+/// @name Logging
+///--------------
+
+/*!
+ @brief Logs a message from the application in the framework's log.
+ @param level The level of the message.
+ @param op A short name for the operation, such as "capture".
+ @param camera The camera that the message is about, or nil.
+ @param message The message.
+ */
+-(void)logWithLevel:(EOSLogLevel)level op:(NSString*)op camera:(nullable id)camera message:(NSString*)message;
+
+/*!
+ @brief Writes the entries that are waiting in the rings, and returns once they have been written.
+ */
+-(void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
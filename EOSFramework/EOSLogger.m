@@ -0,0 +1,431 @@
+//
+//  EOSLogger.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSLogger.h>
+#import "EOSPrivate.h"
+
+#import <pthread.h>
+#import <time.h>
+#import <fcntl.h>
+#import <unistd.h>
+
+#define EOSLoggerBufferCapacity         512
+#define EOSLoggerDefaultFlushInterval   0.1
+
+//a ring written by one thread and drained by the logger's queue
+typedef struct EOSLogBuffer{
+
+    _Atomic uint64_t head;
+    _Atomic uint64_t tail;
+    _Atomic bool isInUse;
+    struct EOSLogBuffer* next;
+    EOSLogRecord records[EOSLoggerBufferCapacity];
+
+} EOSLogBuffer;
+
+_Atomic(NSInteger) EOSLogCurrentLevel = EOSLogLevel_Off;
+
+//rings are only ever added to the list, and are reused once their thread has exited
+static _Atomic(EOSLogBuffer*) EOSLogBuffers = NULL;
+static _Atomic uint64_t EOSLogDroppedCount = 0;
+static pthread_key_t EOSLogBufferKey;
+
+static void EOSLogReleaseBuffer(void* buffer){
+
+    atomic_store_explicit(&((EOSLogBuffer*)buffer)->isInUse, false, memory_order_release);
+
+}
+
+static EOSLogBuffer* EOSLogThreadBuffer(void){
+
+    static dispatch_once_t pred = 0;
+
+    dispatch_once(&pred, ^{
+        pthread_key_create(&EOSLogBufferKey, EOSLogReleaseBuffer);
+    });
+
+    EOSLogBuffer* buffer = pthread_getspecific(EOSLogBufferKey);
+
+    if (buffer != NULL)
+        return buffer;
+
+    //a ring left behind by an exited thread may still hold entries, which are drained as usual
+    for (buffer = atomic_load(&EOSLogBuffers); buffer != NULL; buffer = buffer->next){
+
+        bool isInUse = false;
+
+        if (atomic_compare_exchange_strong(&buffer->isInUse, &isInUse, true))
+            break;
+
+    }
+
+    if (buffer == NULL){
+
+        buffer = calloc(1, sizeof(EOSLogBuffer));
+
+        if (buffer == NULL)
+            return NULL;
+
+        atomic_init(&buffer->head, 0);
+        atomic_init(&buffer->tail, 0);
+        atomic_init(&buffer->isInUse, true);
+
+        EOSLogBuffer* first = atomic_load(&EOSLogBuffers);
+
+        do{
+            buffer->next = first;
+        }while (!atomic_compare_exchange_weak(&EOSLogBuffers, &first, buffer));
+
+    }
+
+    pthread_setspecific(EOSLogBufferKey, buffer);
+    return buffer;
+
+}
+
+void EOSLogWrite(EOSLogLevel level, const char* op, id owner, uint64_t latencyNanoseconds, const char* format, ...){
+
+    EOSLogBuffer* buffer = EOSLogThreadBuffer();
+
+    if (buffer == NULL)
+        return;
+
+    uint64_t head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&buffer->tail, memory_order_acquire);
+
+    //the logging thread is never made to wait for the writer
+    if (head - tail >= EOSLoggerBufferCapacity){
+
+        atomic_fetch_add_explicit(&EOSLogDroppedCount, 1, memory_order_relaxed);
+        return;
+
+    }
+
+    EOSLogRecord* record = &buffer->records[head & (EOSLoggerBufferCapacity - 1)];
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    record->time = (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
+    record->latencyNanoseconds = latencyNanoseconds;
+    record->level = (uint32_t)level;
+    strlcpy(record->op, op, sizeof(record->op));
+    strlcpy(record->camera, EOSProbeSerialNumber(owner), sizeof(record->camera));
+
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(record->message, sizeof(record->message), format, arguments);
+    va_end(arguments);
+
+    atomic_store_explicit(&buffer->head, head + 1, memory_order_release);
+
+}
+
+static void EOSLogAppendJSONString(NSMutableData* data, const char* string){
+
+    [data appendBytes:"\"" length:1];
+
+    for (const char* c = string; *c != '\0'; c++){
+
+        if (*c == '"' || *c == '\\'){
+
+            char escaped[2] = {'\\', *c};
+            [data appendBytes:escaped length:2];
+
+        }else if ((unsigned char)*c < 0x20){
+
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)*c);
+            [data appendBytes:escaped length:6];
+
+        }else
+            [data appendBytes:c length:1];
+
+    }
+
+    [data appendBytes:"\"" length:1];
+
+}
+
+static void EOSLogAppendJSONLine(NSMutableData* data, const EOSLogRecord* record){
+
+    static const char* levelNames[] = {"off", "error", "warning", "info", "debug"};
+
+    time_t seconds = (time_t)(record->time / NSEC_PER_SEC);
+    struct tm components;
+    gmtime_r(&seconds, &components);
+
+    char time[40];
+    size_t length = strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%S", &components);
+    snprintf(time + length, sizeof(time) - length, ".%06uZ", (unsigned int)(record->time % NSEC_PER_SEC / NSEC_PER_USEC));
+
+    char prefix[128];
+    int prefixLength = snprintf(prefix, sizeof(prefix), "{\"time\":\"%s\",\"level\":\"%s\",\"op\":", time, levelNames[MIN(record->level, EOSLogLevel_Debug)]);
+    [data appendBytes:prefix length:(NSUInteger)prefixLength];
+
+    EOSLogAppendJSONString(data, record->op);
+    [data appendBytes:",\"camera\":" length:10];
+    EOSLogAppendJSONString(data, record->camera);
+
+    char latency[48];
+    int latencyLength = snprintf(latency, sizeof(latency), ",\"latencyNanoseconds\":%llu,\"message\":", (unsigned long long)record->latencyNanoseconds);
+    [data appendBytes:latency length:(NSUInteger)latencyLength];
+
+    EOSLogAppendJSONString(data, record->message);
+    [data appendBytes:"}\n" length:2];
+
+}
+
+
+
+
+@implementation EOSLogger{
+
+    dispatch_queue_t _queue;
+    dispatch_source_t _timer;
+
+    //-1 until the log file is opened
+    int _fileDescriptor;
+
+    _Atomic uint64_t _failedCount;
+
+}
+
+@synthesize flushInterval = _flushInterval;
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        _fileDescriptor = -1;
+        _format = EOSLogFormat_JSONLines;
+        _flushInterval = EOSLoggerDefaultFlushInterval;
+        _queue = dispatch_queue_create("com.EOSFramework.logger", DISPATCH_QUEUE_SERIAL);
+
+    }
+
+    return self;
+
+}
+
++(EOSLogger*)sharedLogger{
+
+    static dispatch_once_t pred = 0;
+    __strong static id _sharedObject = nil;
+    dispatch_once(&pred, ^{
+        _sharedObject = [[self alloc] init];
+    });
+    return _sharedObject;
+
+}
+
+-(EOSLogLevel)level{
+
+    return (EOSLogLevel)atomic_load_explicit(&EOSLogCurrentLevel, memory_order_relaxed);
+
+}
+
+-(void)setLevel:(EOSLogLevel)level{
+
+    atomic_store_explicit(&EOSLogCurrentLevel, level, memory_order_relaxed);
+
+    //the writer only runs once something can be logged
+    if (level != EOSLogLevel_Off){
+
+        dispatch_sync(_queue, ^(void){
+
+            if (_timer != nil)
+                return;
+
+            _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+
+            __weak EOSLogger* weakSelf = self;
+            dispatch_source_set_event_handler(_timer, ^(void){
+                [weakSelf drain];
+            });
+
+            [self scheduleTimer];
+            dispatch_resume(_timer);
+
+        });
+
+    }
+
+}
+
+-(void)setFileURL:(NSURL *)fileURL{
+
+    dispatch_sync(_queue, ^(void){
+
+        [self drain];
+
+        _fileURL = [fileURL copy];
+        [self closeFile];
+
+    });
+
+}
+
+-(NSURL*)fileURL{
+
+    __block NSURL* fileURL;
+
+    dispatch_sync(_queue, ^(void){
+        fileURL = _fileURL;
+    });
+
+    return fileURL;
+
+}
+
+-(void)setFlushInterval:(NSTimeInterval)flushInterval{
+
+    dispatch_sync(_queue, ^(void){
+
+        _flushInterval = flushInterval;
+
+        if (_timer != nil)
+            [self scheduleTimer];
+
+    });
+
+}
+
+-(NSTimeInterval)flushInterval{
+
+    __block NSTimeInterval flushInterval;
+
+    dispatch_sync(_queue, ^(void){
+        flushInterval = _flushInterval;
+    });
+
+    return flushInterval;
+
+}
+
+-(UInt64)droppedCount{
+
+    return atomic_load_explicit(&EOSLogDroppedCount, memory_order_relaxed);
+
+}
+
+-(UInt64)failedCount{
+
+    return atomic_load_explicit(&_failedCount, memory_order_relaxed);
+
+}
+
+
+
+
+#pragma mark - Logging
+
+-(void)logWithLevel:(EOSLogLevel)level op:(NSString *)op camera:(id)camera message:(NSString *)message{
+
+    EOSLog(level, [op UTF8String], camera, 0, "%s", [message UTF8String]);
+
+}
+
+-(void)flush{
+
+    dispatch_sync(_queue, ^(void){
+        [self drain];
+    });
+
+}
+
+//called on the queue
+-(void)scheduleTimer{
+
+    uint64_t interval = (uint64_t)(_flushInterval * NSEC_PER_SEC);
+    dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 10);
+
+}
+
+//called on the queue
+-(void)drain{
+
+    NSMutableData* data = [NSMutableData data];
+    EOSLogFormat format = [self format];
+    uint64_t count = 0;
+
+    for (EOSLogBuffer* buffer = atomic_load(&EOSLogBuffers); buffer != NULL; buffer = buffer->next){
+
+        uint64_t tail = atomic_load_explicit(&buffer->tail, memory_order_relaxed);
+        uint64_t head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+
+        for (; tail < head; tail++, count++){
+
+            const EOSLogRecord* record = &buffer->records[tail & (EOSLoggerBufferCapacity - 1)];
+
+            if (format == EOSLogFormat_Binary)
+                [data appendBytes:record length:sizeof(EOSLogRecord)];
+            else
+                EOSLogAppendJSONLine(data, record);
+
+        }
+
+        //the entries may only be overwritten once they have been copied
+        atomic_store_explicit(&buffer->tail, tail, memory_order_release);
+
+    }
+
+    if ([data length] == 0)
+        return;
+
+    if (_fileDescriptor < 0){
+
+        _fileDescriptor = _fileURL != nil ? open([_fileURL fileSystemRepresentation], O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644) : STDERR_FILENO;
+
+#ifdef F_SETNOSIGPIPE
+        //a closed pipe is reported as an error rather than killing the process
+        if (_fileDescriptor >= 0)
+            fcntl(_fileDescriptor, F_SETNOSIGPIPE, 1);
+#endif
+
+    }
+
+    const uint8_t* bytes = [data bytes];
+    NSUInteger remaining = [data length];
+
+    while (_fileDescriptor >= 0 && remaining > 0){
+
+        ssize_t written = write(_fileDescriptor, bytes, remaining);
+
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        if (written <= 0)
+            break;
+
+        bytes += written;
+        remaining -= (NSUInteger)written;
+
+    }
+
+    //a full disk or a closed pipe loses the entries rather than the process, and the file is reopened next time
+    if (remaining > 0){
+
+        atomic_fetch_add_explicit(&_failedCount, count, memory_order_relaxed);
+        [self closeFile];
+
+    }
+
+}
+
+//called on the queue
+-(void)closeFile{
+
+    if (_fileDescriptor >= 0 && _fileDescriptor != STDERR_FILENO)
+        close(_fileDescriptor);
+
+    _fileDescriptor = -1;
+
+}
+
+@end
\ No newline at end of file
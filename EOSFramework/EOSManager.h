@@ -11,9 +11,25 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class EOSCamera;
+@class EOSCameraProfile;
+@class EOSFleetResult;
+@class EOSFleetStatus;
+@class EOSVolume;
 
 @protocol EOSManagerDelegate;
 
+/*!
+ @brief The stages that a volume passes through while it is formatted by [EOSManager formatVolumes:maxConcurrentOperations:progress:completion:].
+ */
+typedef NS_ENUM(NSUInteger, EOSFormatStage){
+    
+    EOSFormatStage_Formatting,  //the volume is being formatted
+    EOSFormatStage_Updated,     //the camera reported that the volume's items were updated
+    EOSFormatStage_Verified,    //the volume's free space was read back and verified
+    EOSFormatStage_Failed       //the volume couldn't be formatted or verified
+    
+};
+
 
 /*!
  The EOSManager class defines a singleton object used to manage the EOS framework.
@@ -98,6 +114,54 @@ NS_ASSUME_NONNULL_BEGIN
 
 
 
+
+///-------------------------
+/// @name Managing Fleets
+///-------------------------
+
+/*!
+ @brief Performs an operation on several cameras concurrently.
+ @discussion The operation is performed on a background thread for each camera, with no more than maxConcurrentOperations cameras at a time. If the operation fails because a camera is busy, it is retried after a short delay, up to 5 times. Cameras must have an open session.
+ @param operation A block that performs the operation on a camera. It returns a value to be stored in the result, or nil with an error if unsuccessful. If nil is returned without an error, the operation is considered successful.
+ @param cameras An array of EOSCamera objects.
+ @param maxConcurrentOperations The maximum number of cameras to operate on at the same time.
+ @param completion A block that is called on the main thread once the operation has finished on all cameras.
+ */
+-(void)performOperation:(id _Nullable (^)(EOSCamera* camera, NSError* __autoreleasing* error))operation onCameras:(NSArray<EOSCamera*>*)cameras maxConcurrentOperations:(NSUInteger)maxConcurrentOperations completion:(nullable void (^)(EOSFleetResult* result))completion;
+
+/*!
+ @brief Applies a profile to several cameras concurrently.
+ @discussion Each camera is compared with the profile, and only the properties that differ are written. The value stored in the result for each camera is an array of the properties that were written. Each camera's UI is locked while its properties are written.
+ @param profile The profile to apply.
+ @param cameras An array of EOSCamera objects.
+ @param maxConcurrentOperations The maximum number of cameras to apply the profile to at the same time.
+ @param completion A block that is called on the main thread once the profile has been applied to all cameras.
+ @see performOperation:onCameras:maxConcurrentOperations:completion:
+ */
+-(void)applyProfile:(EOSCameraProfile*)profile toCameras:(NSArray<EOSCamera*>*)cameras maxConcurrentOperations:(NSUInteger)maxConcurrentOperations completion:(nullable void (^)(EOSFleetResult* result))completion;
+
+/*!
+ @brief Formats several volumes concurrently.
+ @discussion The volumes are grouped by camera. Each camera formats its volumes one at a time, and the cameras work in parallel. After a volume is formatted, its information is read back, and the format fails with EOSError_Device_DiskError if the volume reports an access error or less space available than before. The value stored in the result for each camera is an array of the EOSVolumeInfo of its formatted volumes, in the order that they were given. Each camera's UI is locked until its volumes are formatted. Volumes that were not retrieved through an EOSCamera are ignored.
+ @param volumes An array of EOSVolume objects.
+ @param maxConcurrentOperations The maximum number of cameras to format volumes on at the same time.
+ @param progress A block that is called on the main thread as each volume passes through each EOSFormatStage. A volume reaches EOSFormatStage_Updated only if its camera reports the update; not every model does. A camera that is busy is retried from the first volume that wasn't formatted, which reaches EOSFormatStage_Failed only if the camera is still busy after the last attempt.
+ @param completion A block that is called on the main thread once every volume has been formatted.
+ @see performOperation:onCameras:maxConcurrentOperations:completion:
+ */
+-(void)formatVolumes:(NSArray<EOSVolume*>*)volumes maxConcurrentOperations:(NSUInteger)maxConcurrentOperations progress:(nullable void (^)(EOSVolume* volume, EOSFormatStage stage))progress completion:(nullable void (^)(EOSFleetResult* result))completion;
+
+/*!
+ @brief Collects a snapshot of the health of several cameras in parallel.
+ @discussion Every camera is read at once on its own background thread: its battery level, available shots, first volume, shooting mode and lens name. When every camera has answered, or the deadline has passed, the snapshot is taken. The fields that a camera hasn't answered by then are marked stale and hold their values from an earlier snapshot, so a slow camera never holds up the others. A camera that is still answering an earlier snapshot isn't asked again until it has finished, and the values it reads late are used in the next snapshot. Cameras must have an open session.
+ @param cameras An array of EOSCamera objects.
+ @param deadline The time that each camera has to answer, in seconds.
+ @param completion A block that is called on the main thread with the snapshot.
+ */
+-(void)collectStatusOfCameras:(NSArray<EOSCamera*>*)cameras deadline:(NSTimeInterval)deadline completion:(void (^)(EOSFleetStatus* status))completion;
+
+
+
 /**
  Gets the number of cameras that are connected
  @param error If unsuccessful, an instance of NSError describes the problem
@@ -9,10 +9,19 @@
 #import <EOSFramework/EOSManager.h>
 #import <EOSFramework/EOSError.h>
 #import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSCameraProfile.h>
+#import <EOSFramework/EOSFleetResult.h>
+#import <EOSFramework/EOSVolume.h>
+#import <EOSFramework/EOSFleetStatus.h>
+#import "EOSPrivate.h"
 
 #import <EDSDK/EDSDK.h>
 #import <EDSDK/EDSDKTypes.h>
 
+#define EOSFleetMaxAttempts     6
+#define EOSFleetRetryDelay      0.05
+#define EOSFormatUpdateTimeout  2.0
+
 EdsError EDSCALLBACK EOSManagerCameraAddedHandler(EdsVoid* inContext){
     
     EOSManager* manager = [EOSManager sharedManager];
@@ -24,7 +33,16 @@ EdsError EDSCALLBACK EOSManagerCameraAddedHandler(EdsVoid* inContext){
     
 }
 
-@implementation EOSManager
+@implementation EOSManager{
+    
+    //the most recent value, time and error of each status field of each camera, guarded by _statusQueue; cameras are held weakly, so a disconnected camera's entries go with it
+    dispatch_queue_t _statusQueue;
+    NSMapTable* _statusValues;
+    NSMapTable* _statusDates;
+    NSMapTable* _statusErrors;
+    NSHashTable* _statusReadingCameras;
+    
+}
 
 -(id)init{
     
@@ -35,6 +53,12 @@ EdsError EDSCALLBACK EOSManagerCameraAddedHandler(EdsVoid* inContext){
         _isLoaded = false;
         _cameraList = [NSArray array];
         
+        _statusQueue = dispatch_queue_create("com.EOSFramework.manager.status", DISPATCH_QUEUE_SERIAL);
+        _statusValues = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _statusDates = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _statusErrors = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _statusReadingCameras = [NSHashTable hashTableWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality];
+        
     }
     
     return self;
@@ -129,8 +153,9 @@ EdsError EDSCALLBACK EOSManagerCameraAddedHandler(EdsVoid* inContext){
     
     if (EdsGetCameraList(&cameraListRef) == EOSError_OK){
         
+        EOSRefTrackerAddRef(cameraListRef, @"EdsCameraListRef", nil);
         EdsGetChildCount(cameraListRef, &count);
-        //NSLog(@"count: %i", count);
+        EOSLog(EOSLogLevel_Debug, "cameras", nil, 0, "found %u cameras", (unsigned int)count);
         
     }
     
@@ -143,15 +168,19 @@ EdsError EDSCALLBACK EOSManagerCameraAddedHandler(EdsVoid* inContext){
         
         if (EdsGetChildAtIndex(cameraListRef, i, &cameraRef) == EOSError_OK){
             
-            camera = [[EOSCamera alloc] initWithCameraRef:cameraRef];
-
-            NSUInteger index = [_cameraList indexOfObject:camera];
+            //reuse the existing camera rather than wrapping the ref again, which would also clear its event handlers
+            NSUInteger index = [_cameraList indexOfObjectPassingTest:^BOOL(EOSCamera* existingCamera, NSUInteger idx, BOOL* stop){
+                return [existingCamera isEqualToBaseRef:cameraRef];
+            }];
+            
             if (index == NSNotFound){
-                //NSLog(@"Found new camera");
+                EOSLog(EOSLogLevel_Debug, "cameras", nil, 0, "found new camera");
+                camera = [[EOSCamera alloc] initWithCameraRef:cameraRef];
                 [newCameraList addObject:camera];
                 
             }else{
-                //NSLog(@"Found existing camera");
+                EOSLog(EOSLogLevel_Debug, "cameras", nil, 0, "found existing camera");
+                EOSRefTrackerRelease(cameraRef);
                 [newCameraList addObject:[_cameraList objectAtIndex:index]];
                 
             }
@@ -161,13 +190,392 @@ EdsError EDSCALLBACK EOSManagerCameraAddedHandler(EdsVoid* inContext){
     }
     
     if (cameraListRef != NULL)
-        EdsRelease(cameraListRef);
+        EOSRefTrackerRelease(cameraListRef);
     
     _cameraList = [NSArray arrayWithArray:newCameraList];
     return _cameraList;
 
 }
 
+
+
+
+-(void)performOperation:(id (^)(EOSCamera *, NSError *__autoreleasing *))operation onCameras:(NSArray *)cameras maxConcurrentOperations:(NSUInteger)maxConcurrentOperations completion:(void (^)(EOSFleetResult *))completion{
+    
+    EOSFleetResult* result = [[EOSFleetResult alloc] initWithCameras:cameras];
+    NSDate* startDate = [NSDate date];
+    
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(MAX(maxConcurrentOperations, 1));
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    
+    //admit cameras in background thread
+    dispatch_async(queue, ^(void){
+        
+        NSUInteger waiting = [cameras count];
+        
+        for (EOSCamera* camera in cameras){
+            
+            if (EOSFRAMEWORK_QUEUE_ENQUEUE_ENABLED())
+                EOSFRAMEWORK_QUEUE_ENQUEUE("fleet", EOSProbeSerialNumber(camera), waiting);
+            
+            //wait for a free slot
+            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+            waiting--;
+            
+            if (EOSFRAMEWORK_QUEUE_DEQUEUE_ENABLED())
+                EOSFRAMEWORK_QUEUE_DEQUEUE("fleet", EOSProbeSerialNumber(camera), waiting);
+            
+            dispatch_group_async(group, queue, ^(void){
+                
+                id value;
+                NSError* error;
+                NSUInteger attempts = 0;
+                NSTimeInterval delay = EOSFleetRetryDelay;
+                
+                do{
+                    
+                    //back off while the camera is busy
+                    if (attempts > 0){
+                        
+                        [NSThread sleepForTimeInterval:delay];
+                        delay *= 2;
+                        
+                    }
+                    
+                    error = nil;
+                    value = operation(camera, &error);
+                    attempts++;
+                    
+                }while (value == nil && [error code] == EOSError_Device_Busy && attempts < EOSFleetMaxAttempts);
+                
+                [result setValue:value error:error attempts:attempts forCamera:camera];
+                
+                if (error != nil)
+                    EOSLog(EOSLogLevel_Warning, "fleet", camera, 0, "operation failed with 0x%x after %lu attempts", (unsigned int)[error code], (unsigned long)attempts);
+                
+                dispatch_semaphore_signal(semaphore);
+                
+            });
+            
+        }
+        
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^(void){
+            
+            [result setDuration:-[startDate timeIntervalSinceNow]];
+            
+            if (completion)
+                completion(result);
+            
+        });
+        
+    });
+    
+}
+
+-(void)applyProfile:(EOSCameraProfile *)profile toCameras:(NSArray *)cameras maxConcurrentOperations:(NSUInteger)maxConcurrentOperations completion:(void (^)(EOSFleetResult *))completion{
+    
+    [self performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+        
+        //each camera is diffed separately, so a retry only writes what is still different
+        NSArray* changedProperties;
+        
+        if (![profile applyToCamera:camera changedProperties:&changedProperties error:error])
+            return nil;
+        
+        return changedProperties;
+        
+    } onCameras:cameras maxConcurrentOperations:maxConcurrentOperations completion:completion];
+    
+}
+
+-(void)formatVolumes:(NSArray *)volumes maxConcurrentOperations:(NSUInteger)maxConcurrentOperations progress:(void (^)(EOSVolume *, EOSFormatStage))progress completion:(void (^)(EOSFleetResult *))completion{
+    
+    //a camera formats one volume at a time, so its volumes are formatted in turn and the cameras in parallel
+    NSMutableArray* cameras = [NSMutableArray array];
+    NSMutableArray* volumeGroups = [NSMutableArray array];
+    NSMutableArray* infoGroups = [NSMutableArray array];
+    
+    for (EOSVolume* volume in volumes){
+        
+        EOSCamera* camera = [volume camera];
+        
+        if (camera == nil)
+            continue;
+        
+        NSUInteger index = [cameras indexOfObjectIdenticalTo:camera];
+        
+        if (index == NSNotFound){
+            
+            index = [cameras count];
+            [cameras addObject:camera];
+            [volumeGroups addObject:[NSMutableArray array]];
+            [infoGroups addObject:[NSMutableArray array]];
+            
+        }
+        
+        [[volumeGroups objectAtIndex:index] addObject:volume];
+        
+    }
+    
+    void (^report)(EOSVolume*, EOSFormatStage) = ^(EOSVolume* volume, EOSFormatStage stage){
+        
+        if (progress){
+            
+            dispatch_async(dispatch_get_main_queue(), ^(void){
+                progress(volume, stage);
+            });
+            
+        }
+        
+    };
+    
+    //a busy camera is retried, so its volume hasn't failed until the retries run out
+    void (^reportFailure)(EOSVolume*, NSError*) = ^(EOSVolume* volume, NSError* error){
+        
+        if ([error code] != EOSError_Device_Busy)
+            report(volume, EOSFormatStage_Failed);
+        
+    };
+    
+    [self performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+        
+        NSUInteger index = [cameras indexOfObjectIdenticalTo:camera];
+        NSArray* cameraVolumes = [volumeGroups objectAtIndex:index];
+        NSMutableArray* infos = [infoGroups objectAtIndex:index];
+        
+        //the UI stays locked across the camera's volumes, and is unlocked however the format ends
+        NSUInteger lockToken;
+        
+        if (![camera lockUI:&lockToken error:error])
+            return nil;
+        
+        @try{
+            
+            //a retry after the camera was busy carries on from the first volume that wasn't formatted
+            for (NSUInteger i = [infos count]; i < [cameraVolumes count]; i++){
+                
+                EOSVolume* volume = [cameraVolumes objectAtIndex:i];
+                EOSVolumeInfo* previousInfo = [volume info:error];
+                
+                if (previousInfo == nil){
+                    
+                    reportFailure(volume, *error);
+                    return nil;
+                    
+                }
+                
+                //the update may be reported before the format returns
+                dispatch_semaphore_t updated = dispatch_semaphore_create(0);
+                
+                [camera setVolumeUpdateHandler:^(EOSVolume* updatedVolume){
+                    
+                    if (updatedVolume == volume)
+                        dispatch_semaphore_signal(updated);
+                    
+                }];
+                
+                report(volume, EOSFormatStage_Formatting);
+                
+                BOOL formatted = [volume format:error];
+                
+                if (formatted && dispatch_semaphore_wait(updated, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(EOSFormatUpdateTimeout * NSEC_PER_SEC))) == 0)
+                    report(volume, EOSFormatStage_Updated);
+                
+                [camera setVolumeUpdateHandler:nil];
+                
+                if (!formatted){
+                    
+                    reportFailure(volume, *error);
+                    return nil;
+                    
+                }
+                
+                EOSVolumeInfo* info = [volume info:error];
+                
+                if (info == nil){
+                    
+                    reportFailure(volume, *error);
+                    return nil;
+                    
+                }
+                
+                //a freshly formatted volume has at least the space that it had before
+                if ([info access] == EOSAccess_Error || [info available] < [previousInfo available] || [info available] == 0){
+                    
+                    if (error)
+                        *error = EOSCreateError(EOSError_Device_DiskError);
+                    
+                    report(volume, EOSFormatStage_Failed);
+                    return nil;
+                    
+                }
+                
+                [infos addObject:info];
+                report(volume, EOSFormatStage_Verified);
+                
+            }
+            
+            return [NSArray arrayWithArray:infos];
+            
+        }@finally{
+            
+            [camera unlockUI:lockToken error:NULL];
+            
+        }
+        
+    } onCameras:cameras maxConcurrentOperations:maxConcurrentOperations completion:^(EOSFleetResult* result){
+        
+        //a camera that was still busy after its last attempt fails at the first volume that wasn't formatted
+        for (EOSCamera* camera in [result failedCameras]){
+            
+            NSUInteger index = [cameras indexOfObjectIdenticalTo:camera];
+            NSArray* cameraVolumes = [volumeGroups objectAtIndex:index];
+            NSUInteger formattedCount = [[infoGroups objectAtIndex:index] count];
+            
+            if (progress && [[result errorForCamera:camera] code] == EOSError_Device_Busy && formattedCount < [cameraVolumes count])
+                progress([cameraVolumes objectAtIndex:formattedCount], EOSFormatStage_Failed);
+            
+        }
+        
+        if (completion)
+            completion(result);
+        
+    }];
+    
+}
+
+-(void)collectStatusOfCameras:(NSArray *)cameras deadline:(NSTimeInterval)deadline completion:(void (^)(EOSFleetStatus *))completion{
+    
+    NSDate* startDate = [NSDate date];
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    
+    for (EOSCamera* camera in cameras){
+        
+        __block BOOL isReading;
+        
+        dispatch_sync(_statusQueue, ^(void){
+            
+            isReading = [_statusReadingCameras containsObject:camera];
+            
+            if (!isReading){
+                
+                [_statusReadingCameras addObject:camera];
+                [_statusErrors removeObjectForKey:camera];
+                
+            }
+            
+        });
+        
+        //a camera that is stuck on an earlier snapshot would only queue up more calls
+        if (isReading)
+            continue;
+        
+        dispatch_group_async(group, queue, ^(void){
+            
+            [self readStatusOfCamera:camera];
+            
+            dispatch_sync(_statusQueue, ^(void){
+                [_statusReadingCameras removeObject:camera];
+            });
+            
+        });
+        
+    }
+    
+    //wait on a background thread, so the caller isn't blocked
+    dispatch_async(queue, ^(void){
+        
+        dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(deadline * NSEC_PER_SEC)));
+        
+        NSMutableArray* cameraStatuses = [NSMutableArray arrayWithCapacity:[cameras count]];
+        
+        dispatch_sync(_statusQueue, ^(void){
+            
+            for (EOSCamera* camera in cameras){
+                
+                NSDictionary* values = [_statusValues objectForKey:camera] ?: [NSDictionary dictionary];
+                NSDictionary* dates = [_statusDates objectForKey:camera] ?: [NSDictionary dictionary];
+                EOSStatusField staleFields = 0;
+                
+                //a field is fresh only if it was read since this snapshot began
+                for (EOSStatusField field = 1; field & EOSStatusField_All; field <<= 1){
+                    
+                    NSDate* date = [dates objectForKey:@(field)];
+                    
+                    if (date == nil || [date compare:startDate] == NSOrderedAscending)
+                        staleFields |= field;
+                    
+                }
+                
+                [cameraStatuses addObject:[[EOSCameraStatus alloc] initWithCamera:camera values:values dates:dates staleFields:staleFields error:[_statusErrors objectForKey:camera]]];
+                
+            }
+            
+        });
+        
+        EOSFleetStatus* status = [[EOSFleetStatus alloc] initWithDate:[NSDate date] duration:-[startDate timeIntervalSinceNow] cameraStatuses:cameraStatuses];
+        
+        dispatch_async(dispatch_get_main_queue(), ^(void){
+            completion(status);
+        });
+        
+    });
+    
+}
+
+-(void)readStatusOfCamera:(EOSCamera*)camera{
+    
+    for (EOSStatusField field = 1; field & EOSStatusField_All; field <<= 1){
+        
+        id value;
+        NSError* error;
+        
+        if (field == EOSStatusField_BatteryLevel)
+            value = [camera numberValueForProperty:EOSProperty_BatteryLevel error:&error];
+        
+        else if (field == EOSStatusField_AvailableShots)
+            value = [camera numberValueForProperty:EOSProperty_AvailableShots error:&error];
+        
+        else if (field == EOSStatusField_VolumeInfo)
+            value = [[camera volumeAtIndex:0 error:&error] info:&error];
+        
+        else if (field == EOSStatusField_AEMode)
+            value = [camera numberValueForProperty:EOSProperty_AEMode error:&error];
+        
+        else if (field == EOSStatusField_LensName)
+            value = [camera stringValueForProperty:EOSProperty_LensName error:&error];
+        
+        //each field is stored as it arrives, so a snapshot taken part way through has the fields read so far
+        dispatch_sync(_statusQueue, ^(void){
+            
+            if (value != nil){
+                
+                NSMutableDictionary* values = [_statusValues objectForKey:camera];
+                NSMutableDictionary* dates = [_statusDates objectForKey:camera];
+                
+                if (values == nil){
+                    
+                    values = [NSMutableDictionary dictionary];
+                    dates = [NSMutableDictionary dictionary];
+                    [_statusValues setObject:values forKey:camera];
+                    [_statusDates setObject:dates forKey:camera];
+                    
+                }
+                
+                [values setObject:value forKey:@(field)];
+                [dates setObject:[NSDate date] forKey:@(field)];
+                
+            }else if ([_statusErrors objectForKey:camera] == nil)
+                [_statusErrors setObject:error ?: EOSCreateError(EOSError_InternalError) forKey:camera];
+            
+        });
+        
+    }
+    
+}
+
 //-(NSArray*)getAddedCameras{
 //    
 //    NSArray* oldCameraList = [NSArray arrayWithArray:_cameraList];
@@ -8,6 +8,7 @@
 
 #import <EOSFramework/EOSObject.h>
 #import <EDSDK/EDSDK.h>
+#import "EOSPrivate.h"
 
 @implementation EOSObject
 
@@ -17,6 +18,7 @@
     if (self){
         
         _baseRef = baseRef;
+        EOSRefTrackerAdd(self);
         
     }
     
@@ -26,6 +28,8 @@
 
 -(void)dealloc{
 
+    EOSRefTrackerRemove(self);
+
     //release the EdsBaseRef object
     EdsRelease(_baseRef);
     
@@ -43,6 +47,13 @@
     
 }
 
+//equal objects wrap the same ref
+-(NSUInteger)hash{
+
+    return (NSUInteger)_baseRef;
+
+}
+
 -(BOOL)isEqual:(id)object{
     
     if ([object isKindOfClass:[self class]]){
@@ -0,0 +1,198 @@
+//
+//  EOSPrivate.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+// Internal interfaces shared between the classes of the framework. This header is not public.
+
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSVolume.h>
+#import <EOSFramework/EOSFile.h>
+#import <EOSFramework/EOSError.h>
+#import <EOSFramework/EOSCapabilityCache.h>
+#import <EOSFramework/EOSFleetStatus.h>
+#import <EOSFramework/EOSPropertyHistory.h>
+#import <EOSFramework/EOSLogger.h>
+#import <mach/mach_time.h>
+#import <stdatomic.h>
+#import "EOSProbes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface EOSCamera ()
+
+//returns the live wrapper for a ref, releasing the extra reference, or wraps it if there is none
+-(EOSVolume*)internVolumeRef:(EdsVolumeRef)volumeRef;
+-(EOSFile*)internDirectoryItemRef:(EdsDirectoryItemRef)fileRef volume:(nullable EOSVolume*)volume;
+
+//serves a serial number that has been read from the camera, without reading it again
+-(void)setCachedSerialNumber:(NSString*)serialNumber;
+
+//the serial number of the camera's EOSDeviceRegistry record, until the camera has been revalidated
+-(void)setProvisionalSerialNumber:(nullable NSString*)provisionalSerialNumber;
+
+//the serial number if it has already been read, or an empty string, without reading it or taking a lock
+-(const char*)probeSerialNumber;
+
+//receives transfer requests in place of the delegate, such as for EOSHostCapture
+@property (copy, nullable) void (^transferRequestHandler)(EOSFile* file);
+
+//receives the camera's volume update events alongside the delegate, such as while EOSManager formats volumes
+@property (copy, nullable) void (^volumeUpdateHandler)(EOSVolume* volume);
+
+//receive the camera's volume info and property change events alongside the delegate, such as for EOSFleetMonitor
+@property (copy, nullable) void (^volumeChangeHandler)(EOSVolume* volume);
+@property (copy, nullable) void (^propertyChangeHandler)(EOSProperty property);
+
+//receives the files that the camera asks to send, or cancels, in direct transfer mode, such as for EOSDirectTransfer
+@property (copy, nullable) void (^directTransferHandler)(EOSFile* file, BOOL cancelled);
+
+@end
+
+
+//the capabilities of one camera model and firmware version, shared by every camera of that model
+@interface EOSCapabilities : NSObject
+
+-(BOOL)getSize:(NSUInteger*)size dataType:(EdsDataType*)dataType forProperty:(EOSProperty)property parameter:(NSUInteger)parameter;
+-(void)setSize:(NSUInteger)size dataType:(EdsDataType)dataType forProperty:(EOSProperty)property parameter:(NSUInteger)parameter;
+-(void)removeTraitsForProperty:(EOSProperty)property parameter:(NSUInteger)parameter;
+
+//the context identifies the camera's configuration that the values depend on
+-(nullable NSArray*)supportedValuesForProperty:(EOSProperty)property context:(NSString*)context;
+-(void)setSupportedValues:(NSArray*)supportedValues forProperty:(EOSProperty)property context:(NSString*)context;
+
+//a nil context removes the values for every context
+-(void)removeSupportedValuesForProperty:(EOSProperty)property context:(nullable NSString*)context;
+
+@end
+
+
+@interface EOSCapabilityCache ()
+
+//nil if the cache is disabled
+-(nullable EOSCapabilities*)capabilitiesForProductName:(NSString*)productName firmwareVersion:(NSString*)firmwareVersion;
+
+@end
+
+
+@interface EOSVolume ()
+
+-(id)initWithVolumeRef:(EdsVolumeRef)volumeRef camera:(nullable EOSCamera*)camera;
+
+@end
+
+
+@interface EOSFile ()
+
+-(id)initWithDirectoryItemRef:(EdsDirectoryItemRef)fileRef camera:(nullable EOSCamera*)camera volume:(nullable EOSVolume*)volume;
+
+//synchronous downloads, which complete the transfer on the camera
+-(BOOL)downloadIntoBytes:(void*)bytes capacity:(NSUInteger)capacity length:(NSUInteger*)length error:(NSError* __autoreleasing*)error;
+-(BOOL)downloadToURL:(NSURL*)url error:(NSError* __autoreleasing*)error;
+
+//overwrites a file that the caller has already created to reserve its name, and removes it if the download fails
+-(BOOL)downloadToURL:(NSURL*)url overwrite:(BOOL)overwrite error:(NSError* __autoreleasing*)error;
+
+@end
+
+
+typedef NS_ENUM(NSUInteger, EOSWatchdogDeadline){
+
+    EOSWatchdogDeadline_Call,
+    EOSWatchdogDeadline_Transfer,
+
+    //a call that releases the camera, such as cancelling a transfer or closing the session, which is made even if the camera is unhealthy
+    EOSWatchdogDeadline_Recovery
+
+};
+
+//registers an EDSDK call with EOSWatchdog; fails with EOSError_Timeout if the owner's camera is unhealthy, unless it is a recovery call
+FOUNDATION_EXPORT EOSError EOSWatchdogBegin(id _Nullable owner, const char* call, EOSWatchdogDeadline deadline, NSUInteger* token);
+FOUNDATION_EXPORT void EOSWatchdogEnd(NSUInteger token);
+
+//the kinds of event reported by the event-dispatch probe
+typedef NS_ENUM(int, EOSProbeEvent){
+
+    EOSProbeEvent_Property,
+    EOSProbeEvent_Object,
+    EOSProbeEvent_State
+
+};
+
+//the serial number of the owner's camera for a probe or log entry, or an empty string if it hasn't been read yet; it is never read for them
+FOUNDATION_EXPORT char* EOSProbeSerialNumber(id _Nullable owner);
+FOUNDATION_EXPORT uint64_t EOSProbeNanosecondsSince(uint64_t start);
+
+//the logger's level, which is checked before anything else is done to log a message
+FOUNDATION_EXPORT _Atomic(NSInteger) EOSLogCurrentLevel;
+FOUNDATION_EXPORT void EOSLogWrite(EOSLogLevel level, const char* op, id _Nullable owner, uint64_t latencyNanoseconds, const char* format, ...) __attribute__((format(printf, 5, 6)));
+
+#define EOSLogIsEnabled(level) (atomic_load_explicit(&EOSLogCurrentLevel, memory_order_relaxed) >= (level))
+
+//logs a printf-style message; the arguments are only evaluated if the level is enabled
+#define EOSLog(level, op, owner, latencyNanoseconds, format, ...) do{ \
+    if (EOSLogIsEnabled(level)) \
+        EOSLogWrite(level, op, owner, latencyNanoseconds, format, ##__VA_ARGS__); \
+}while (0)
+
+//makes an EDSDK call under the watchdog, the SDK probes and the log, evaluating to its error code
+#define EOSWatchdogCall(owner, deadline, call) ({ \
+    NSUInteger _watchdogToken; \
+    uint64_t _probeStart = (EOSFRAMEWORK_SDK_RETURN_ENABLED() || EOSLogIsEnabled(EOSLogLevel_Debug)) ? mach_absolute_time() : 0; \
+    if (EOSFRAMEWORK_SDK_ENTRY_ENABLED()) \
+        EOSFRAMEWORK_SDK_ENTRY(EOSProbeSerialNumber(owner), (char*)#call); \
+    EOSError _watchdogError = EOSWatchdogBegin(owner, #call, deadline, &_watchdogToken); \
+    if (_watchdogError == EOSError_OK){ \
+        _watchdogError = call; \
+        EOSWatchdogEnd(_watchdogToken); \
+    } \
+    if (EOSFRAMEWORK_SDK_RETURN_ENABLED()) \
+        EOSFRAMEWORK_SDK_RETURN(EOSProbeSerialNumber(owner), (char*)#call, (int)_watchdogError, EOSProbeNanosecondsSince(_probeStart)); \
+    EOSLog(EOSLogLevel_Debug, "sdk", owner, EOSProbeNanosecondsSince(_probeStart), "%s returned 0x%x", #call, (unsigned int)_watchdogError); \
+    _watchdogError; \
+})
+
+@interface EOSCameraStatus ()
+
+//values and dates are keyed by EOSStatusField
+-(id)initWithCamera:(EOSCamera*)camera values:(NSDictionary*)values dates:(NSDictionary*)dates staleFields:(EOSStatusField)staleFields error:(nullable NSError*)error;
+
+@end
+
+
+@interface EOSFleetStatus ()
+
+-(id)initWithDate:(NSDate*)date duration:(NSTimeInterval)duration cameraStatuses:(NSArray<EOSCameraStatus*>*)cameraStatuses;
+
+@end
+
+
+@interface EOSPropertyHistory ()
+
+//the capacity is rounded up to a power of two
+-(id)initWithCapacity:(NSUInteger)capacity;
+
+@end
+
+//records a change without locking or allocating. The value is NULL if it isn't known
+FOUNDATION_EXPORT void EOSPropertyHistoryRecord(EOSPropertyHistory* _Nullable history, EOSProperty property, NSUInteger parameter, EOSPropertyChangeSource source, const void* _Nullable value, NSUInteger size);
+
+//records a change along with the value it replaced, which is NULL if it isn't known. Both values have the given size
+FOUNDATION_EXPORT void EOSPropertyHistoryRecordChange(EOSPropertyHistory* _Nullable history, EOSProperty property, NSUInteger parameter, EOSPropertyChangeSource source, const void* _Nullable value, const void* _Nullable previousValue, NSUInteger size);
+
+
+//counts the reference held by an EOSObject with EOSRefTracker, when tracking is enabled
+FOUNDATION_EXPORT void EOSRefTrackerAdd(EOSObject* object);
+FOUNDATION_EXPORT void EOSRefTrackerRemove(EOSObject* object);
+
+//counts a reference that the framework holds without a wrapper, such as a stream or an event's ref, until it is released or handed to a wrapper
+FOUNDATION_EXPORT void EOSRefTrackerAddRef(EdsBaseRef _Nullable ref, NSString* type, EOSCamera* _Nullable camera);
+FOUNDATION_EXPORT void EOSRefTrackerRemoveRef(EdsBaseRef _Nullable ref);
+
+//releases a reference, uncounting it if it was counted with EOSRefTrackerAddRef
+FOUNDATION_EXPORT EdsUInt32 EOSRefTrackerRelease(EdsBaseRef _Nullable ref);
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
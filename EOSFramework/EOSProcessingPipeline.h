@@ -0,0 +1,199 @@
+//
+//  EOSProcessingPipeline.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSFile;
+
+/*!
+ The EOSProcessingItem class describes a file passing through an EOSProcessingPipeline.
+ */
+@interface EOSProcessingItem : NSObject
+
+/*!
+ @brief The location of the file.
+ */
+@property (readonly) NSURL* fileURL;
+
+/*!
+ @brief The file on the camera that was downloaded, or nil if the file was not downloaded from a camera.
+ */
+@property (readonly, nullable) EOSFile* file;
+
+/*!
+ @brief Returns the result of a stage that has completed for the item.
+ @discussion A processor can rely on the results of the stages that it depends on, such as a thumbnail stage reading the image decoded by a decode stage.
+ @param name The name of the stage.
+ @return The result returned by the stage's processor, or nil if the stage hasn't completed.
+ */
+-(nullable id)resultForStage:(NSString*)name;
+
+@end
+
+
+
+/*!
+ @brief A processor that performs one stage of the processing of a file.
+ @param item The file.
+ @param error If unsuccessful, the processor should set this to an instance of NSError describing the problem.
+ @return If successful, the stage's result, which may be any object, otherwise nil.
+ */
+typedef id _Nullable (^EOSProcessor)(EOSProcessingItem* item, NSError* __autoreleasing* error);
+
+
+
+/*!
+ The EOSProcessingStageMetrics class describes the work done by one stage of an EOSProcessingPipeline.
+ @discussion A stage that spends a long time waiting compared with processing is limited by its maxConcurrentOperations, or by the pipeline's.
+ */
+@interface EOSProcessingStageMetrics : NSObject
+
+/*!
+ @brief The name of the stage.
+ */
+@property (readonly) NSString* name;
+
+/*!
+ @brief The maximum number of files that the stage processes at the same time.
+ */
+@property (readonly) NSUInteger maxConcurrentOperations;
+
+/*!
+ @brief The number of files that are ready for the stage and waiting for a worker.
+ */
+@property (readonly) NSUInteger queuedCount;
+
+/*!
+ @brief The number of files that the stage is processing.
+ */
+@property (readonly) NSUInteger activeCount;
+
+/*!
+ @brief The number of files that the stage has processed successfully.
+ */
+@property (readonly) NSUInteger completedCount;
+
+/*!
+ @brief The number of files that the stage failed to process.
+ */
+@property (readonly) NSUInteger failedCount;
+
+/*!
+ @brief The number of files that the stage skipped because a stage it depends on failed.
+ */
+@property (readonly) NSUInteger skippedCount;
+
+/*!
+ @brief The total time spent by the stage's processor, in seconds.
+ */
+@property (readonly) NSTimeInterval processingTime;
+
+/*!
+ @brief The total time that files spent ready for the stage before a worker took them, in seconds.
+ */
+@property (readonly) NSTimeInterval waitingTime;
+
+/*!
+ @brief The average time spent processing a file, in seconds.
+ @discussion Skipped files are not included.
+ */
+@property (readonly) NSTimeInterval averageProcessingTime;
+
+@end
+
+
+
+/*!
+ The EOSProcessingPipeline class runs the processing of downloaded files, such as decoding, making thumbnails, hashing and uploading, in the background.
+ @discussion A pipeline is a graph of named stages. Each stage runs a processor once per file, after the stages that it depends on have completed for that file, so independent stages of the same file run in parallel. The stages share a pool of workers. Whenever a worker is free, it takes the next file from whichever stage has work waiting and is under its own concurrency limit, so a busy stage borrows the capacity that other stages aren't using. When a stage fails, the stages that depend on it are skipped for that file.
+
+ Pipelines are typically attached to downloads with the EOSDownloadProcessingPipelineKey option of [EOSFile downloadWithOptions:delegate:contextInfo:], so that processing never holds up the download's callbacks or the camera's link.
+ */
+@interface EOSProcessingPipeline : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Initializes a pipeline with one worker per active processor.
+ @return The initialized EOSProcessingPipeline.
+ */
+-(id)init;
+
+/*!
+ @brief Initializes a pipeline.
+ @param maxConcurrentOperations The number of workers shared by the stages. Must be at least 1.
+ @return The initialized EOSProcessingPipeline.
+ */
+-(id)initWithMaxConcurrentOperations:(NSUInteger)maxConcurrentOperations;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The number of workers shared by the stages.
+ */
+@property (readonly) NSUInteger maxConcurrentOperations;
+
+/*!
+ @brief The names of the stages, in the order that they were added.
+ */
+@property (readonly) NSArray<NSString*>* stageNames;
+
+/*!
+ @brief The number of files that have been submitted and have not yet completed every stage.
+ */
+@property (readonly) NSUInteger pendingCount;
+
+
+
+///-------------------
+/// @name Adding Stages
+///-------------------
+
+/*!
+ @brief Adds a stage to the pipeline.
+ @discussion A stage may only depend on stages that have already been added, so the graph can't contain a cycle. Files that were submitted before the stage was added don't pass through it.
+ @param name The name of the stage, which must be unique within the pipeline.
+ @param dependencies The names of the stages that must complete for a file before this stage processes it, or nil if it depends on none.
+ @param maxConcurrentOperations The maximum number of files that the stage processes at the same time. Must be at least 1.
+ @param processor The processor, which is called on one of the pipeline's workers.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO if the name is in use or a dependency doesn't exist.
+ */
+-(BOOL)addStageWithName:(NSString*)name dependencies:(nullable NSArray<NSString*>*)dependencies maxConcurrentOperations:(NSUInteger)maxConcurrentOperations processor:(EOSProcessor)processor error:(NSError* __autoreleasing*)error;
+
+
+
+///-----------------------
+/// @name Processing Files
+///-----------------------
+
+/*!
+ @brief Passes a file through every stage of the pipeline asynchronously.
+ @param url The location of the file.
+ @param file The file on the camera that was downloaded, or nil.
+ @param completion A block invoked on the main thread once every stage has completed or been skipped for the file. Results are keyed by the names of the stages that completed. If a stage failed, error is the first failure.
+ */
+-(void)processFileAtURL:(NSURL*)url file:(nullable EOSFile*)file completion:(nullable void (^)(NSDictionary<NSString*, id>* results, NSError* _Nullable error))completion;
+
+/*!
+ @brief Returns the metrics of each stage, in the order that the stages were added.
+ @return An array of EOSProcessingStageMetrics objects.
+ */
+-(NSArray<EOSProcessingStageMetrics*>*)stageMetrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
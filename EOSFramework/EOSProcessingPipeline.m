@@ -0,0 +1,494 @@
+//
+//  EOSProcessingPipeline.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSProcessingPipeline.h>
+#import <EOSFramework/EOSError.h>
+#import "EOSPrivate.h"
+#include <pthread.h>
+
+@interface EOSProcessingStage : NSObject{
+
+    @public
+    NSString* _name;
+    NSArray* _dependencies;
+    NSMutableArray* _dependents;
+    NSUInteger _maxConcurrentOperations;
+    EOSProcessor _processor;
+
+    //the items that are ready for the stage, oldest first
+    NSMutableArray* _readyItems;
+    NSUInteger _activeCount;
+    NSUInteger _completedCount;
+    NSUInteger _failedCount;
+    NSUInteger _skippedCount;
+    NSTimeInterval _processingTime;
+    NSTimeInterval _waitingTime;
+
+}
+
+@end
+
+@implementation EOSProcessingStage
+
+@end
+
+
+
+
+@interface EOSProcessingItem (){
+
+    @public
+    NSMutableDictionary* _results;
+    NSError* _error;
+    void (^_completion)(NSDictionary*, NSError*);
+
+    //the stages that the item passes through, with the number of their dependencies that haven't completed
+    NSMapTable* _remainingDependencies;
+    NSMapTable* _readyTimes;
+    NSUInteger _unresolvedCount;
+
+}
+
+@end
+
+@implementation EOSProcessingItem
+
+-(id)initWithFileURL:(NSURL*)fileURL file:(EOSFile*)file{
+
+    self = [super init];
+    if (self){
+
+        _fileURL = fileURL;
+        _file = file;
+        _results = [NSMutableDictionary dictionary];
+        _remainingDependencies = [NSMapTable strongToStrongObjectsMapTable];
+        _readyTimes = [NSMapTable strongToStrongObjectsMapTable];
+
+    }
+
+    return self;
+
+}
+
+-(id)resultForStage:(NSString *)name{
+
+    @synchronized(self){
+        return [_results objectForKey:name];
+    }
+
+}
+
+@end
+
+
+
+
+@interface EOSProcessingStageMetrics ()
+
+-(id)initWithStage:(EOSProcessingStage*)stage;
+
+@end
+
+@implementation EOSProcessingStageMetrics
+
+//called while the pipeline's state is locked
+-(id)initWithStage:(EOSProcessingStage*)stage{
+
+    self = [super init];
+    if (self){
+
+        _name = stage->_name;
+        _maxConcurrentOperations = stage->_maxConcurrentOperations;
+        _queuedCount = [stage->_readyItems count];
+        _activeCount = stage->_activeCount;
+        _completedCount = stage->_completedCount;
+        _failedCount = stage->_failedCount;
+        _skippedCount = stage->_skippedCount;
+        _processingTime = stage->_processingTime;
+        _waitingTime = stage->_waitingTime;
+
+    }
+
+    return self;
+
+}
+
+//skipped files never reached the processor, so they don't count
+-(NSTimeInterval)averageProcessingTime{
+
+    NSUInteger count = _completedCount + _failedCount;
+
+    return count > 0 ? _processingTime / count : 0;
+
+}
+
+@end
+
+
+
+
+@implementation EOSProcessingPipeline{
+
+    //the workers are borrowed from a concurrent queue, and the state is guarded by a mutex so that scheduling is cheap
+    pthread_mutex_t _mutex;
+    dispatch_queue_t _workQueue;
+    NSMutableArray* _stages;
+    NSUInteger _activeCount;
+    NSUInteger _pendingCount;
+
+    //the stage that is offered the next free worker first, so no stage is starved
+    NSUInteger _nextStageIndex;
+
+}
+
+-(id)init{
+
+    return [self initWithMaxConcurrentOperations:[[NSProcessInfo processInfo] activeProcessorCount]];
+
+}
+
+-(id)initWithMaxConcurrentOperations:(NSUInteger)maxConcurrentOperations{
+
+    self = [super init];
+    if (self){
+
+        pthread_mutex_init(&_mutex, NULL);
+        _maxConcurrentOperations = MAX(maxConcurrentOperations, 1);
+        _workQueue = dispatch_queue_create("com.EOSFramework.processing", DISPATCH_QUEUE_CONCURRENT);
+        _stages = [NSMutableArray array];
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    pthread_mutex_destroy(&_mutex);
+
+}
+
+-(NSArray*)stageNames{
+
+    NSMutableArray* names = [NSMutableArray array];
+
+    pthread_mutex_lock(&_mutex);
+
+    for (EOSProcessingStage* stage in _stages)
+        [names addObject:stage->_name];
+
+    pthread_mutex_unlock(&_mutex);
+
+    return names;
+
+}
+
+-(NSUInteger)pendingCount{
+
+    pthread_mutex_lock(&_mutex);
+    NSUInteger pendingCount = _pendingCount;
+    pthread_mutex_unlock(&_mutex);
+
+    return pendingCount;
+
+}
+
+
+
+
+#pragma mark - Adding Stages
+
+//called while the state is locked
+-(EOSProcessingStage*)stageNamed:(NSString*)name{
+
+    for (EOSProcessingStage* stage in _stages){
+
+        if ([stage->_name isEqualToString:name])
+            return stage;
+
+    }
+
+    return nil;
+
+}
+
+-(BOOL)addStageWithName:(NSString *)name dependencies:(NSArray *)dependencies maxConcurrentOperations:(NSUInteger)maxConcurrentOperations processor:(EOSProcessor)processor error:(NSError *__autoreleasing *)error{
+
+    EOSProcessingStage* stage = [[EOSProcessingStage alloc] init];
+    stage->_name = [name copy];
+    stage->_dependencies = [NSArray arrayWithArray:dependencies ?: @[]];
+    stage->_dependents = [NSMutableArray array];
+    stage->_maxConcurrentOperations = MAX(maxConcurrentOperations, 1);
+    stage->_processor = [processor copy];
+    stage->_readyItems = [NSMutableArray array];
+
+    pthread_mutex_lock(&_mutex);
+
+    BOOL isValid = [self stageNamed:name] == nil;
+
+    for (NSString* dependency in stage->_dependencies){
+
+        if ([self stageNamed:dependency] == nil)
+            isValid = NO;
+
+    }
+
+    if (!isValid){
+
+        pthread_mutex_unlock(&_mutex);
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidParameter);
+        return NO;
+
+    }
+
+    for (NSString* dependency in stage->_dependencies)
+        [[self stageNamed:dependency]->_dependents addObject:stage];
+
+    [_stages addObject:stage];
+
+    pthread_mutex_unlock(&_mutex);
+
+    return YES;
+
+}
+
+
+
+
+#pragma mark - Processing Files
+
+-(void)processFileAtURL:(NSURL *)url file:(EOSFile *)file completion:(void (^)(NSDictionary *, NSError *))completion{
+
+    EOSProcessingItem* item = [[EOSProcessingItem alloc] initWithFileURL:url file:file];
+    item->_completion = [completion copy];
+
+    pthread_mutex_lock(&_mutex);
+
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    item->_unresolvedCount = [_stages count];
+
+    //the stages are fixed for the item when it is submitted
+    for (EOSProcessingStage* stage in _stages){
+
+        [item->_remainingDependencies setObject:@([stage->_dependencies count]) forKey:stage];
+
+        if ([stage->_dependencies count] == 0)
+            [self enqueueItem:item forStage:stage time:now];
+
+    }
+
+    BOOL isComplete = item->_unresolvedCount == 0;
+
+    if (!isComplete)
+        _pendingCount++;
+
+    pthread_mutex_unlock(&_mutex);
+
+    if (isComplete)
+        [self completeItem:item];
+    else
+        [self schedule];
+
+}
+
+-(NSArray*)stageMetrics{
+
+    NSMutableArray* metrics = [NSMutableArray array];
+
+    pthread_mutex_lock(&_mutex);
+
+    for (EOSProcessingStage* stage in _stages)
+        [metrics addObject:[[EOSProcessingStageMetrics alloc] initWithStage:stage]];
+
+    pthread_mutex_unlock(&_mutex);
+
+    return metrics;
+
+}
+
+//called while the state is locked
+-(void)enqueueItem:(EOSProcessingItem*)item forStage:(EOSProcessingStage*)stage time:(NSTimeInterval)time{
+
+    [stage->_readyItems addObject:item];
+    [item->_readyTimes setObject:@(time) forKey:stage];
+
+    if (EOSFRAMEWORK_QUEUE_ENQUEUE_ENABLED())
+        EOSFRAMEWORK_QUEUE_ENQUEUE((char*)[stage->_name UTF8String], EOSProbeSerialNumber([item file]), [stage->_readyItems count]);
+
+}
+
+//hands ready items to free workers, taking turns between the stages that have work
+-(void)schedule{
+
+    NSMutableArray* tasks = [NSMutableArray array];
+
+    pthread_mutex_lock(&_mutex);
+
+    NSUInteger count = [_stages count];
+    BOOL found = YES;
+
+    while (found && _activeCount < _maxConcurrentOperations){
+
+        found = NO;
+
+        for (NSUInteger i = 0; i < count && _activeCount < _maxConcurrentOperations; i++){
+
+            EOSProcessingStage* stage = [_stages objectAtIndex:(_nextStageIndex + i) % count];
+
+            if ([stage->_readyItems count] == 0 || stage->_activeCount >= stage->_maxConcurrentOperations)
+                continue;
+
+            EOSProcessingItem* item = [stage->_readyItems firstObject];
+            [stage->_readyItems removeObjectAtIndex:0];
+
+            stage->_activeCount++;
+            _activeCount++;
+            found = YES;
+
+            if (EOSFRAMEWORK_QUEUE_DEQUEUE_ENABLED())
+                EOSFRAMEWORK_QUEUE_DEQUEUE((char*)[stage->_name UTF8String], EOSProbeSerialNumber([item file]), [stage->_readyItems count]);
+
+            [tasks addObject:@[stage, item]];
+
+        }
+
+        if (count > 0)
+            _nextStageIndex = (_nextStageIndex + 1) % count;
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+    for (NSArray* task in tasks){
+
+        dispatch_async(_workQueue, ^(void){
+            [self runStage:[task firstObject] item:[task lastObject]];
+        });
+
+    }
+
+}
+
+-(void)runStage:(EOSProcessingStage*)stage item:(EOSProcessingItem*)item{
+
+    NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+    NSError* error;
+    id result;
+
+    @autoreleasepool{
+
+        result = stage->_processor(item, &error);
+
+        if (result == nil && error == nil)
+            error = EOSCreateError(EOSError_InternalError);
+
+    }
+
+    NSTimeInterval endTime = [NSDate timeIntervalSinceReferenceDate];
+
+    EOSLog(result != nil ? EOSLogLevel_Debug : EOSLogLevel_Warning, "processing", [item file], (uint64_t)((endTime - startTime) * NSEC_PER_SEC), "%s %s for %s", [stage->_name UTF8String], result != nil ? "completed" : "failed", [[[item fileURL] lastPathComponent] UTF8String]);
+
+    pthread_mutex_lock(&_mutex);
+
+    stage->_activeCount--;
+    _activeCount--;
+    stage->_processingTime += endTime - startTime;
+    stage->_waitingTime += startTime - [[item->_readyTimes objectForKey:stage] doubleValue];
+
+    [self resolveStage:stage forItem:item result:result error:error skipped:NO time:endTime];
+
+    BOOL isComplete = item->_unresolvedCount == 0;
+
+    if (isComplete)
+        _pendingCount--;
+
+    pthread_mutex_unlock(&_mutex);
+
+    if (isComplete)
+        [self completeItem:item];
+
+    [self schedule];
+
+}
+
+//called while the state is locked; a failure skips every stage that depends on the failed one
+-(void)resolveStage:(EOSProcessingStage*)stage forItem:(EOSProcessingItem*)item result:(id)result error:(NSError*)error skipped:(BOOL)skipped time:(NSTimeInterval)time{
+
+    item->_unresolvedCount--;
+    [item->_remainingDependencies removeObjectForKey:stage];
+
+    if (result != nil){
+
+        stage->_completedCount++;
+
+        @synchronized(item){
+            [item->_results setObject:result forKey:stage->_name];
+        }
+
+    }else if (skipped){
+
+        stage->_skippedCount++;
+
+    }else{
+
+        stage->_failedCount++;
+
+        if (item->_error == nil)
+            item->_error = error;
+
+    }
+
+    for (EOSProcessingStage* dependent in stage->_dependents){
+
+        NSNumber* remaining = [item->_remainingDependencies objectForKey:dependent];
+
+        //the dependent was added after the item, or has already been skipped
+        if (remaining == nil)
+            continue;
+
+        if (result == nil){
+
+            [self resolveStage:dependent forItem:item result:nil error:error skipped:YES time:time];
+            continue;
+
+        }
+
+        [item->_remainingDependencies setObject:@([remaining unsignedIntegerValue] - 1) forKey:dependent];
+
+        if ([remaining unsignedIntegerValue] == 1)
+            [self enqueueItem:item forStage:dependent time:time];
+
+    }
+
+}
+
+-(void)completeItem:(EOSProcessingItem*)item{
+
+    void (^completion)(NSDictionary*, NSError*) = item->_completion;
+
+    if (completion == nil)
+        return;
+
+    NSDictionary* results;
+
+    @synchronized(item){
+        results = [NSDictionary dictionaryWithDictionary:item->_results];
+    }
+
+    NSError* error = item->_error;
+
+    dispatch_async(dispatch_get_main_queue(), ^(void){
+        completion(results, error);
+    });
+
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,149 @@
+//
+//  EOSPropertyHistory.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+#import <EOSFramework/EOSPropertyObject.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @brief The sources of a property change.
+ */
+typedef NS_ENUM(NSUInteger, EOSPropertyChangeSource){
+
+    EOSPropertyChangeSource_Camera,     //the camera reported that the value changed
+    EOSPropertyChangeSource_Framework   //the framework wrote the value
+
+};
+
+
+
+
+/*!
+ The EOSPropertyChange class describes one entry in an EOSPropertyHistory.
+ */
+@interface EOSPropertyChange : NSObject
+
+/*!
+ @brief The position of the change in the camera's history. The first change is 0.
+ */
+@property (readonly) UInt64 sequenceNumber;
+
+/*!
+ @brief The property.
+ */
+@property (readonly) EOSProperty property;
+
+/*!
+ @brief The property's parameter.
+ */
+@property (readonly) NSUInteger parameter;
+
+/*!
+ @brief The source of the change.
+ */
+@property (readonly) EOSPropertyChangeSource source;
+
+/*!
+ @brief The new value, or nil if it isn't known or isn't a number.
+ @discussion The camera reports that a value has changed, but not what it changed to, so changes reported by the camera only have a value for properties whose values are 32 bit numbers, which are read when the change is reported.
+ */
+@property (readonly, nullable) NSNumber* value;
+
+/*!
+ @brief The value that the change replaced, or nil if it isn't known.
+ @discussion The framework reads a numeric value before writing it, so this is the camera's value at the time of the write. Otherwise it is the value of the previous entry for the same property and parameter; an entry without a value means the value before the entries after it isn't known.
+ */
+@property (readonly, nullable) NSNumber* previousValue;
+
+/*!
+ @brief The time of the change, in seconds since the computer started. This clock never goes backwards.
+ */
+@property (readonly) NSTimeInterval timestamp;
+
+/*!
+ @brief The time of the change.
+ @discussion This is derived from timestamp, so it is affected by changes to the system clock made since.
+ */
+@property (readonly) NSDate* date;
+
+/*!
+ @brief A property list representation of the change, as used by [EOSPropertyHistory writeToURL:error:].
+ */
+@property (readonly) NSDictionary<NSString*, id>* dictionaryRepresentation;
+
+@end
+
+
+
+
+/*!
+ The EOSPropertyHistory class records the recent property changes of a camera. Each EOSCamera has one.
+ @discussion Every property change event from the camera, and every value written through the framework, is recorded with a timestamp. A write is usually followed by an event from the camera for the same property.
+
+ The history is a fixed-size ring. Once it is full, each new entry overwrites the oldest. Recording never takes a lock or allocates memory, so it adds almost nothing to the event path, and it may happen on any thread while the history is read.
+ */
+@interface EOSPropertyHistory : NSObject
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The number of entries that the history holds.
+ */
+@property (readonly) NSUInteger capacity;
+
+/*!
+ @brief The number of entries that have been recorded, including those that have been overwritten.
+ */
+@property (readonly) UInt64 recordedCount;
+
+
+
+///-----------------------
+/// @name Reading Changes
+///-----------------------
+
+/*!
+ @brief Gets the entries in the history, oldest first.
+ @return An array of EOSPropertyChange objects.
+ */
+-(NSArray<EOSPropertyChange*>*)changes;
+
+/*!
+ @brief Gets the entries in the history for one property, oldest first.
+ @param property The property.
+ @return An array of EOSPropertyChange objects.
+ */
+-(NSArray<EOSPropertyChange*>*)changesForProperty:(EOSProperty)property;
+
+/*!
+ @brief Gets the entries in the history that were recorded at or after a time, oldest first.
+ @param timestamp A time, in seconds since the computer started, as in [EOSPropertyChange timestamp].
+ @return An array of EOSPropertyChange objects.
+ */
+-(NSArray<EOSPropertyChange*>*)changesSinceTimestamp:(NSTimeInterval)timestamp;
+
+
+
+///------------------------
+/// @name Exporting Changes
+///------------------------
+
+/*!
+ @brief Writes the entries in the history to a file as a JSON array, oldest first.
+ @param url The location of the file.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return YES if successful, otherwise NO.
+ */
+-(BOOL)writeToURL:(NSURL*)url error:(NSError* __autoreleasing*)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,310 @@
+//
+//  EOSPropertyHistory.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSPropertyHistory.h>
+#import "EOSPrivate.h"
+
+#import <stdatomic.h>
+#import <mach/mach_time.h>
+
+#define EOSPropertyHistorySourceShift   32
+#define EOSPropertyHistoryHasValue      (1ULL << 40)
+#define EOSPropertyHistoryHasPrevious   (1ULL << 41)
+
+//one entry of the ring. The sequence is odd while the entry is being written, and 2 * (index + 1) once it has been
+typedef struct{
+
+    _Atomic uint64_t sequence;
+    _Atomic uint64_t timestamp;
+    _Atomic uint64_t property;
+    _Atomic uint64_t info;  //the parameter, the source and whether there is a value and a previous value
+    _Atomic int64_t value;
+    _Atomic int64_t previousValue;
+
+} EOSPropertyHistorySlot;
+
+static double EOSPropertyHistorySecondsPerTick(void){
+
+    static double secondsPerTick;
+    static dispatch_once_t pred = 0;
+
+    dispatch_once(&pred, ^{
+
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        secondsPerTick = (double)timebase.numer / timebase.denom / NSEC_PER_SEC;
+
+    });
+
+    return secondsPerTick;
+
+}
+
+
+
+
+@implementation EOSPropertyChange
+
+-(id)initWithSequenceNumber:(UInt64)sequenceNumber property:(EOSProperty)property parameter:(NSUInteger)parameter source:(EOSPropertyChangeSource)source value:(NSNumber*)value timestamp:(NSTimeInterval)timestamp{
+
+    self = [super init];
+    if (self){
+
+        _sequenceNumber = sequenceNumber;
+        _property = property;
+        _parameter = parameter;
+        _source = source;
+        _value = value;
+        _timestamp = timestamp;
+
+    }
+
+    return self;
+
+}
+
+-(void)setPreviousValue:(NSNumber*)previousValue{
+
+    _previousValue = previousValue;
+
+}
+
+-(NSDate*)date{
+
+    NSTimeInterval now = mach_absolute_time() * EOSPropertyHistorySecondsPerTick();
+    return [NSDate dateWithTimeIntervalSinceNow:_timestamp - now];
+
+}
+
+-(NSDictionary*)dictionaryRepresentation{
+
+    NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
+
+    [dictionary setObject:@(_sequenceNumber) forKey:@"sequence"];
+    [dictionary setObject:@(_property) forKey:@"property"];
+    [dictionary setObject:@(_parameter) forKey:@"parameter"];
+    [dictionary setObject:(_source == EOSPropertyChangeSource_Framework) ? @"framework" : @"camera" forKey:@"source"];
+    [dictionary setObject:@(_timestamp) forKey:@"timestamp"];
+    [dictionary setObject:@([[self date] timeIntervalSince1970]) forKey:@"date"];
+
+    if (_value != nil)
+        [dictionary setObject:_value forKey:@"value"];
+
+    if (_previousValue != nil)
+        [dictionary setObject:_previousValue forKey:@"previousValue"];
+
+    return [NSDictionary dictionaryWithDictionary:dictionary];
+
+}
+
+@end
+
+
+
+
+@implementation EOSPropertyHistory{
+
+    EOSPropertyHistorySlot* _slots;
+    NSUInteger _mask;
+    _Atomic uint64_t _head;
+
+}
+
+-(id)initWithCapacity:(NSUInteger)capacity{
+
+    self = [super init];
+    if (self){
+
+        //a power of two, so the slot is found with a mask
+        _capacity = 1;
+
+        while (_capacity < MAX(capacity, 1))
+            _capacity <<= 1;
+
+        _mask = _capacity - 1;
+        _slots = calloc(_capacity, sizeof(EOSPropertyHistorySlot));
+        atomic_init(&_head, 0);
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    free(_slots);
+
+}
+
+-(UInt64)recordedCount{
+
+    return atomic_load_explicit(&_head, memory_order_relaxed);
+
+}
+
+//numbers are stored, other values aren't
+static BOOL EOSPropertyHistoryNumber(const void* value, NSUInteger size, int64_t* number){
+
+    if (value == NULL)
+        return NO;
+
+    if (size == sizeof(UInt8))
+        *number = *(const UInt8*)value;
+    else if (size == sizeof(UInt16))
+        *number = *(const UInt16*)value;
+    else if (size == sizeof(UInt32))
+        *number = *(const UInt32*)value;
+    else if (size == sizeof(UInt64))
+        *number = *(const int64_t*)value;
+    else
+        return NO;
+
+    return YES;
+
+}
+
+void EOSPropertyHistoryRecord(EOSPropertyHistory* history, EOSProperty property, NSUInteger parameter, EOSPropertyChangeSource source, const void* value, NSUInteger size){
+
+    EOSPropertyHistoryRecordChange(history, property, parameter, source, value, NULL, size);
+
+}
+
+//a plain function, so recording costs no message send
+void EOSPropertyHistoryRecordChange(EOSPropertyHistory* history, EOSProperty property, NSUInteger parameter, EOSPropertyChangeSource source, const void* value, const void* previousValue, NSUInteger size){
+
+    if (history == nil)
+        return;
+
+    uint64_t info = ((uint64_t)parameter & 0xFFFFFFFF) | ((uint64_t)source << EOSPropertyHistorySourceShift);
+    int64_t number = 0;
+    int64_t previousNumber = 0;
+
+    if (EOSPropertyHistoryNumber(value, size, &number))
+        info |= EOSPropertyHistoryHasValue;
+
+    if (EOSPropertyHistoryNumber(previousValue, size, &previousNumber))
+        info |= EOSPropertyHistoryHasPrevious;
+
+    uint64_t index = atomic_fetch_add_explicit(&history->_head, 1, memory_order_relaxed);
+    EOSPropertyHistorySlot* slot = &history->_slots[index & history->_mask];
+
+    //readers that see an odd sequence, or a different one afterwards, skip the entry
+    atomic_store_explicit(&slot->sequence, 2 * index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&slot->timestamp, mach_absolute_time(), memory_order_relaxed);
+    atomic_store_explicit(&slot->property, property, memory_order_relaxed);
+    atomic_store_explicit(&slot->info, info, memory_order_relaxed);
+    atomic_store_explicit(&slot->value, number, memory_order_relaxed);
+    atomic_store_explicit(&slot->previousValue, previousNumber, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->sequence, 2 * index + 2, memory_order_release);
+
+}
+
+
+
+
+#pragma mark - Reading Changes
+
+-(NSArray*)changes{
+
+    uint64_t head = atomic_load_explicit(&_head, memory_order_acquire);
+    uint64_t index = (head > _capacity) ? head - _capacity : 0;
+    double secondsPerTick = EOSPropertyHistorySecondsPerTick();
+
+    NSMutableArray* changes = [NSMutableArray arrayWithCapacity:(NSUInteger)(head - index)];
+    NSMutableDictionary* previousValues = [NSMutableDictionary dictionary];
+
+    for (; index < head; index++){
+
+        EOSPropertyHistorySlot* slot = &_slots[index & _mask];
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+        //still being written, or already overwritten
+        if (sequence != 2 * index + 2)
+            continue;
+
+        uint64_t timestamp = atomic_load_explicit(&slot->timestamp, memory_order_relaxed);
+        uint64_t property = atomic_load_explicit(&slot->property, memory_order_relaxed);
+        uint64_t info = atomic_load_explicit(&slot->info, memory_order_relaxed);
+        int64_t number = atomic_load_explicit(&slot->value, memory_order_relaxed);
+        int64_t previousNumber = atomic_load_explicit(&slot->previousValue, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != sequence)
+            continue;
+
+        NSUInteger parameter = (NSUInteger)(info & 0xFFFFFFFF);
+        NSNumber* value = (info & EOSPropertyHistoryHasValue) ? @(number) : nil;
+
+        EOSPropertyChange* change = [[EOSPropertyChange alloc] initWithSequenceNumber:index property:(EOSProperty)property parameter:parameter source:(EOSPropertyChangeSource)((info >> EOSPropertyHistorySourceShift) & 0xFF) value:value timestamp:timestamp * secondsPerTick];
+
+        //a value read before it was overwritten is used if there is one, otherwise it is worked out from the entries before
+        NSString* key = [NSString stringWithFormat:@"%llu.%lu", property, (unsigned long)parameter];
+
+        if (info & EOSPropertyHistoryHasPrevious)
+            [change setPreviousValue:@(previousNumber)];
+        else
+            [change setPreviousValue:[previousValues objectForKey:key]];
+
+        //an entry without a value means the previous value is no longer known
+        if (value != nil)
+            [previousValues setObject:value forKey:key];
+        else
+            [previousValues removeObjectForKey:key];
+
+        [changes addObject:change];
+
+    }
+
+    return [NSArray arrayWithArray:changes];
+
+}
+
+-(NSArray*)changesForProperty:(EOSProperty)property{
+
+    return [[self changes] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(EOSPropertyChange* change, NSDictionary* bindings){
+        return [change property] == property;
+    }]];
+
+}
+
+-(NSArray*)changesSinceTimestamp:(NSTimeInterval)timestamp{
+
+    return [[self changes] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(EOSPropertyChange* change, NSDictionary* bindings){
+        return [change timestamp] >= timestamp;
+    }]];
+
+}
+
+
+
+
+#pragma mark - Exporting Changes
+
+-(BOOL)writeToURL:(NSURL *)url error:(NSError *__autoreleasing *)error{
+
+    NSArray* changes = [self changes];
+    NSMutableArray* dictionaries = [NSMutableArray arrayWithCapacity:[changes count]];
+
+    for (EOSPropertyChange* change in changes)
+        [dictionaries addObject:[change dictionaryRepresentation]];
+
+    NSData* data = [NSJSONSerialization dataWithJSONObject:dictionaries options:NSJSONWritingPrettyPrinted error:error];
+
+    if (data == nil)
+        return NO;
+
+    return [data writeToURL:url options:NSDataWritingAtomic error:error];
+
+}
+
+@end
\ No newline at end of file
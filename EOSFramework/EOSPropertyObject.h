@@ -33,7 +33,7 @@ typedef NS_ENUM(NSUInteger, EOSProperty){
     /** A string identifying the manufacturer. */
     EOSProperty_MakerName               = kEdsPropID_MakerName,
     
-    /** Not yet supported */
+    /** The camera's clock, as an EdsTime structure in local time. EOSClockSync measures and sets the clock precisely. */
     EOSProperty_DateTime                = kEdsPropID_DateTime,
     
     /** A string identifying the camera's firmware version. */
@@ -112,6 +112,7 @@ typedef NS_ENUM(NSUInteger, EOSProperty){
      Image GPS Properties
      ----------------------------------*/
     
+    /** EOSGeotag packs and writes these properties together. */
     EOSProperty_GPSVersionID    = kEdsPropID_GPSVersionID,
     EOSProperty_GPSLatitudeRef  = kEdsPropID_GPSLatitudeRef,
     EOSProperty_GPSLatitude     = kEdsPropID_GPSLatitude,
@@ -9,6 +9,7 @@
 #import <EOSFramework/EOSPropertyObject.h>
 #import <EDSDK/EDSDK.h>
 #import <EOSFramework/EOSError.h>
+#import "EOSPrivate.h"
 
 @implementation EOSPropertyObject
 
@@ -19,7 +20,7 @@
     
     EdsUInt32 intSize = 0;
     
-    EOSError errorCode = EdsGetPropertySize(_baseRef, property, (EdsUInt32)parameter, dataType, &intSize);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetPropertySize(_baseRef, property, (EdsUInt32)parameter, dataType, &intSize));
     
     *size = intSize;
 
@@ -39,7 +40,7 @@
 //BOOL getValue:ofSize:forProperty:withParameter:error:
 -(BOOL)getValue:(void *)value ofSize:(NSUInteger)size forProperty:(EOSProperty)property withParameter:(NSUInteger)parameter error:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsGetPropertyData(_baseRef, property, (EdsInt32)parameter, (EdsUInt32)size, value);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetPropertyData(_baseRef, property, (EdsInt32)parameter, (EdsUInt32)size, value));
     
     if (errorCode != EOSError_OK){
         
@@ -123,7 +124,7 @@
 //BOOL setValue:ofSize:forProperty:withParameter:error:
 -(BOOL)setValue:(const void *)value ofSize:(NSUInteger)size forProperty:(EOSProperty)property withParameter:(NSUInteger)parameter error:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsSetPropertyData(_baseRef, property, (EdsInt32)parameter, (EdsUInt32)size, value);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsSetPropertyData(_baseRef, property, (EdsInt32)parameter, (EdsUInt32)size, value));
     
     if (errorCode != EOSError_OK){
         
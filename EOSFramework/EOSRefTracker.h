@@ -0,0 +1,154 @@
+//
+//  EOSRefTracker.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+
+/*!
+ @brief Posted when the number of live EDSDK object references rises above the tracker's threshold. The object of the notification is the tracker.
+ @discussion The notification is posted on the main thread, once each time the threshold is crossed.
+ */
+FOUNDATION_EXPORT NSString *const EOSRefTrackerThresholdExceededNotification;
+
+/*!
+ The EOSRefRecord class describes a live EDSDK object reference held by an EOSObject, or by the framework without a wrapper.
+ */
+@interface EOSRefRecord : NSObject
+
+/*!
+ @brief A number that identifies the reference, unique for the lifetime of the process.
+ @discussion The address of an EDSDK object can be reused once it is released, so records are compared by identifier.
+ */
+@property (readonly) NSUInteger identifier;
+
+/*!
+ @brief The class of the object that holds the reference, such as EOSCamera or EOSFile, or the type of a reference held without a wrapper, such as EdsStream for a download's stream or EdsEventRef for the ref of an object event that hasn't been handed to a wrapper yet.
+ */
+@property (readonly) NSString* type;
+
+/*!
+ @brief The camera that the reference belongs to, or nil if it doesn't belong to a camera.
+ */
+@property (readonly, weak, nullable) EOSCamera* camera;
+
+/*!
+ @brief The time that the reference was wrapped or created.
+ */
+@property (readonly) NSDate* creationDate;
+
+/*!
+ @brief The symbolicated call stack at the time that the reference was wrapped or created.
+ @discussion Backtraces are only recorded in debug builds. In release builds this is an empty array.
+ */
+@property (readonly) NSArray<NSString*>* backtrace;
+
+@end
+
+
+
+/*!
+ The EOSRefSnapshot class describes the EDSDK object references that were live at a point in time.
+ @discussion Compare two snapshots taken some time apart to find references that were wrapped and never released.
+ */
+@interface EOSRefSnapshot : NSObject
+
+/*!
+ @brief The time that the snapshot was taken.
+ */
+@property (readonly) NSDate* date;
+
+/*!
+ @brief The live references, oldest first.
+ */
+@property (readonly) NSArray<EOSRefRecord*>* records;
+
+/*!
+ @brief The number of live references of each type.
+ @discussion The keys are class names and the values are NSNumber objects.
+ */
+@property (readonly) NSDictionary<NSString*, NSNumber*>* countsByType;
+
+/*!
+ @brief Gets the live references that belong to a camera.
+ @param camera The camera.
+ @return The references, oldest first.
+ */
+-(NSArray<EOSRefRecord*>*)recordsForCamera:(EOSCamera*)camera;
+
+/*!
+ @brief Gets the references that were wrapped since an earlier snapshot and are still live.
+ @param snapshot The earlier snapshot.
+ @return The references, oldest first.
+ */
+-(NSArray<EOSRefRecord*>*)recordsAddedSinceSnapshot:(EOSRefSnapshot*)snapshot;
+
+/*!
+ @brief Gets the references in an earlier snapshot that have since been released.
+ @param snapshot The earlier snapshot.
+ @return The references, oldest first.
+ */
+-(NSArray<EOSRefRecord*>*)recordsReleasedSinceSnapshot:(EOSRefSnapshot*)snapshot;
+
+@end
+
+
+
+/*!
+ The EOSRefTracker class counts the EDSDK object references held by EOSObject instances and by the framework itself.
+ @discussion Each EOSObject releases its reference when it is deallocated, so a reference that stays live means that its wrapper is being retained somewhere, for example by a delegate that keeps every file it is sent. Over days, the memory held inside the EDSDK grows without bound.
+
+ When tracking is enabled, the tracker records the type, camera and creation time of every reference that is wrapped, along with a backtrace in debug builds. References that the framework holds without a wrapper are counted too: the streams of downloads, the camera list, and the refs of object events until they are handed to a wrapper or released, including the duplicate refs that are released when an event refers to an object that already has a wrapper. Take a snapshot when the application is idle, and another one later: any reference added in between that is still live is a likely leak. Tracking costs a lock and an allocation per reference, so it is disabled by default.
+
+ References that were wrapped or created before tracking was enabled are not counted.
+ */
+@interface EOSRefTracker : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the singleton instance of EOSRefTracker.
+ @return The singleton instance of EOSRefTracker.
+ */
++(EOSRefTracker*)sharedTracker;
+
+
+
+///---------------
+/// @name Tracking
+///---------------
+
+/*!
+ @brief Indicates whether references are being tracked. The default value is NO.
+ @discussion Disabling tracking discards the records of live references.
+ */
+@property (getter=isEnabled) BOOL enabled;
+
+/*!
+ @brief The number of live references above which EOSRefTrackerThresholdExceededNotification is posted, or 0 for no threshold. The default value is 0.
+ */
+@property NSUInteger threshold;
+
+/*!
+ @brief The number of live references.
+ */
+@property (readonly) NSUInteger liveCount;
+
+/*!
+ @brief Takes a snapshot of the live references.
+ @return The snapshot.
+ */
+-(EOSRefSnapshot*)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,555 @@
+//
+//  EOSRefTracker.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSRefTracker.h>
+#import <EOSFramework/EOSObject.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSVolume.h>
+#import <EOSFramework/EOSFile.h>
+#import <EDSDK/EDSDK.h>
+#import "EOSPrivate.h"
+#include <pthread.h>
+#include <execinfo.h>
+
+#define EOSRefTrackerMaxFrames      32
+
+//the tracker's own frame and -[EOSObject initWithBaseRef:] are dropped from the backtraces of wrappers, and the tracker's own frame from those of raw references
+#define EOSRefTrackerSkippedFrames      2
+#define EOSRefTrackerSkippedRefFrames   1
+
+NSString *const EOSRefTrackerThresholdExceededNotification = @"EOSRefTrackerThresholdExceededNotification";
+
+//read without the lock, so wrappers pay nothing while tracking is disabled
+static volatile BOOL EOSRefTrackerIsEnabled = NO;
+
+@interface EOSRefEntry : NSObject{
+
+    @public
+    NSUInteger _identifier;
+    __weak EOSObject* _object;
+    __weak EOSCamera* _camera;  //only set for references held without a wrapper
+    NSString* _type;
+    NSDate* _creationDate;
+    NSData* _frames;
+
+}
+
+@end
+
+@implementation EOSRefEntry
+
+@end
+
+
+
+@interface EOSRefRecord ()
+
+-(id)initWithEntry:(EOSRefEntry*)entry camera:(EOSCamera*)camera;
+
+@end
+
+@implementation EOSRefRecord{
+
+    NSData* _frames;
+
+}
+
+-(id)initWithEntry:(EOSRefEntry *)entry camera:(EOSCamera *)camera{
+
+    self = [super init];
+    if (self){
+
+        _identifier = entry->_identifier;
+        _type = entry->_type;
+        _creationDate = entry->_creationDate;
+        _camera = camera;
+        _frames = entry->_frames;
+
+    }
+
+    return self;
+
+}
+
+//symbolication is slow, so it waits until the backtrace is asked for
+-(NSArray*)backtrace{
+
+    NSUInteger count = [_frames length] / sizeof(void*);
+
+    if (count == 0)
+        return @[];
+
+    char** symbols = backtrace_symbols((void* const*)[_frames bytes], (int)count);
+    NSMutableArray* backtrace = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++)
+        [backtrace addObject:@(symbols[i])];
+
+    free(symbols);
+
+    return backtrace;
+
+}
+
+-(NSString*)description{
+
+    return [NSString stringWithFormat:@"<%@: #%lu %@ %@>", [self class], (unsigned long)_identifier, _type, _creationDate];
+
+}
+
+@end
+
+
+
+@interface EOSRefSnapshot ()
+
+-(id)initWithRecords:(NSArray*)records;
+
+@end
+
+@implementation EOSRefSnapshot{
+
+    NSSet* _identifiers;
+
+}
+
+-(id)initWithRecords:(NSArray *)records{
+
+    self = [super init];
+    if (self){
+
+        _date = [NSDate date];
+        _records = records;
+
+        NSMutableDictionary* countsByType = [NSMutableDictionary dictionary];
+        NSMutableSet* identifiers = [NSMutableSet setWithCapacity:[records count]];
+
+        for (EOSRefRecord* record in records){
+
+            NSUInteger count = [[countsByType objectForKey:[record type]] unsignedIntegerValue];
+            [countsByType setObject:@(count + 1) forKey:[record type]];
+            [identifiers addObject:@([record identifier])];
+
+        }
+
+        _countsByType = [NSDictionary dictionaryWithDictionary:countsByType];
+        _identifiers = [NSSet setWithSet:identifiers];
+
+    }
+
+    return self;
+
+}
+
+-(NSArray*)recordsForCamera:(EOSCamera *)camera{
+
+    NSMutableArray* records = [NSMutableArray array];
+
+    for (EOSRefRecord* record in _records){
+
+        if ([record camera] == camera)
+            [records addObject:record];
+
+    }
+
+    return records;
+
+}
+
+-(BOOL)containsIdentifier:(NSUInteger)identifier{
+
+    return [_identifiers containsObject:@(identifier)];
+
+}
+
+-(NSArray*)recordsAddedSinceSnapshot:(EOSRefSnapshot *)snapshot{
+
+    NSMutableArray* records = [NSMutableArray array];
+
+    for (EOSRefRecord* record in _records){
+
+        if (![snapshot containsIdentifier:[record identifier]])
+            [records addObject:record];
+
+    }
+
+    return records;
+
+}
+
+-(NSArray*)recordsReleasedSinceSnapshot:(EOSRefSnapshot *)snapshot{
+
+    NSMutableArray* records = [NSMutableArray array];
+
+    for (EOSRefRecord* record in [snapshot records]){
+
+        if (![self containsIdentifier:[record identifier]])
+            [records addObject:record];
+
+    }
+
+    return records;
+
+}
+
+-(NSString*)description{
+
+    return [NSString stringWithFormat:@"<%@: %lu refs %@>", [self class], (unsigned long)[_records count], _countsByType];
+
+}
+
+@end
+
+
+
+@implementation EOSRefTracker{
+
+    //wrappers are created and deallocated on any thread, including the EDSDK's callbacks
+    pthread_mutex_t _mutex;
+    NSMutableDictionary* _entries;
+
+    //references held without a wrapper, keyed by ref; the EDSDK hands out the same ref more than once, so each key has an array
+    NSMutableDictionary* _refEntries;
+    NSUInteger _refCount;
+    NSUInteger _nextIdentifier;
+    BOOL _thresholdExceeded;
+
+}
+
+@synthesize threshold = _threshold;
+
++(EOSRefTracker*)sharedTracker{
+
+    static EOSRefTracker* sharedTracker;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^(void){
+        sharedTracker = [[EOSRefTracker alloc] init];
+    });
+
+    return sharedTracker;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        pthread_mutex_init(&_mutex, NULL);
+        _entries = [NSMutableDictionary dictionary];
+        _refEntries = [NSMutableDictionary dictionary];
+        _nextIdentifier = 1;
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    pthread_mutex_destroy(&_mutex);
+
+}
+
+
+
+
+#pragma mark - Tracking
+
+-(BOOL)isEnabled{
+
+    return EOSRefTrackerIsEnabled;
+
+}
+
+-(void)setEnabled:(BOOL)enabled{
+
+    pthread_mutex_lock(&_mutex);
+
+    EOSRefTrackerIsEnabled = enabled;
+
+    if (!enabled){
+
+        [_entries removeAllObjects];
+        [_refEntries removeAllObjects];
+        _refCount = 0;
+        _thresholdExceeded = NO;
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+-(NSUInteger)threshold{
+
+    pthread_mutex_lock(&_mutex);
+    NSUInteger threshold = _threshold;
+    pthread_mutex_unlock(&_mutex);
+
+    return threshold;
+
+}
+
+-(void)setThreshold:(NSUInteger)threshold{
+
+    pthread_mutex_lock(&_mutex);
+    _threshold = threshold;
+    _thresholdExceeded = NO;
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+-(NSUInteger)liveCount{
+
+    pthread_mutex_lock(&_mutex);
+    NSUInteger count = [_entries count] + _refCount;
+    pthread_mutex_unlock(&_mutex);
+
+    return count;
+
+}
+
+//called while locked; YES the first time the threshold is crossed
+-(BOOL)didCrossThreshold{
+
+    if (_threshold > 0 && [_entries count] + _refCount > _threshold && !_thresholdExceeded){
+
+        _thresholdExceeded = YES;
+        return YES;
+
+    }
+
+    return NO;
+
+}
+
+//called while locked
+-(void)checkThresholdAfterRemoving{
+
+    //the notification is posted again the next time the threshold is crossed
+    if (_thresholdExceeded && [_entries count] + _refCount <= _threshold)
+        _thresholdExceeded = NO;
+
+}
+
+-(void)postThresholdExceeded{
+
+    dispatch_async(dispatch_get_main_queue(), ^(void){
+        [[NSNotificationCenter defaultCenter] postNotificationName:EOSRefTrackerThresholdExceededNotification object:self];
+    });
+
+}
+
+-(void)addObject:(EOSObject*)object frames:(NSData*)frames{
+
+    EOSRefEntry* entry = [[EOSRefEntry alloc] init];
+    entry->_object = object;
+    entry->_type = NSStringFromClass([object class]);
+    entry->_creationDate = [NSDate date];
+    entry->_frames = frames;
+
+    BOOL exceeded = NO;
+
+    pthread_mutex_lock(&_mutex);
+
+    if (EOSRefTrackerIsEnabled){
+
+        entry->_identifier = _nextIdentifier++;
+        [_entries setObject:entry forKey:[NSValue valueWithNonretainedObject:object]];
+        exceeded = [self didCrossThreshold];
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+    if (exceeded)
+        [self postThresholdExceeded];
+
+}
+
+-(void)addRef:(EdsBaseRef)ref type:(NSString*)type camera:(EOSCamera*)camera frames:(NSData*)frames{
+
+    EOSRefEntry* entry = [[EOSRefEntry alloc] init];
+    entry->_camera = camera;
+    entry->_type = type;
+    entry->_creationDate = [NSDate date];
+    entry->_frames = frames;
+
+    NSValue* key = [NSValue valueWithPointer:ref];
+    BOOL exceeded = NO;
+
+    pthread_mutex_lock(&_mutex);
+
+    if (EOSRefTrackerIsEnabled){
+
+        NSMutableArray* entries = [_refEntries objectForKey:key];
+
+        if (entries == nil){
+
+            entries = [NSMutableArray arrayWithCapacity:1];
+            [_refEntries setObject:entries forKey:key];
+
+        }
+
+        entry->_identifier = _nextIdentifier++;
+        [entries addObject:entry];
+        _refCount++;
+        exceeded = [self didCrossThreshold];
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+    if (exceeded)
+        [self postThresholdExceeded];
+
+}
+
+//the most recent record is removed, as the holds of the same ref can't be told apart
+-(void)removeRef:(EdsBaseRef)ref{
+
+    NSValue* key = [NSValue valueWithPointer:ref];
+
+    pthread_mutex_lock(&_mutex);
+
+    NSMutableArray* entries = [_refEntries objectForKey:key];
+
+    if (entries != nil){
+
+        [entries removeLastObject];
+        _refCount--;
+
+        if ([entries count] == 0)
+            [_refEntries removeObjectForKey:key];
+
+        [self checkThresholdAfterRemoving];
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+//the object is deallocating, so only its address is used
+-(void)removeObject:(EOSObject*)object{
+
+    pthread_mutex_lock(&_mutex);
+
+    [_entries removeObjectForKey:[NSValue valueWithNonretainedObject:object]];
+    [self checkThresholdAfterRemoving];
+
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+-(EOSRefSnapshot*)snapshot{
+
+    pthread_mutex_lock(&_mutex);
+
+    NSMutableArray* entries = [NSMutableArray arrayWithArray:[_entries allValues]];
+
+    for (NSArray* refEntries in [_refEntries allValues])
+        [entries addObjectsFromArray:refEntries];
+
+    pthread_mutex_unlock(&_mutex);
+
+    NSMutableArray* records = [NSMutableArray arrayWithCapacity:[entries count]];
+
+    //the cameras are looked up outside the lock, as releasing the last reference to a wrapper deallocates it
+    for (EOSRefEntry* entry in entries){
+
+        EOSObject* object = entry->_object;
+        EOSCamera* camera = entry->_camera;
+
+        if ([object isKindOfClass:[EOSCamera class]])
+            camera = (EOSCamera*)object;
+        else if ([object isKindOfClass:[EOSFile class]] || [object isKindOfClass:[EOSVolume class]])
+            camera = [(id)object camera];
+
+        [records addObject:[[EOSRefRecord alloc] initWithEntry:entry camera:camera]];
+
+    }
+
+    [records sortUsingComparator:^NSComparisonResult(EOSRefRecord* record1, EOSRefRecord* record2){
+        return [@([record1 identifier]) compare:@([record2 identifier])];
+    }];
+
+    return [[EOSRefSnapshot alloc] initWithRecords:records];
+
+}
+
+@end
+
+
+
+
+#pragma mark - Private Functions
+
+//inlined, so that it doesn't add a frame of its own
+static inline __attribute__((always_inline)) NSData* EOSRefTrackerBacktrace(int skipped){
+
+    NSData* frames;
+
+#ifdef DEBUG
+    void* addresses[EOSRefTrackerMaxFrames + EOSRefTrackerSkippedFrames];
+    int count = backtrace(addresses, EOSRefTrackerMaxFrames + skipped);
+
+    if (count > skipped)
+        frames = [NSData dataWithBytes:addresses + skipped length:(count - skipped) * sizeof(void*)];
+#endif
+
+    return frames;
+
+}
+
+void EOSRefTrackerAdd(EOSObject* object){
+
+    if (!EOSRefTrackerIsEnabled)
+        return;
+
+    [[EOSRefTracker sharedTracker] addObject:object frames:EOSRefTrackerBacktrace(EOSRefTrackerSkippedFrames)];
+
+}
+
+void EOSRefTrackerRemove(EOSObject* object){
+
+    if (!EOSRefTrackerIsEnabled)
+        return;
+
+    [[EOSRefTracker sharedTracker] removeObject:object];
+
+}
+
+void EOSRefTrackerAddRef(EdsBaseRef ref, NSString* type, EOSCamera* camera){
+
+    if (!EOSRefTrackerIsEnabled || ref == NULL)
+        return;
+
+    [[EOSRefTracker sharedTracker] addRef:ref type:type camera:camera frames:EOSRefTrackerBacktrace(EOSRefTrackerSkippedRefFrames)];
+
+}
+
+void EOSRefTrackerRemoveRef(EdsBaseRef ref){
+
+    if (!EOSRefTrackerIsEnabled || ref == NULL)
+        return;
+
+    [[EOSRefTracker sharedTracker] removeRef:ref];
+
+}
+
+EdsUInt32 EOSRefTrackerRelease(EdsBaseRef ref){
+
+    EOSRefTrackerRemoveRef(ref);
+
+    return EdsRelease(ref);
+
+}
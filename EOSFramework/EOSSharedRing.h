@@ -0,0 +1,186 @@
+//
+//  EOSSharedRing.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @brief The maximum number of consumers that can be attached to a shared ring.
+ */
+#define EOSSharedRingMaxConsumers 64
+
+@class EOSSharedRing;
+
+/*!
+ The EOSSharedSlot class represents one slot of an EOSSharedRing. Instances of this class are created by EOSSharedRing.
+ */
+@interface EOSSharedSlot : NSObject
+
+/*!
+ @brief The ring that the slot belongs to.
+ */
+@property (readonly) EOSSharedRing* ring;
+
+/*!
+ @brief The index of the slot within the ring.
+ */
+@property (readonly) NSUInteger index;
+
+/*!
+ @brief The start of the slot's memory.
+ @discussion The memory is shared with other processes, and is only valid while the slot is held.
+ */
+@property (readonly) void* bytes;
+
+/*!
+ @brief The capacity of the slot, in bytes.
+ */
+@property (readonly) NSUInteger capacity;
+
+/*!
+ @brief The length of the data in the slot, in bytes.
+ @discussion The producer sets this value after writing to the slot, before publishing it.
+ */
+@property NSUInteger length;
+
+/*!
+ @brief The sequence number of the published data. Sequence numbers increase with each publication.
+ */
+@property (readonly) UInt64 sequence;
+
+/*!
+ @brief Returns the published data without copying it.
+ @discussion The data must not be used after the slot is released.
+ @return An NSData object that refers to the slot's memory.
+ */
+-(NSData*)data;
+
+@end
+
+
+
+/*!
+ The EOSSharedRing class is a ring of fixed size slots in memory that is shared between processes.
+ @discussion A ring has one producer and up to 64 consumers. The producer creates the ring and passes its file descriptor to consumers, for example with EOSDaemon. The producer acquires a free slot, writes into it directly - [EOSFile downloadToSharedRing:error:] downloads a file straight into a slot - and publishes it to a set of consumers. Each consumer reads the slot in place and releases it when finished; the slot becomes free again once every consumer has released it. No data is copied between processes.
+
+ The reference count of each slot is a bitmask of the consumers still holding it, stored in the shared memory and updated atomically, so a consumer that disconnects can be released by the producer without its cooperation.
+ */
+@interface EOSSharedRing : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Creates a new ring, as its producer.
+ @discussion The shared memory is anonymous; it can only be reached through the fileDescriptor property. Memory is only committed as slots are used.
+ @param slotCount The number of slots.
+ @param slotSize The minimum capacity of each slot, in bytes. This is rounded up to a whole number of pages.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSSharedRing, or nil if the shared memory could not be created.
+ */
+-(nullable id)initWithSlotCount:(NSUInteger)slotCount slotSize:(NSUInteger)slotSize error:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Maps a ring created by another process, as a consumer.
+ @discussion The ring takes ownership of the file descriptor.
+ @param fileDescriptor The file descriptor of the ring's shared memory.
+ @param consumerIndex The index of this consumer, assigned by the producer.
+ @param error If unsuccessful, an instance of NSError describes the problem.
+ @return The initialized EOSSharedRing, or nil if the shared memory is not a valid ring.
+ */
+-(nullable id)initWithFileDescriptor:(int)fileDescriptor consumerIndex:(NSUInteger)consumerIndex error:(NSError* __autoreleasing*)error;
+
+
+
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The file descriptor of the shared memory.
+ */
+@property (readonly) int fileDescriptor;
+
+/*!
+ @brief Indicates whether this process is the producer of the ring.
+ */
+@property (readonly) BOOL isProducer;
+
+/*!
+ @brief The number of slots.
+ */
+@property (readonly) NSUInteger slotCount;
+
+/*!
+ @brief The capacity of each slot, in bytes.
+ */
+@property (readonly) NSUInteger slotSize;
+
+/*!
+ @brief The index of this consumer, or NSNotFound if this process is the producer.
+ */
+@property (readonly) NSUInteger consumerIndex;
+
+
+
+///-----------------
+/// @name Producing
+///-----------------
+
+/*!
+ @brief Acquires a free slot for writing.
+ @param error If no slot is free, an instance of NSError describes the problem.
+ @return The slot, or nil if no slot is free.
+ */
+-(nullable EOSSharedSlot*)acquireSlot:(NSError* __autoreleasing*)error;
+
+/*!
+ @brief Publishes a slot that has been written to.
+ @discussion The length of the slot must be set before it is published. If consumers is 0, the slot is free again immediately.
+ @param slot A slot returned by acquireSlot:.
+ @param consumers A bitmask of the consumers that the slot is published to, where bit n represents the consumer with index n.
+ */
+-(void)publishSlot:(EOSSharedSlot*)slot consumers:(UInt64)consumers;
+
+/*!
+ @brief Returns a slot without publishing it.
+ @param slot A slot returned by acquireSlot:.
+ */
+-(void)abandonSlot:(EOSSharedSlot*)slot;
+
+/*!
+ @brief Releases every slot held by a consumer.
+ @discussion Use this method when a consumer disconnects.
+ @param consumerIndex The index of the consumer.
+ */
+-(void)releaseSlotsForConsumer:(NSUInteger)consumerIndex;
+
+
+
+///-----------------
+/// @name Consuming
+///-----------------
+
+/*!
+ @brief Gets a published slot.
+ @param index The index of the slot, as sent by the producer.
+ @return The slot, or nil if the index is invalid or the slot is not held by this consumer.
+ */
+-(nullable EOSSharedSlot*)slotAtIndex:(NSUInteger)index;
+
+/*!
+ @brief Releases a slot held by this consumer.
+ @param slot The slot.
+ */
+-(void)releaseSlot:(EOSSharedSlot*)slot;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,337 @@
+//
+//  EOSSharedRing.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSSharedRing.h>
+#import <EOSFramework/EOSError.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define EOSSharedRingMagic      0x52534F45 //"EOSR"
+#define EOSSharedRingVersion    1
+#define EOSSharedRingLineSize   64
+
+typedef NS_ENUM(UInt32, EOSSharedSlotState){
+
+    EOSSharedSlotState_Free         = 0,
+    EOSSharedSlotState_Writing      = 1,
+    EOSSharedSlotState_Published    = 2
+
+};
+
+//the layout of the shared memory is: ring header, slot headers, then page aligned slot data
+typedef struct{
+
+    UInt32 magic;
+    UInt32 version;
+    UInt32 slotCount;
+    UInt32 reserved;
+    UInt64 slotSize;
+    UInt64 dataOffset;
+    _Atomic UInt64 sequence;
+
+} EOSSharedRingHeader;
+
+typedef struct{
+
+    //bitmask of consumers still holding the slot
+    _Atomic UInt64 consumers;
+    _Atomic UInt32 state;
+    UInt32 reserved;
+    UInt64 length;
+    UInt64 sequence;
+
+} EOSSharedSlotHeader;
+
+
+
+
+@interface EOSSharedSlot ()
+
+-(id)initWithRing:(EOSSharedRing*)ring index:(NSUInteger)index bytes:(void*)bytes capacity:(NSUInteger)capacity length:(NSUInteger)length sequence:(UInt64)sequence;
+
+@end
+
+@implementation EOSSharedSlot
+
+-(id)initWithRing:(EOSSharedRing *)ring index:(NSUInteger)index bytes:(void *)bytes capacity:(NSUInteger)capacity length:(NSUInteger)length sequence:(UInt64)sequence{
+
+    self = [super init];
+    if (self){
+
+        _ring = ring;
+        _index = index;
+        _bytes = bytes;
+        _capacity = capacity;
+        _length = length;
+        _sequence = sequence;
+
+    }
+
+    return self;
+
+}
+
+-(NSData*)data{
+
+    return [NSData dataWithBytesNoCopy:_bytes length:_length freeWhenDone:NO];
+
+}
+
+@end
+
+
+
+
+@implementation EOSSharedRing{
+
+    void* _memory;
+    size_t _mappedLength;
+
+}
+
+-(id)initWithSlotCount:(NSUInteger)slotCount slotSize:(NSUInteger)slotSize error:(NSError *__autoreleasing *)error{
+
+    self = [super init];
+    if (self){
+
+        static _Atomic UInt32 counter = 0;
+
+        size_t pageSize = getpagesize();
+        size_t headersLength = EOSSharedRingLineSize * (1 + slotCount);
+
+        _isProducer = YES;
+        _consumerIndex = NSNotFound;
+        _slotCount = slotCount;
+        _slotSize = ((MAX(slotSize, 1) + pageSize - 1) / pageSize) * pageSize;
+        _mappedLength = ((headersLength + pageSize - 1) / pageSize) * pageSize + _slotCount * _slotSize;
+        _fileDescriptor = -1;
+
+        if (slotCount == 0){
+
+            if (error)
+                *error = EOSCreateError(EOSError_InvalidParameter);
+            return nil;
+
+        }
+
+        //the name is removed straight away, so the memory can only be reached through the descriptor
+        NSString* name = [NSString stringWithFormat:@"/eosring.%d.%u", getpid(), atomic_fetch_add(&counter, 1)];
+
+        _fileDescriptor = shm_open([name UTF8String], O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+
+        if (_fileDescriptor >= 0)
+            shm_unlink([name UTF8String]);
+
+        if (_fileDescriptor < 0 || ftruncate(_fileDescriptor, _mappedLength) != 0 || ![self map]){
+
+            if (error)
+                *error = EOSCreateError(EOSError_Device_MemoryFull);
+            return nil;
+
+        }
+
+        EOSSharedRingHeader* header = _memory;
+        header->magic = EOSSharedRingMagic;
+        header->version = EOSSharedRingVersion;
+        header->slotCount = (UInt32)_slotCount;
+        header->slotSize = _slotSize;
+        header->dataOffset = _mappedLength - _slotCount * _slotSize;
+        atomic_init(&header->sequence, 0);
+
+        NSUInteger i;
+        for (i=0; i<_slotCount; i++){
+
+            EOSSharedSlotHeader* slotHeader = [self headerForSlot:i];
+            atomic_init(&slotHeader->consumers, 0);
+            atomic_init(&slotHeader->state, EOSSharedSlotState_Free);
+
+        }
+
+    }
+
+    return self;
+
+}
+
+-(id)initWithFileDescriptor:(int)fileDescriptor consumerIndex:(NSUInteger)consumerIndex error:(NSError *__autoreleasing *)error{
+
+    self = [super init];
+    if (self){
+
+        _isProducer = NO;
+        _consumerIndex = consumerIndex;
+        _fileDescriptor = fileDescriptor;
+
+        struct stat info;
+        BOOL valid = consumerIndex < EOSSharedRingMaxConsumers && fstat(fileDescriptor, &info) == 0 && info.st_size >= EOSSharedRingLineSize;
+
+        if (valid){
+
+            _mappedLength = (size_t)info.st_size;
+            valid = [self map];
+
+        }
+
+        if (valid){
+
+            EOSSharedRingHeader* header = _memory;
+            _slotCount = header->slotCount;
+            _slotSize = (NSUInteger)header->slotSize;
+
+            valid = header->magic == EOSSharedRingMagic && header->version == EOSSharedRingVersion && header->dataOffset + _slotCount * _slotSize <= _mappedLength && EOSSharedRingLineSize * (1 + _slotCount) <= header->dataOffset;
+
+        }
+
+        if (!valid){
+
+            if (error)
+                *error = EOSCreateError(EOSError_InvalidParameter);
+            return nil;
+
+        }
+
+    }
+
+    return self;
+
+}
+
+-(BOOL)map{
+
+    void* memory = mmap(NULL, _mappedLength, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+
+    if (memory == MAP_FAILED)
+        return NO;
+
+    _memory = memory;
+    return YES;
+
+}
+
+-(void)dealloc{
+
+    if (_memory != NULL)
+        munmap(_memory, _mappedLength);
+
+    if (_fileDescriptor >= 0)
+        close(_fileDescriptor);
+
+}
+
+-(EOSSharedSlotHeader*)headerForSlot:(NSUInteger)index{
+
+    return (EOSSharedSlotHeader*)((UInt8*)_memory + EOSSharedRingLineSize * (1 + index));
+
+}
+
+-(void*)bytesForSlot:(NSUInteger)index{
+
+    EOSSharedRingHeader* header = _memory;
+    return (UInt8*)_memory + header->dataOffset + index * _slotSize;
+
+}
+
+
+
+
+#pragma mark - Producing
+
+-(EOSSharedSlot*)acquireSlot:(NSError *__autoreleasing *)error{
+
+    EOSSharedRingHeader* header = _memory;
+    NSUInteger i, start = (NSUInteger)(atomic_load(&header->sequence) % _slotCount);
+
+    //start after the last published slot, so the oldest slots are reused first
+    for (i=0; _isProducer && i<_slotCount; i++){
+
+        NSUInteger index = (start + i) % _slotCount;
+        EOSSharedSlotHeader* slotHeader = [self headerForSlot:index];
+
+        UInt32 state = atomic_load(&slotHeader->state);
+
+        if (state == EOSSharedSlotState_Published && atomic_load(&slotHeader->consumers) != 0)
+            continue;
+
+        if (state != EOSSharedSlotState_Writing && atomic_compare_exchange_strong(&slotHeader->state, &state, EOSSharedSlotState_Writing))
+            return [[EOSSharedSlot alloc] initWithRing:self index:index bytes:[self bytesForSlot:index] capacity:_slotSize length:0 sequence:0];
+
+    }
+
+    if (error)
+        *error = EOSCreateError(EOSError_Device_Busy);
+    return nil;
+
+}
+
+-(void)publishSlot:(EOSSharedSlot *)slot consumers:(UInt64)consumers{
+
+    EOSSharedRingHeader* header = _memory;
+    EOSSharedSlotHeader* slotHeader = [self headerForSlot:[slot index]];
+
+    slotHeader->length = MIN([slot length], _slotSize);
+    slotHeader->sequence = atomic_fetch_add(&header->sequence, 1) + 1;
+    atomic_store(&slotHeader->consumers, consumers);
+
+    //the release orders the data and header writes before the state change
+    atomic_store_explicit(&slotHeader->state, EOSSharedSlotState_Published, memory_order_release);
+
+}
+
+-(void)abandonSlot:(EOSSharedSlot *)slot{
+
+    EOSSharedSlotHeader* slotHeader = [self headerForSlot:[slot index]];
+    atomic_store(&slotHeader->state, EOSSharedSlotState_Free);
+
+}
+
+-(void)releaseSlotsForConsumer:(NSUInteger)consumerIndex{
+
+    if (consumerIndex >= EOSSharedRingMaxConsumers)
+        return;
+
+    NSUInteger i;
+    for (i=0; i<_slotCount; i++)
+        atomic_fetch_and(&[self headerForSlot:i]->consumers, ~(1ULL << consumerIndex));
+
+}
+
+
+
+
+#pragma mark - Consuming
+
+-(EOSSharedSlot*)slotAtIndex:(NSUInteger)index{
+
+    if (index >= _slotCount)
+        return nil;
+
+    EOSSharedSlotHeader* slotHeader = [self headerForSlot:index];
+
+    if (atomic_load_explicit(&slotHeader->state, memory_order_acquire) != EOSSharedSlotState_Published)
+        return nil;
+
+    if (!_isProducer && (atomic_load(&slotHeader->consumers) & (1ULL << _consumerIndex)) == 0)
+        return nil;
+
+    return [[EOSSharedSlot alloc] initWithRing:self index:index bytes:[self bytesForSlot:index] capacity:_slotSize length:(NSUInteger)slotHeader->length sequence:slotHeader->sequence];
+
+}
+
+-(void)releaseSlot:(EOSSharedSlot *)slot{
+
+    if (_isProducer || [slot index] >= _slotCount)
+        return;
+
+    atomic_fetch_and(&[self headerForSlot:[slot index]]->consumers, ~(1ULL << _consumerIndex));
+
+}
+
+@end
\ No newline at end of file
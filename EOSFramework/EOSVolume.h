@@ -12,6 +12,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class EOSFile;
+@class EOSCamera;
 
 /*!
  @brief Storage types
@@ -111,9 +112,22 @@ typedef NS_ENUM(NSUInteger, EOSAccess){
 
 /*!
  The EOSVolume class is used to represent a volume that is mounted on a camera.
+ @discussion While an EOSVolume exists, every lookup or event for the same volume on the same camera returns that object.
  */
 @interface EOSVolume : EOSObject
 
+///-----------------
+/// @name Properties
+///-----------------
+
+/*!
+ @brief The camera that the volume is mounted on.
+ @discussion This is nil if the volume was not retrieved through an EOSCamera object.
+ */
+@property (readonly, weak, nullable) EOSCamera* camera;
+
+
+
 ///---------------------
 /// @name Initialization
 ///---------------------
@@ -10,12 +10,26 @@
 #import <EOSFramework/EOSFile.h>
 #import <EDSDK/EDSDK.h>
 #import <EOSFramework/EOSError.h>
+#import "EOSPrivate.h"
 
 @implementation EOSVolume
 
 -(id)initWithVolumeRef:(EdsVolumeRef)volumeRef{
     
-    return [self initWithBaseRef:volumeRef];
+    return [self initWithVolumeRef:volumeRef camera:nil];
+    
+}
+
+-(id)initWithVolumeRef:(EdsVolumeRef)volumeRef camera:(EOSCamera *)camera{
+    
+    self = [self initWithBaseRef:volumeRef];
+    if (self){
+        
+        _camera = camera;
+        
+    }
+    
+    return self;
     
 }
 
@@ -24,7 +38,7 @@
     
     EdsVolumeInfo volumeInfo;
     
-    EOSError errorCode = EdsGetVolumeInfo(_baseRef, &volumeInfo);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetVolumeInfo(_baseRef, &volumeInfo));
     
     if (errorCode != EOSError_OK){
         
@@ -42,7 +56,7 @@
     
     EdsUInt32 count;
     
-    EOSError errorCode = EdsGetChildCount(_baseRef, &count);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetChildCount(_baseRef, &count));
     
     if (errorCode != EOSError_OK){
         
@@ -60,7 +74,7 @@
     
     EdsDirectoryItemRef fileRef;
     
-    EOSError errorCode = EdsGetChildAtIndex(_baseRef, (int)index, &fileRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Call, EdsGetChildAtIndex(_baseRef, (int)index, &fileRef));
     
     if (errorCode != EOSError_OK){
         
@@ -70,7 +84,12 @@
         
     }
     
-    return [[EOSFile alloc] initWithDirectoryItemRef:fileRef];
+    EOSCamera* camera = _camera;
+
+    if (camera == nil)
+        return [[EOSFile alloc] initWithDirectoryItemRef:fileRef camera:nil volume:self];
+
+    return [camera internDirectoryItemRef:fileRef volume:self];
     
 }
 
@@ -99,7 +118,7 @@
 
 -(BOOL)format:(NSError *__autoreleasing *)error{
     
-    EOSError errorCode = EdsFormatVolume(_baseRef);
+    EOSError errorCode = EOSWatchdogCall(self, EOSWatchdogDeadline_Transfer, EdsFormatVolume(_baseRef));
     if (errorCode != EOSError_OK){
         
         if (error)
@@ -0,0 +1,97 @@
+//
+//  EOSWatchdog.h
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class EOSCamera;
+
+/*!
+ @brief Posted on the main thread when a call to a camera overruns its deadline. The object of the notification is the camera.
+ @discussion The user info dictionary contains the EOSWatchdogCallKey and EOSWatchdogElapsedTimeKey keys.
+ */
+FOUNDATION_EXPORT NSString *const EOSCameraDidHangNotification;
+
+/*!
+ @brief Posted on the main thread when every overdue call to an unhealthy camera has returned. The object of the notification is the camera.
+ */
+FOUNDATION_EXPORT NSString *const EOSCameraDidRecoverNotification;
+
+/*!
+ @brief An NSString naming the EDSDK call that overran its deadline.
+ */
+FOUNDATION_EXPORT NSString *const EOSWatchdogCallKey;
+
+/*!
+ @brief An NSNumber containing the time, in seconds, that the call had been running when it was reported.
+ */
+FOUNDATION_EXPORT NSString *const EOSWatchdogElapsedTimeKey;
+
+/*!
+ The EOSWatchdog class detects cameras whose EDSDK calls have hung.
+ @discussion The framework registers the start of every call it makes to a camera, such as EdsGetPropertyData or EdsDownload, with the watchdog, and unregisters it when the call returns. The watchdog checks the calls in flight once a second. When a call overruns its deadline, the camera is marked unhealthy and EOSCameraDidHangNotification is posted.
+
+ A hung call cannot be interrupted, but its camera is isolated: while a camera is unhealthy, every new call to it fails immediately with EOSError_Timeout instead of queueing behind the hung call. Cancelling a transfer and closing the session are the exceptions, as they are what releases the camera. Deadlines are measured with a monotonic clock, so changes to the system clock don't affect them. Other cameras are unaffected, and the fleet methods of EOSManager finish with an error for the unhealthy camera rather than waiting for it. When the hung call eventually returns, the camera is marked healthy again and EOSCameraDidRecoverNotification is posted.
+ */
+@interface EOSWatchdog : NSObject
+
+///---------------------
+/// @name Initialization
+///---------------------
+
+/*!
+ @brief Returns the singleton instance of EOSWatchdog.
+ @return The singleton instance of EOSWatchdog.
+ */
++(EOSWatchdog*)sharedWatchdog;
+
+
+
+///-----------------
+/// @name Deadlines
+///-----------------
+
+/*!
+ @brief The deadline for most calls, in seconds. The default value is 15.
+ */
+@property NSTimeInterval deadline;
+
+/*!
+ @brief The deadline for calls that transfer data or format volumes, in seconds. The default value is 600.
+ */
+@property NSTimeInterval transferDeadline;
+
+
+
+///-------------------------
+/// @name Monitoring Cameras
+///-------------------------
+
+/*!
+ @brief Indicates whether a camera is healthy.
+ @param camera The camera.
+ @return NO if a call to the camera has overrun its deadline and not yet returned, otherwise YES.
+ */
+-(BOOL)isCameraHealthy:(EOSCamera*)camera;
+
+/*!
+ @brief The cameras that are currently unhealthy.
+ */
+@property (readonly) NSArray<EOSCamera*>* unhealthyCameras;
+
+/*!
+ @brief Marks a camera as healthy, so that calls to it are made again.
+ @discussion Use this method to retry a camera whose hung call is not expected to return.
+ @param camera The camera.
+ */
+-(void)resetCamera:(EOSCamera*)camera;
+
+@end
+
+NS_ASSUME_NONNULL_END
\ No newline at end of file
@@ -0,0 +1,371 @@
+//
+//  EOSWatchdog.m
+//  EOSFramework
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <EOSFramework/EOSWatchdog.h>
+#import <EOSFramework/EOSCamera.h>
+#import <EOSFramework/EOSVolume.h>
+#import <EOSFramework/EOSFile.h>
+#import "EOSPrivate.h"
+#include <pthread.h>
+
+#define EOSWatchdogDefaultDeadline          15.0
+#define EOSWatchdogDefaultTransferDeadline  600.0
+#define EOSWatchdogCheckInterval            1.0
+
+NSString *const EOSCameraDidHangNotification = @"EOSCameraDidHangNotification";
+NSString *const EOSCameraDidRecoverNotification = @"EOSCameraDidRecoverNotification";
+NSString *const EOSWatchdogCallKey = @"EOSWatchdogCallKey";
+NSString *const EOSWatchdogElapsedTimeKey = @"EOSWatchdogElapsedTimeKey";
+
+@interface EOSWatchdogRecord : NSObject{
+
+    @public
+    __weak EOSCamera* _camera;
+    const char* _name;
+
+    //mach_absolute_time, so that a change to the wall clock can't make every call overdue at once
+    uint64_t _startTime;
+    EOSWatchdogDeadline _deadline;
+    BOOL _overdue;
+
+}
+
+@end
+
+@implementation EOSWatchdogRecord
+
+@end
+
+
+
+
+@implementation EOSWatchdog{
+
+    //calls are registered from any thread, so the state is guarded by a mutex rather than a queue
+    pthread_mutex_t _mutex;
+    NSMutableDictionary* _calls;
+    NSHashTable* _unhealthyCameras;
+    NSUInteger _nextToken;
+    dispatch_source_t _timer;
+
+}
+
+@synthesize deadline = _deadline;
+@synthesize transferDeadline = _transferDeadline;
+
++(EOSWatchdog*)sharedWatchdog{
+
+    static EOSWatchdog* sharedWatchdog;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^(void){
+        sharedWatchdog = [[EOSWatchdog alloc] init];
+    });
+
+    return sharedWatchdog;
+
+}
+
+-(id)init{
+
+    self = [super init];
+    if (self){
+
+        pthread_mutex_init(&_mutex, NULL);
+        _calls = [NSMutableDictionary dictionary];
+        _unhealthyCameras = [NSHashTable weakObjectsHashTable];
+        _nextToken = 1;
+        _deadline = EOSWatchdogDefaultDeadline;
+        _transferDeadline = EOSWatchdogDefaultTransferDeadline;
+
+        dispatch_queue_t queue = dispatch_queue_create("com.EOSFramework.watchdog", DISPATCH_QUEUE_SERIAL);
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+
+        __weak EOSWatchdog* weakSelf = self;
+
+        dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, EOSWatchdogCheckInterval * NSEC_PER_SEC), EOSWatchdogCheckInterval * NSEC_PER_SEC, EOSWatchdogCheckInterval * NSEC_PER_SEC / 2);
+        dispatch_source_set_event_handler(_timer, ^(void){
+            [weakSelf checkCalls];
+        });
+        dispatch_resume(_timer);
+
+    }
+
+    return self;
+
+}
+
+-(void)dealloc{
+
+    dispatch_source_cancel(_timer);
+    pthread_mutex_destroy(&_mutex);
+
+}
+
+
+
+
+#pragma mark - Registering Calls
+
+-(EOSError)beginCall:(const char*)name camera:(EOSCamera*)camera deadline:(EOSWatchdogDeadline)deadline token:(NSUInteger*)token{
+
+    EOSWatchdogRecord* call = [[EOSWatchdogRecord alloc] init];
+    call->_camera = camera;
+    call->_name = name;
+    call->_deadline = deadline;
+    call->_startTime = mach_absolute_time();
+
+    pthread_mutex_lock(&_mutex);
+
+    //fail fast rather than queue behind the hung call, except for the calls that release the camera
+    if (deadline != EOSWatchdogDeadline_Recovery && [_unhealthyCameras containsObject:camera]){
+
+        pthread_mutex_unlock(&_mutex);
+        *token = 0;
+        return EOSError_Timeout;
+
+    }
+
+    *token = _nextToken++;
+    [_calls setObject:call forKey:@(*token)];
+
+    pthread_mutex_unlock(&_mutex);
+
+    return EOSError_OK;
+
+}
+
+-(void)endCall:(NSUInteger)token{
+
+    if (token == 0)
+        return;
+
+    EOSCamera* recoveredCamera;
+
+    pthread_mutex_lock(&_mutex);
+
+    EOSWatchdogRecord* call = [_calls objectForKey:@(token)];
+    [_calls removeObjectForKey:@(token)];
+
+    EOSCamera* camera = call != nil ? call->_camera : nil;
+
+    //the camera recovers once none of its calls are overdue
+    if (call != nil && call->_overdue && camera != nil && [_unhealthyCameras containsObject:camera]){
+
+        BOOL stillOverdue = NO;
+
+        for (EOSWatchdogRecord* otherCall in [_calls allValues]){
+
+            if (otherCall->_overdue && otherCall->_camera == camera)
+                stillOverdue = YES;
+
+        }
+
+        if (!stillOverdue){
+
+            [_unhealthyCameras removeObject:camera];
+            recoveredCamera = camera;
+
+        }
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+    if (recoveredCamera != nil){
+
+        EOSLog(EOSLogLevel_Warning, "watchdog", recoveredCamera, 0, "camera recovered");
+
+        dispatch_async(dispatch_get_main_queue(), ^(void){
+            [[NSNotificationCenter defaultCenter] postNotificationName:EOSCameraDidRecoverNotification object:recoveredCamera];
+        });
+
+    }
+
+}
+
+//runs on the timer's queue
+-(void)checkCalls{
+
+    NSMutableArray* hungCalls = [NSMutableArray array];
+    NSMutableArray* elapsedTimes = [NSMutableArray array];
+
+    pthread_mutex_lock(&_mutex);
+
+    NSTimeInterval deadline = _deadline;
+    NSTimeInterval transferDeadline = _transferDeadline;
+
+    for (EOSWatchdogRecord* call in [_calls allValues]){
+
+        NSTimeInterval callDeadline = call->_deadline == EOSWatchdogDeadline_Transfer ? transferDeadline : deadline;
+        NSTimeInterval elapsedTime = (double)EOSProbeNanosecondsSince(call->_startTime) / NSEC_PER_SEC;
+        EOSCamera* camera = call->_camera;
+
+        if (call->_overdue || camera == nil || elapsedTime < callDeadline)
+            continue;
+
+        call->_overdue = YES;
+        [_unhealthyCameras addObject:camera];
+        [hungCalls addObject:call];
+        [elapsedTimes addObject:@(elapsedTime)];
+
+    }
+
+    pthread_mutex_unlock(&_mutex);
+
+    [hungCalls enumerateObjectsUsingBlock:^(EOSWatchdogRecord* call, NSUInteger i, BOOL* stop){
+
+        EOSCamera* camera = call->_camera;
+        NSTimeInterval elapsedTime = [[elapsedTimes objectAtIndex:i] doubleValue];
+
+        if (camera == nil)
+            return;
+
+        //the name is the stringified call, so only the function name is reported
+        NSString* name = [[@(call->_name) componentsSeparatedByString:@"("] firstObject];
+        NSDictionary* userInfo = @{EOSWatchdogCallKey: name, EOSWatchdogElapsedTimeKey: @(elapsedTime)};
+
+        EOSLog(EOSLogLevel_Error, "watchdog", camera, (uint64_t)(elapsedTime * NSEC_PER_SEC), "%s is overdue", [name UTF8String]);
+
+        dispatch_async(dispatch_get_main_queue(), ^(void){
+            [[NSNotificationCenter defaultCenter] postNotificationName:EOSCameraDidHangNotification object:camera userInfo:userInfo];
+        });
+
+    }];
+
+}
+
+
+
+
+#pragma mark - Monitoring Cameras
+
+-(NSTimeInterval)deadline{
+
+    pthread_mutex_lock(&_mutex);
+    NSTimeInterval deadline = _deadline;
+    pthread_mutex_unlock(&_mutex);
+
+    return deadline;
+
+}
+
+-(void)setDeadline:(NSTimeInterval)deadline{
+
+    pthread_mutex_lock(&_mutex);
+    _deadline = deadline;
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+-(NSTimeInterval)transferDeadline{
+
+    pthread_mutex_lock(&_mutex);
+    NSTimeInterval transferDeadline = _transferDeadline;
+    pthread_mutex_unlock(&_mutex);
+
+    return transferDeadline;
+
+}
+
+-(void)setTransferDeadline:(NSTimeInterval)transferDeadline{
+
+    pthread_mutex_lock(&_mutex);
+    _transferDeadline = transferDeadline;
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+-(BOOL)isCameraHealthy:(EOSCamera *)camera{
+
+    pthread_mutex_lock(&_mutex);
+    BOOL healthy = ![_unhealthyCameras containsObject:camera];
+    pthread_mutex_unlock(&_mutex);
+
+    return healthy;
+
+}
+
+-(NSArray*)unhealthyCameras{
+
+    pthread_mutex_lock(&_mutex);
+    NSArray* cameras = [_unhealthyCameras allObjects];
+    pthread_mutex_unlock(&_mutex);
+
+    return cameras;
+
+}
+
+-(void)resetCamera:(EOSCamera *)camera{
+
+    pthread_mutex_lock(&_mutex);
+    [_unhealthyCameras removeObject:camera];
+    pthread_mutex_unlock(&_mutex);
+
+}
+
+@end
+
+
+
+
+#pragma mark - Private Functions
+
+EOSError EOSWatchdogBegin(id owner, const char* call, EOSWatchdogDeadline deadline, NSUInteger* token){
+
+    EOSCamera* camera;
+
+    //files and volumes are attributed to their camera; images aren't attached to a camera
+    if ([owner isKindOfClass:[EOSCamera class]])
+        camera = owner;
+    else if ([owner isKindOfClass:[EOSFile class]] || [owner isKindOfClass:[EOSVolume class]])
+        camera = [owner camera];
+
+    if (camera == nil){
+
+        *token = 0;
+        return EOSError_OK;
+
+    }
+
+    return [[EOSWatchdog sharedWatchdog] beginCall:call camera:camera deadline:deadline token:token];
+
+}
+
+void EOSWatchdogEnd(NSUInteger token){
+
+    [[EOSWatchdog sharedWatchdog] endCall:token];
+
+}
+
+char* EOSProbeSerialNumber(id owner){
+
+    EOSCamera* camera;
+
+    if ([owner isKindOfClass:[EOSCamera class]])
+        camera = owner;
+    else if ([owner isKindOfClass:[EOSFile class]] || [owner isKindOfClass:[EOSVolume class]])
+        camera = [owner camera];
+
+    //reading the serial number would itself be an EDSDK call, and logging mustn't wait for a camera's lock
+    return (char*)(camera != nil ? [camera probeSerialNumber] : "");
+
+}
+
+uint64_t EOSProbeNanosecondsSince(uint64_t start){
+
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t pred = 0;
+
+    dispatch_once(&pred, ^{
+        mach_timebase_info(&timebase);
+    });
+
+    return (mach_absolute_time() - start) * timebase.numer / timebase.denom;
+
+}
\ No newline at end of file
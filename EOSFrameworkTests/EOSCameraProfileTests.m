@@ -0,0 +1,128 @@
+//
+//  EOSCameraProfileTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+@interface EOSCameraProfileTests : XCTestCase
+
+@end
+
+@implementation EOSCameraProfileTests
+
+-(void)appendUInt32:(UInt32)value toData:(NSMutableData*)data{
+
+    value = OSSwapHostToLittleInt32(value);
+    [data appendBytes:&value length:sizeof(value)];
+
+}
+
+//builds a profile's binary representation with the properties in the order given
+-(NSMutableData*)dataWithValues:(NSArray*)values forProperties:(NSArray*)properties{
+
+    NSMutableData* data = [NSMutableData dataWithBytes:"EOSP" length:4];
+
+    [self appendUInt32:1 toData:data];
+    [self appendUInt32:(UInt32)[properties count] toData:data];
+
+    for (NSUInteger i=0; i<[properties count]; i++){
+
+        NSData* value = [values objectAtIndex:i];
+
+        [self appendUInt32:[[properties objectAtIndex:i] unsignedIntValue] toData:data];
+        [self appendUInt32:[value length] == sizeof(UInt32) ? 9 : 2 toData:data];
+        [self appendUInt32:(UInt32)[value length] toData:data];
+        [data appendData:value];
+
+    }
+
+    return data;
+
+}
+
+-(NSData*)valueWithUInt32:(UInt32)value{
+
+    value = OSSwapHostToLittleInt32(value);
+
+    return [NSData dataWithBytes:&value length:sizeof(value)];
+
+}
+
+-(void)testDecodingSortsPropertiesByDependency{
+
+    NSArray* properties = @[@(EOSProperty_Copyright), @(EOSProperty_ShutterSpeed), @(EOSProperty_WhiteBalance), @(EOSProperty_AEMode), @(EOSProperty_ColorTemperature)];
+    NSArray* values = @[[NSData dataWithBytes:"Henry\0" length:6], [self valueWithUInt32:0x60], [self valueWithUInt32:1], [self valueWithUInt32:3], [self valueWithUInt32:5200]];
+
+    NSError* error;
+    EOSCameraProfile* profile = [[EOSCameraProfile alloc] initWithData:[self dataWithValues:values forProperties:properties] error:&error];
+
+    XCTAssertNotNil(profile, @"%@", error);
+
+    //the shooting mode comes first, the white balance before its temperature, and unranked properties last
+    NSArray* expected = @[@(EOSProperty_AEMode), @(EOSProperty_ShutterSpeed), @(EOSProperty_WhiteBalance), @(EOSProperty_ColorTemperature), @(EOSProperty_Copyright)];
+    XCTAssertEqualObjects([profile properties], expected);
+
+    for (NSUInteger i=0; i<[properties count]; i++)
+        XCTAssertEqualObjects([profile valueForProperty:[[properties objectAtIndex:i] unsignedIntegerValue]], [values objectAtIndex:i]);
+
+    XCTAssertNil([profile valueForProperty:EOSProperty_ISOSpeed]);
+
+}
+
+-(void)testEncodingRoundTrips{
+
+    NSArray* properties = @[@(EOSProperty_AEMode), @(EOSProperty_ISOSpeed), @(EOSProperty_Artist)];
+    NSArray* values = @[[self valueWithUInt32:3], [self valueWithUInt32:0x48], [NSData dataWithBytes:"Henry Betts\0" length:12]];
+
+    NSData* data = [self dataWithValues:values forProperties:properties];
+    EOSCameraProfile* profile = [[EOSCameraProfile alloc] initWithData:data error:nil];
+
+    //the properties are already in dependency order, so the encoding is identical
+    XCTAssertEqualObjects([profile data], data);
+
+    EOSCameraProfile* decoded = [[EOSCameraProfile alloc] initWithData:[profile data] error:nil];
+
+    XCTAssertEqualObjects([decoded properties], [profile properties]);
+    XCTAssertEqualObjects([decoded data], [profile data]);
+
+}
+
+-(void)testDecodingRejectsInvalidData{
+
+    NSMutableData* valid = [self dataWithValues:@[[self valueWithUInt32:3]] forProperties:@[@(EOSProperty_AEMode)]];
+    NSMutableArray* invalid = [NSMutableArray array];
+
+    //too short, wrong magic, wrong version, truncated value, trailing bytes
+    [invalid addObject:[NSData dataWithBytes:"EOS" length:3]];
+
+    NSMutableData* data = [valid mutableCopy];
+    [data replaceBytesInRange:NSMakeRange(0, 4) withBytes:"EOSX"];
+    [invalid addObject:data];
+
+    data = [valid mutableCopy];
+    [data replaceBytesInRange:NSMakeRange(4, 1) withBytes:"\x02"];
+    [invalid addObject:data];
+
+    [invalid addObject:[valid subdataWithRange:NSMakeRange(0, [valid length] - 1)]];
+
+    data = [valid mutableCopy];
+    [data appendBytes:"\0" length:1];
+    [invalid addObject:data];
+
+    for (NSData* invalidData in invalid){
+
+        NSError* error;
+
+        XCTAssertNil([[EOSCameraProfile alloc] initWithData:invalidData error:&error]);
+        XCTAssertEqual([error code], (NSInteger)EOSError_File_FormatUnrecognized);
+
+    }
+
+}
+
+@end
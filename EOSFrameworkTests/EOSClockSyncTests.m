@@ -0,0 +1,90 @@
+//
+//  EOSClockSyncTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+//measurements are recorded at a given time here, rather than waiting between them
+@interface EOSClockSync ()
+
+-(EOSClockOffset*)recordOffset:(NSTimeInterval)offset uncertainty:(NSTimeInterval)uncertainty roundTripTime:(NSTimeInterval)roundTripTime measurementDate:(NSDate*)measurementDate forCamera:(EOSCamera*)camera;
+
+@end
+
+@interface EOSClockSyncTests : XCTestCase
+
+@end
+
+@implementation EOSClockSyncTests
+
+-(void)testOffsetConvertsBetweenClocks{
+
+    NSDate* measurementDate = [NSDate dateWithTimeIntervalSinceReferenceDate:1000];
+    EOSClockOffset* offset = [[EOSClockOffset alloc] initWithOffset:2.5 uncertainty:0.02 roundTripTime:0.01 drift:0 measurementDate:measurementDate];
+    NSDate* hostDate = [NSDate dateWithTimeIntervalSinceReferenceDate:5000];
+
+    XCTAssertEqualWithAccuracy([offset offsetAtDate:hostDate], 2.5, 1e-9);
+    XCTAssertEqualWithAccuracy([[offset cameraDateForHostDate:hostDate] timeIntervalSinceReferenceDate], 5002.5, 1e-9);
+    XCTAssertEqualWithAccuracy([[offset hostDateForCameraDate:[offset cameraDateForHostDate:hostDate]] timeIntervalSinceReferenceDate], 5000, 1e-9);
+
+}
+
+-(void)testOffsetAppliesDrift{
+
+    NSDate* measurementDate = [NSDate dateWithTimeIntervalSinceReferenceDate:1000];
+    EOSClockOffset* offset = [[EOSClockOffset alloc] initWithOffset:-1 uncertainty:0.02 roundTripTime:0.01 drift:1e-4 measurementDate:measurementDate];
+    NSDate* hostDate = [NSDate dateWithTimeIntervalSinceReferenceDate:11000];
+
+    //a clock that gains 0.1ms a second has gained a second after 10000 seconds
+    XCTAssertEqualWithAccuracy([offset offsetAtDate:hostDate], 0, 1e-9);
+    XCTAssertEqualWithAccuracy([offset offsetAtDate:[NSDate dateWithTimeIntervalSinceReferenceDate:0]], -1.1, 1e-9);
+
+    //the offset is evaluated at the camera time, which is close enough to the host time
+    NSDate* cameraDate = [offset cameraDateForHostDate:hostDate];
+    XCTAssertEqualWithAccuracy([[offset hostDateForCameraDate:cameraDate] timeIntervalSinceReferenceDate], 11000, 1e-3);
+
+}
+
+-(void)testDriftIsEstimatedFromMeasurementsFarApart{
+
+    EOSClockSync* clockSync = [[EOSClockSync alloc] init];
+    EOSCamera* camera = (EOSCamera*)[[NSObject alloc] init];
+    NSDate* startDate = [NSDate dateWithTimeIntervalSinceReferenceDate:1000];
+
+    EOSClockOffset* first = [clockSync recordOffset:1.0 uncertainty:0.02 roundTripTime:0.01 measurementDate:startDate forCamera:camera];
+    XCTAssertEqual([first drift], 0.0);
+
+    //too close to the first measurement for the drift to be told apart from the uncertainty
+    EOSClockOffset* second = [clockSync recordOffset:1.03 uncertainty:0.02 roundTripTime:0.01 measurementDate:[startDate dateByAddingTimeInterval:300] forCamera:camera];
+    XCTAssertEqual([second drift], 0.0);
+
+    EOSClockOffset* third = [clockSync recordOffset:1.12 uncertainty:0.02 roundTripTime:0.01 measurementDate:[startDate dateByAddingTimeInterval:1200] forCamera:camera];
+    XCTAssertEqualWithAccuracy([third drift], 0.09 / 900, 1e-12);
+
+    //a measurement soon after keeps the estimate, as after the clock is set
+    EOSClockOffset* fourth = [clockSync recordOffset:0.01 uncertainty:0.02 roundTripTime:0.01 measurementDate:[startDate dateByAddingTimeInterval:1210] forCamera:camera];
+    XCTAssertEqualWithAccuracy([fourth drift], 0.09 / 900, 1e-12);
+    XCTAssertEqual([clockSync offsetForCamera:camera], fourth);
+
+}
+
+-(void)testOffsetsAreKeptPerCamera{
+
+    EOSClockSync* clockSync = [[EOSClockSync alloc] init];
+    EOSCamera* first = (EOSCamera*)[[NSObject alloc] init];
+    EOSCamera* second = (EOSCamera*)[[NSObject alloc] init];
+    NSDate* date = [NSDate dateWithTimeIntervalSinceReferenceDate:1000];
+
+    EOSClockOffset* offset = [clockSync recordOffset:0.5 uncertainty:0.02 roundTripTime:0.01 measurementDate:date forCamera:first];
+
+    XCTAssertEqual([clockSync offsetForCamera:first], offset);
+    XCTAssertNil([clockSync offsetForCamera:second]);
+
+}
+
+@end
@@ -0,0 +1,160 @@
+//
+//  EOSDaemonProtocolTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import "../EOSFramework/EOSDaemonProtocol.h"
+
+@interface EOSDaemonProtocolTests : XCTestCase
+
+@end
+
+@implementation EOSDaemonProtocolTests
+
+-(NSData*)frameWithRequestID:(UInt32)requestID{
+
+    NSMutableData* frame = EOSDaemonCreateFrame(requestID, EOSDaemonOpcode_SendCommand);
+
+    EOSDaemonAppendUInt32(frame, 0x01020304);
+    EOSDaemonAppendUInt16(frame, 2);
+    EOSDaemonAppendUInt8(frame, 0xAB);
+    EOSDaemonAppendString(frame, @"EOS 5D");
+    EOSDaemonFinishFrame(frame);
+
+    return frame;
+
+}
+
+-(void)testFrameRoundTrip{
+
+    NSData* frame = [self frameWithRequestID:7];
+    NSMutableData* buffer = [NSMutableData dataWithData:frame];
+    BOOL invalid = NO;
+
+    NSData* taken = EOSDaemonTakeFrame(buffer, &invalid);
+
+    XCTAssertEqualObjects(taken, frame);
+    XCTAssertFalse(invalid);
+    XCTAssertEqual([buffer length], (NSUInteger)0);
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(taken, 0);
+
+    XCTAssertEqual(EOSDaemonReadUInt32(&reader), (UInt32)[frame length] - sizeof(UInt32));
+    XCTAssertEqual(EOSDaemonReadUInt32(&reader), (UInt32)7);
+    XCTAssertEqual(EOSDaemonReadUInt8(&reader), EOSDaemonOpcode_SendCommand);
+    XCTAssertEqual(reader.offset, (NSUInteger)EOSDaemonFrameHeaderLength);
+    XCTAssertEqual(EOSDaemonReadUInt32(&reader), (UInt32)0x01020304);
+    XCTAssertEqual(EOSDaemonReadUInt16(&reader), (UInt16)2);
+    XCTAssertEqual(EOSDaemonReadUInt8(&reader), (UInt8)0xAB);
+    XCTAssertEqualObjects(EOSDaemonReadString(&reader), @"EOS 5D");
+    XCTAssertFalse(reader.failed);
+    XCTAssertEqual(reader.offset, [frame length]);
+
+}
+
+-(void)testIntegersAreLittleEndian{
+
+    NSMutableData* data = [NSMutableData data];
+    EOSDaemonAppendUInt32(data, 0x01020304);
+
+    const UInt8 expected[] = {0x04, 0x03, 0x02, 0x01};
+    XCTAssertEqualObjects(data, [NSData dataWithBytes:expected length:sizeof(expected)]);
+
+}
+
+-(void)testTakeFrameWaitsForCompleteFrame{
+
+    NSData* first = [self frameWithRequestID:1];
+    NSData* second = [self frameWithRequestID:2];
+    NSMutableData* buffer = [NSMutableData data];
+    BOOL invalid = NO;
+
+    //the first frame arrives in two reads, and the second with the end of the first
+    [buffer appendData:[first subdataWithRange:NSMakeRange(0, 6)]];
+    XCTAssertNil(EOSDaemonTakeFrame(buffer, &invalid));
+
+    [buffer appendData:[first subdataWithRange:NSMakeRange(6, [first length] - 6)]];
+    [buffer appendData:second];
+
+    XCTAssertEqualObjects(EOSDaemonTakeFrame(buffer, &invalid), first);
+    XCTAssertEqualObjects(EOSDaemonTakeFrame(buffer, &invalid), second);
+    XCTAssertNil(EOSDaemonTakeFrame(buffer, &invalid));
+    XCTAssertFalse(invalid);
+
+}
+
+-(void)testTakeFrameRejectsInvalidLengths{
+
+    UInt32 lengths[] = {0, EOSDaemonMaxFrameLength + 1};
+
+    for (NSUInteger i=0; i<sizeof(lengths) / sizeof(lengths[0]); i++){
+
+        NSMutableData* buffer = [NSMutableData data];
+        BOOL invalid = NO;
+
+        EOSDaemonAppendUInt32(buffer, lengths[i]);
+
+        XCTAssertNil(EOSDaemonTakeFrame(buffer, &invalid));
+        XCTAssertTrue(invalid);
+
+    }
+
+}
+
+-(void)testReaderFailsPastEnd{
+
+    NSMutableData* data = [NSMutableData data];
+    EOSDaemonAppendUInt16(data, 10);
+    [data appendBytes:"abc" length:3];
+
+    EOSDaemonReader reader = EOSDaemonReaderCreate(data, 0);
+
+    //the string claims more bytes than remain
+    XCTAssertNil(EOSDaemonReadString(&reader));
+    XCTAssertTrue(reader.failed);
+
+    //a failed reader stays failed
+    XCTAssertEqual(EOSDaemonReadUInt8(&reader), (UInt8)0);
+    XCTAssertTrue(reader.failed);
+
+}
+
+-(void)testDescriptorIsPassedWithFrame{
+
+    int sockets[2];
+    XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+    int pipes[2];
+    XCTAssertEqual(pipe(pipes), 0);
+
+    NSData* frame = [self frameWithRequestID:3];
+    XCTAssertTrue(EOSDaemonWriteAllWithDescriptor(sockets[0], frame, pipes[0]));
+
+    UInt8 bytes[256];
+    int received;
+    ssize_t length = EOSDaemonReadWithDescriptor(sockets[1], bytes, sizeof(bytes), &received);
+
+    XCTAssertEqual(length, (ssize_t)[frame length]);
+    XCTAssertEqualObjects([NSData dataWithBytes:bytes length:(NSUInteger)length], frame);
+    XCTAssertGreaterThanOrEqual(received, 0);
+
+    //the received descriptor reads from the same pipe
+    XCTAssertEqual(write(pipes[1], "x", 1), (ssize_t)1);
+
+    char c = 0;
+    XCTAssertEqual(read(received, &c, 1), (ssize_t)1);
+    XCTAssertEqual(c, 'x');
+
+    close(received);
+    close(pipes[0]);
+    close(pipes[1]);
+    close(sockets[0]);
+    close(sockets[1]);
+
+}
+
+@end
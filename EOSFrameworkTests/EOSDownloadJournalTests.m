@@ -0,0 +1,204 @@
+//
+//  EOSDownloadJournalTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+@interface EOSDownloadJournalTests : XCTestCase
+
+@end
+
+@implementation EOSDownloadJournalTests{
+
+    NSURL* _directoryURL;
+    NSURL* _journalURL;
+
+}
+
+-(void)setUp{
+
+    [super setUp];
+
+    _directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString] isDirectory:YES];
+    _journalURL = [_directoryURL URLByAppendingPathComponent:@"journal"];
+
+    [[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+}
+
+-(void)tearDown{
+
+    [[NSFileManager defaultManager] removeItemAtURL:_directoryURL error:nil];
+
+    [super tearDown];
+
+}
+
+//creates the file that a download would write to
+-(NSURL*)downloadedFileNamed:(NSString*)name{
+
+    NSURL* url = [_directoryURL URLByAppendingPathComponent:name];
+    [[NSData dataWithBytes:"image" length:5] writeToURL:url atomically:NO];
+
+    return url;
+
+}
+
+-(EOSDownloadJournal*)reopenJournal:(EOSDownloadJournal*)journal{
+
+    [journal close];
+
+    NSError* error;
+    EOSDownloadJournal* reopened = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:&error];
+    XCTAssertNotNil(reopened, @"%@", error);
+
+    return reopened;
+
+}
+
+-(void)testReplayRestoresCompletedDownloads{
+
+    EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:nil];
+    NSURL* url = [self downloadedFileNamed:@"IMG_0001.CR2"];
+    NSData* checksum = [NSData dataWithBytes:"0123456789abcdef0123456789abcdef" length:32];
+
+    XCTAssertTrue([journal recordIntentForIdentifier:@"A" destinationURL:url size:5 error:nil]);
+    XCTAssertTrue([journal recordCompletionForIdentifier:@"A" checksum:checksum error:nil]);
+
+    journal = [self reopenJournal:journal];
+    EOSJournalEntry* entry = [journal entryForIdentifier:@"A"];
+
+    XCTAssertEqual([entry state], EOSJournalEntryState_Completed);
+    XCTAssertEqualObjects([entry checksum], checksum);
+    XCTAssertEqual([entry size], (UInt64)5);
+    XCTAssertEqual([[journal recoveredEntries] count], (NSUInteger)0);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[url path]]);
+
+}
+
+-(void)testReplayAbortsDownloadsInProgress{
+
+    EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:nil];
+    NSURL* url = [self downloadedFileNamed:@"IMG_0002.CR2"];
+
+    XCTAssertTrue([journal recordIntentForIdentifier:@"B" destinationURL:url size:5 error:nil]);
+
+    journal = [self reopenJournal:journal];
+
+    XCTAssertEqual([[journal recoveredEntries] count], (NSUInteger)1);
+    XCTAssertEqualObjects([[[journal recoveredEntries] firstObject] identifier], @"B");
+    XCTAssertEqual([[journal entryForIdentifier:@"B"] state], EOSJournalEntryState_Aborted);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[url path]]);
+
+}
+
+-(void)testReplayDiscardsTornRecord{
+
+    EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:nil];
+    NSURL* url = [self downloadedFileNamed:@"IMG_0003.CR2"];
+
+    XCTAssertTrue([journal recordIntentForIdentifier:@"C" destinationURL:url size:5 error:nil]);
+    XCTAssertTrue([journal recordCompletionForIdentifier:@"C" checksum:[NSData data] error:nil]);
+    [journal close];
+
+    //a record whose length runs past the end of the file
+    NSFileHandle* fileHandle = [NSFileHandle fileHandleForWritingToURL:_journalURL error:nil];
+    [fileHandle seekToEndOfFile];
+    [fileHandle writeData:[NSData dataWithBytes:"\xff\x00\x00\x00\x01\x02" length:6]];
+    [fileHandle closeFile];
+
+    journal = [self reopenJournal:journal];
+
+    XCTAssertEqual([[journal entryForIdentifier:@"C"] state], EOSJournalEntryState_Completed);
+    XCTAssertTrue([journal recordIntentForIdentifier:@"D" destinationURL:url size:5 error:nil]);
+
+    journal = [self reopenJournal:journal];
+
+    XCTAssertEqual([[journal entryForIdentifier:@"D"] state], EOSJournalEntryState_Aborted);
+
+}
+
+-(void)testCompactionKeepsIntentBeingAppended{
+
+    EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:nil];
+    NSURL* url = [self downloadedFileNamed:@"IMG_0004.CR2"];
+
+    [journal setCompactionThreshold:1];
+    XCTAssertTrue([journal recordIntentForIdentifier:@"E" destinationURL:url size:5 error:nil]);
+
+    journal = [self reopenJournal:journal];
+
+    XCTAssertEqual([[journal recoveredEntries] count], (NSUInteger)1);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[url path]]);
+
+}
+
+-(void)testCompactionKeepsCompletionBeingAppended{
+
+    EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:nil];
+    NSURL* url = [self downloadedFileNamed:@"IMG_0005.CR2"];
+
+    XCTAssertTrue([journal recordIntentForIdentifier:@"F" destinationURL:url size:5 error:nil]);
+
+    [journal setCompactionThreshold:1];
+    XCTAssertTrue([journal recordCompletionForIdentifier:@"F" checksum:[NSData data] error:nil]);
+
+    journal = [self reopenJournal:journal];
+
+    //the completed download mustn't be mistaken for one that was interrupted
+    XCTAssertEqual([[journal recoveredEntries] count], (NSUInteger)0);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[url path]]);
+
+}
+
+-(void)testCompactionKeepsCompletedAndDeletedDownloads{
+
+    EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:_journalURL error:nil];
+    NSURL* completedURL = [self downloadedFileNamed:@"IMG_0006.CR2"];
+    NSURL* partialURL = [self downloadedFileNamed:@"IMG_0007.CR2"];
+    NSURL* abortedURL = [self downloadedFileNamed:@"IMG_0008.CR2"];
+    NSData* checksum = [NSData dataWithBytes:"checksum" length:8];
+
+    XCTAssertTrue([journal recordIntentForIdentifier:@"G" destinationURL:completedURL size:5 error:nil]);
+    XCTAssertTrue([journal recordCompletionForIdentifier:@"G" checksum:checksum error:nil]);
+    XCTAssertTrue([journal recordIntentForIdentifier:@"H" destinationURL:partialURL size:5 error:nil]);
+    XCTAssertTrue([journal recordIntentForIdentifier:@"I" destinationURL:abortedURL size:5 error:nil]);
+    XCTAssertTrue([journal recordAbortForIdentifier:@"I" error:nil]);
+
+    //a file that was never downloaded through the journal can still be deleted
+    XCTAssertTrue([journal recordDeletionForIdentifier:@"J" error:nil]);
+    XCTAssertTrue([journal compact:nil]);
+
+    for (NSUInteger i=0; i<2; i++){
+
+        EOSJournalEntry* completed = [journal entryForIdentifier:@"G"];
+
+        XCTAssertEqual([completed state], EOSJournalEntryState_Completed);
+        XCTAssertEqualObjects([completed checksum], checksum);
+        XCTAssertEqual([completed size], (UInt64)5);
+        XCTAssertEqualObjects([[completed destinationURL] path], [completedURL path]);
+        XCTAssertEqual([[journal entryForIdentifier:@"J"] state], EOSJournalEntryState_Deleted);
+        XCTAssertNil([journal entryForIdentifier:@"I"]);
+
+        if (i == 0){
+
+            XCTAssertEqual([[journal entryForIdentifier:@"H"] state], EOSJournalEntryState_InProgress);
+            journal = [self reopenJournal:journal];
+
+        }
+
+    }
+
+    XCTAssertEqual([[journal recoveredEntries] count], (NSUInteger)1);
+    XCTAssertEqualObjects([[[journal recoveredEntries] firstObject] identifier], @"H");
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[completedURL path]]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[partialURL path]]);
+
+}
+
+@end
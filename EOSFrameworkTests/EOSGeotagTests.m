@@ -0,0 +1,121 @@
+//
+//  EOSGeotagTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+@interface EOSGeotagTests : XCTestCase
+
+@end
+
+@implementation EOSGeotagTests
+
+-(void)assertValue:(NSData*)value isRationals:(const EdsRational*)expected count:(NSUInteger)count{
+
+    XCTAssertEqual([value length], count * sizeof(EdsRational));
+
+    EdsRational rationals[3];
+    [value getBytes:rationals length:MIN([value length], sizeof(rationals))];
+
+    for (NSUInteger i=0; i<MIN(count, 3); i++){
+
+        XCTAssertEqual(rationals[i].numerator, expected[i].numerator, @"rational %lu", (unsigned long)i);
+        XCTAssertEqual(rationals[i].denominator, expected[i].denominator, @"rational %lu", (unsigned long)i);
+
+    }
+
+}
+
+-(NSString*)stringValue:(NSData*)value{
+
+    //strings are written with their terminator
+    XCTAssertEqual(((const char*)[value bytes])[[value length] - 1], '\0');
+
+    return [NSString stringWithUTF8String:[value bytes]];
+
+}
+
+-(void)testPositionIsPackedAsDegreesMinutesSeconds{
+
+    EOSGeotag* geotag = [[EOSGeotag alloc] initWithLatitude:51.477928 longitude:-0.001545 altitude:NAN date:[NSDate date]];
+
+    EdsRational latitude[3] = {{51, 1}, {28, 1}, {40541, 1000}};
+    EdsRational longitude[3] = {{0, 1}, {0, 1}, {5562, 1000}};
+
+    [self assertValue:[geotag valueForProperty:EOSProperty_GPSLatitude] isRationals:latitude count:3];
+    [self assertValue:[geotag valueForProperty:EOSProperty_GPSLongitude] isRationals:longitude count:3];
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSLatitudeRef]], @"N");
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSLongitudeRef]], @"W");
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSMapDatum]], @"WGS-84");
+
+}
+
+-(void)testRoundingCarriesIntoMinutesAndDegrees{
+
+    EOSGeotag* geotag = [[EOSGeotag alloc] initWithLatitude:-10.9999999 longitude:180 altitude:NAN date:[NSDate date]];
+
+    EdsRational latitude[3] = {{11, 1}, {0, 1}, {0, 1000}};
+    EdsRational longitude[3] = {{180, 1}, {0, 1}, {0, 1000}};
+
+    [self assertValue:[geotag valueForProperty:EOSProperty_GPSLatitude] isRationals:latitude count:3];
+    [self assertValue:[geotag valueForProperty:EOSProperty_GPSLongitude] isRationals:longitude count:3];
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSLatitudeRef]], @"S");
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSLongitudeRef]], @"E");
+
+}
+
+-(void)testAltitudeIsOptional{
+
+    EOSGeotag* below = [[EOSGeotag alloc] initWithLatitude:0 longitude:0 altitude:-12.5 date:[NSDate date]];
+    EdsRational altitude[1] = {{1250, 100}};
+
+    [self assertValue:[below valueForProperty:EOSProperty_GPSAltitude] isRationals:altitude count:1];
+    XCTAssertEqualObjects([below valueForProperty:EOSProperty_GPSAltitudeRef], [NSData dataWithBytes:"\x01" length:1]);
+
+    EOSGeotag* unknown = [[EOSGeotag alloc] initWithLatitude:0 longitude:0 altitude:NAN date:[NSDate date]];
+
+    XCTAssertNil([unknown valueForProperty:EOSProperty_GPSAltitude]);
+    XCTAssertNil([unknown valueForProperty:EOSProperty_GPSAltitudeRef]);
+    XCTAssertFalse([[unknown properties] containsObject:@(EOSProperty_GPSAltitude)]);
+
+}
+
+-(void)testTimeIsPackedInUTC{
+
+    //2026-10-18 13:45:30 UTC
+    NSDate* date = [NSDate dateWithTimeIntervalSinceReferenceDate:814023930];
+    EOSGeotag* geotag = [[EOSGeotag alloc] initWithLatitude:0 longitude:0 altitude:NAN date:date];
+
+    EdsRational time[3] = {{13, 1}, {45, 1}, {30000, 1000}};
+
+    [self assertValue:[geotag valueForProperty:EOSProperty_GPSTimeStamp] isRationals:time count:3];
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSDateStamp]], @"2026:10:18");
+
+}
+
+-(void)testStatusIsWrittenLast{
+
+    EOSGeotag* geotag = [[EOSGeotag alloc] initWithLatitude:45 longitude:90 altitude:100 date:[NSDate date]];
+
+    XCTAssertEqualObjects([[geotag properties] lastObject], @(EOSProperty_GPSStatus));
+    XCTAssertEqualObjects([self stringValue:[geotag valueForProperty:EOSProperty_GPSStatus]], @"A");
+
+    for (NSNumber* property in [geotag properties])
+        XCTAssertNotNil([geotag valueForProperty:[property unsignedIntegerValue]]);
+
+}
+
+-(void)testOutOfRangePositionIsRejected{
+
+    XCTAssertNil([[EOSGeotag alloc] initWithLatitude:90.5 longitude:0 altitude:NAN date:[NSDate date]]);
+    XCTAssertNil([[EOSGeotag alloc] initWithLatitude:0 longitude:-180.5 altitude:NAN date:[NSDate date]]);
+    XCTAssertNil([[EOSGeotag alloc] initWithLatitude:NAN longitude:0 altitude:NAN date:[NSDate date]]);
+
+}
+
+@end
@@ -0,0 +1,197 @@
+//
+//  EOSProcessingPipelineTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+@interface EOSProcessingPipelineTests : XCTestCase
+
+@end
+
+@implementation EOSProcessingPipelineTests{
+
+    //the stages that have run, in the order that they ran
+    NSMutableArray* _runStages;
+
+}
+
+-(void)setUp{
+
+    [super setUp];
+
+    _runStages = [NSMutableArray array];
+
+}
+
+//a stage that records that it ran, and returns its name or fails
+-(void)addStageNamed:(NSString*)name dependencies:(NSArray*)dependencies fails:(BOOL)fails toPipeline:(EOSProcessingPipeline*)pipeline{
+
+    NSMutableArray* runStages = _runStages;
+
+    BOOL added = [pipeline addStageWithName:name dependencies:dependencies maxConcurrentOperations:2 processor:^id(EOSProcessingItem* item, NSError* __autoreleasing* error){
+
+        @synchronized(runStages){
+            [runStages addObject:name];
+        }
+
+        //every dependency has completed before a stage runs
+        for (NSString* dependency in dependencies){
+
+            if (![[item resultForStage:dependency] isEqual:dependency])
+                return nil;
+
+        }
+
+        if (fails){
+
+            *error = [NSError errorWithDomain:@"EOSProcessingPipelineTests" code:1 userInfo:@{@"stage": name}];
+            return nil;
+
+        }
+
+        return name;
+
+    } error:nil];
+
+    XCTAssertTrue(added);
+
+}
+
+-(void)processFileWithPipeline:(EOSProcessingPipeline*)pipeline results:(NSDictionary* __autoreleasing*)results error:(NSError* __autoreleasing*)error{
+
+    XCTestExpectation* expectation = [self expectationWithDescription:@"completion"];
+    __block NSDictionary* blockResults;
+    __block NSError* blockError;
+
+    [pipeline processFileAtURL:[NSURL fileURLWithPath:@"/tmp/IMG_0001.CR2"] file:nil completion:^(NSDictionary* completionResults, NSError* completionError){
+
+        XCTAssertTrue([NSThread isMainThread]);
+
+        blockResults = completionResults;
+        blockError = completionError;
+        [expectation fulfill];
+
+    }];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    *results = blockResults;
+    *error = blockError;
+
+}
+
+-(EOSProcessingStageMetrics*)metricsForStage:(NSString*)name ofPipeline:(EOSProcessingPipeline*)pipeline{
+
+    for (EOSProcessingStageMetrics* metrics in [pipeline stageMetrics]){
+
+        if ([[metrics name] isEqualToString:name])
+            return metrics;
+
+    }
+
+    return nil;
+
+}
+
+-(void)testStagesRunAfterTheirDependencies{
+
+    EOSProcessingPipeline* pipeline = [[EOSProcessingPipeline alloc] initWithMaxConcurrentOperations:4];
+
+    //decode feeds thumbnail and hash, and upload needs both
+    [self addStageNamed:@"decode" dependencies:nil fails:NO toPipeline:pipeline];
+    [self addStageNamed:@"thumbnail" dependencies:@[@"decode"] fails:NO toPipeline:pipeline];
+    [self addStageNamed:@"hash" dependencies:@[@"decode"] fails:NO toPipeline:pipeline];
+    [self addStageNamed:@"upload" dependencies:@[@"thumbnail", @"hash"] fails:NO toPipeline:pipeline];
+
+    NSDictionary* results;
+    NSError* error;
+    [self processFileWithPipeline:pipeline results:&results error:&error];
+
+    XCTAssertNil(error);
+    XCTAssertEqualObjects([NSSet setWithArray:[results allKeys]], ([NSSet setWithObjects:@"decode", @"thumbnail", @"hash", @"upload", nil]));
+    XCTAssertEqual([_runStages count], (NSUInteger)4);
+    XCTAssertEqualObjects([_runStages firstObject], @"decode");
+    XCTAssertEqualObjects([_runStages lastObject], @"upload");
+    XCTAssertEqual([pipeline pendingCount], (NSUInteger)0);
+
+}
+
+-(void)testFailureSkipsDependentStages{
+
+    EOSProcessingPipeline* pipeline = [[EOSProcessingPipeline alloc] initWithMaxConcurrentOperations:4];
+
+    [self addStageNamed:@"decode" dependencies:nil fails:YES toPipeline:pipeline];
+    [self addStageNamed:@"thumbnail" dependencies:@[@"decode"] fails:NO toPipeline:pipeline];
+    [self addStageNamed:@"preview" dependencies:@[@"thumbnail"] fails:NO toPipeline:pipeline];
+    [self addStageNamed:@"hash" dependencies:nil fails:NO toPipeline:pipeline];
+    [self addStageNamed:@"upload" dependencies:@[@"hash", @"decode"] fails:NO toPipeline:pipeline];
+
+    NSDictionary* results;
+    NSError* error;
+    [self processFileWithPipeline:pipeline results:&results error:&error];
+
+    //the independent stage still runs, and the failure is reported
+    XCTAssertEqualObjects(results, @{@"hash": @"hash"});
+    XCTAssertEqualObjects([error userInfo][@"stage"], @"decode");
+    XCTAssertEqualObjects([NSSet setWithArray:_runStages], ([NSSet setWithObjects:@"decode", @"hash", nil]));
+
+    XCTAssertEqual([[self metricsForStage:@"decode" ofPipeline:pipeline] failedCount], (NSUInteger)1);
+    XCTAssertEqual([[self metricsForStage:@"decode" ofPipeline:pipeline] skippedCount], (NSUInteger)0);
+
+    //the stages that were skipped, directly or through another skipped stage, aren't counted as failed
+    for (NSString* name in @[@"thumbnail", @"preview", @"upload"]){
+
+        EOSProcessingStageMetrics* metrics = [self metricsForStage:name ofPipeline:pipeline];
+
+        XCTAssertEqual([metrics skippedCount], (NSUInteger)1, @"%@", name);
+        XCTAssertEqual([metrics failedCount], (NSUInteger)0, @"%@", name);
+        XCTAssertEqual([metrics completedCount], (NSUInteger)0, @"%@", name);
+        XCTAssertEqual([metrics averageProcessingTime], 0.0, @"%@", name);
+
+    }
+
+    XCTAssertEqual([[self metricsForStage:@"hash" ofPipeline:pipeline] completedCount], (NSUInteger)1);
+    XCTAssertEqual([pipeline pendingCount], (NSUInteger)0);
+
+}
+
+-(void)testEmptyPipelineCompletesImmediately{
+
+    EOSProcessingPipeline* pipeline = [[EOSProcessingPipeline alloc] init];
+
+    NSDictionary* results;
+    NSError* error;
+    [self processFileWithPipeline:pipeline results:&results error:&error];
+
+    XCTAssertEqualObjects(results, @{});
+    XCTAssertNil(error);
+
+}
+
+-(void)testInvalidStagesAreRejected{
+
+    EOSProcessingPipeline* pipeline = [[EOSProcessingPipeline alloc] init];
+    EOSProcessor processor = ^id(EOSProcessingItem* item, NSError* __autoreleasing* error){
+        return @YES;
+    };
+    NSError* error;
+
+    XCTAssertTrue([pipeline addStageWithName:@"decode" dependencies:nil maxConcurrentOperations:1 processor:processor error:&error]);
+
+    //a stage can't be added twice, or depend on a stage that hasn't been added
+    XCTAssertFalse([pipeline addStageWithName:@"decode" dependencies:nil maxConcurrentOperations:1 processor:processor error:&error]);
+    XCTAssertEqual([error code], (NSInteger)EOSError_InvalidParameter);
+
+    XCTAssertFalse([pipeline addStageWithName:@"upload" dependencies:@[@"hash"] maxConcurrentOperations:1 processor:processor error:&error]);
+    XCTAssertEqual([error code], (NSInteger)EOSError_InvalidParameter);
+
+    XCTAssertEqualObjects([pipeline stageNames], @[@"decode"]);
+
+}
+
+@end
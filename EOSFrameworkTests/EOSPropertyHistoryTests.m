@@ -0,0 +1,126 @@
+//
+//  EOSPropertyHistoryTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+//histories are created by cameras, so the private interfaces are declared here
+@interface EOSPropertyHistory ()
+
+-(id)initWithCapacity:(NSUInteger)capacity;
+
+@end
+
+FOUNDATION_IMPORT void EOSPropertyHistoryRecord(EOSPropertyHistory* history, EOSProperty property, NSUInteger parameter, EOSPropertyChangeSource source, const void* value, NSUInteger size);
+FOUNDATION_IMPORT void EOSPropertyHistoryRecordChange(EOSPropertyHistory* history, EOSProperty property, NSUInteger parameter, EOSPropertyChangeSource source, const void* value, const void* previousValue, NSUInteger size);
+
+@interface EOSPropertyHistoryTests : XCTestCase
+
+@end
+
+@implementation EOSPropertyHistoryTests
+
+-(void)recordValue:(UInt32)value forProperty:(EOSProperty)property inHistory:(EOSPropertyHistory*)history{
+
+    EOSPropertyHistoryRecord(history, property, 0, EOSPropertyChangeSource_Framework, &value, sizeof(value));
+
+}
+
+-(void)testCapacityIsRoundedToPowerOfTwo{
+
+    XCTAssertEqual([[[EOSPropertyHistory alloc] initWithCapacity:5] capacity], (NSUInteger)8);
+    XCTAssertEqual([[[EOSPropertyHistory alloc] initWithCapacity:8] capacity], (NSUInteger)8);
+    XCTAssertEqual([[[EOSPropertyHistory alloc] initWithCapacity:0] capacity], (NSUInteger)1);
+
+}
+
+-(void)testRingKeepsNewestEntriesWhenFull{
+
+    EOSPropertyHistory* history = [[EOSPropertyHistory alloc] initWithCapacity:4];
+
+    for (UInt32 i=0; i<10; i++)
+        [self recordValue:i forProperty:EOSProperty_ISOSpeed inHistory:history];
+
+    NSArray* changes = [history changes];
+
+    XCTAssertEqual([history recordedCount], (UInt64)10);
+    XCTAssertEqual([changes count], (NSUInteger)4);
+
+    for (NSUInteger i=0; i<[changes count]; i++){
+
+        EOSPropertyChange* change = [changes objectAtIndex:i];
+
+        XCTAssertEqual([change sequenceNumber], (UInt64)(6 + i));
+        XCTAssertEqualObjects([change value], @(6 + i));
+
+    }
+
+    //the oldest entry has no previous value, as the entry before it was overwritten
+    XCTAssertNil([[changes firstObject] previousValue]);
+    XCTAssertEqualObjects([[changes lastObject] previousValue], @8);
+
+}
+
+-(void)testPreviousValuesAreKeptPerProperty{
+
+    EOSPropertyHistory* history = [[EOSPropertyHistory alloc] initWithCapacity:16];
+
+    [self recordValue:100 forProperty:EOSProperty_ISOSpeed inHistory:history];
+    [self recordValue:5 forProperty:EOSProperty_Aperture inHistory:history];
+    [self recordValue:200 forProperty:EOSProperty_ISOSpeed inHistory:history];
+
+    NSArray* changes = [history changesForProperty:EOSProperty_ISOSpeed];
+
+    XCTAssertEqual([changes count], (NSUInteger)2);
+    XCTAssertEqualObjects([[changes lastObject] previousValue], @100);
+    XCTAssertNil([[[history changesForProperty:EOSProperty_Aperture] firstObject] previousValue]);
+
+}
+
+-(void)testRecordedPreviousValueIsUsed{
+
+    EOSPropertyHistory* history = [[EOSPropertyHistory alloc] initWithCapacity:16];
+    UInt32 cameraValue = 100;
+    UInt32 writtenValue = 400;
+    UInt32 readValue = 200;
+
+    EOSPropertyHistoryRecord(history, EOSProperty_ISOSpeed, 0, EOSPropertyChangeSource_Camera, &cameraValue, sizeof(cameraValue));
+
+    //the value read before the write wins over the entry before it
+    EOSPropertyHistoryRecordChange(history, EOSProperty_ISOSpeed, 0, EOSPropertyChangeSource_Framework, &writtenValue, &readValue, sizeof(writtenValue));
+
+    NSArray* changes = [history changes];
+
+    XCTAssertEqual([changes count], (NSUInteger)2);
+    XCTAssertEqualObjects([[changes firstObject] value], @100);
+    XCTAssertEqualObjects([[changes lastObject] value], @400);
+    XCTAssertEqualObjects([[changes lastObject] previousValue], @200);
+
+}
+
+-(void)testCameraChangeClearsPreviousValue{
+
+    EOSPropertyHistory* history = [[EOSPropertyHistory alloc] initWithCapacity:16];
+
+    [self recordValue:100 forProperty:EOSProperty_ISOSpeed inHistory:history];
+    EOSPropertyHistoryRecord(history, EOSProperty_ISOSpeed, 0, EOSPropertyChangeSource_Camera, NULL, 0);
+    [self recordValue:400 forProperty:EOSProperty_ISOSpeed inHistory:history];
+
+    NSArray* changes = [history changes];
+
+    XCTAssertEqual([changes count], (NSUInteger)3);
+    XCTAssertEqual([[changes objectAtIndex:1] source], EOSPropertyChangeSource_Camera);
+    XCTAssertNil([[changes objectAtIndex:1] value]);
+    XCTAssertEqualObjects([[changes objectAtIndex:1] previousValue], @100);
+
+    //without a value for the camera's change, the value before the write isn't known
+    XCTAssertNil([[changes lastObject] previousValue]);
+
+}
+
+@end
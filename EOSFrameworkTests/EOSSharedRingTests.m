@@ -0,0 +1,146 @@
+//
+//  EOSSharedRingTests.m
+//  EOSFrameworkTests
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <XCTest/XCTest.h>
+#import <EOSFramework/EOSFramework.h>
+
+@interface EOSSharedRingTests : XCTestCase
+
+@end
+
+@implementation EOSSharedRingTests
+
+//maps the producer's memory a second time, as a consumer in another process would
+-(EOSSharedRing*)consumerOfRing:(EOSSharedRing*)ring index:(NSUInteger)index{
+
+    NSError* error;
+    EOSSharedRing* consumer = [[EOSSharedRing alloc] initWithFileDescriptor:dup([ring fileDescriptor]) consumerIndex:index error:&error];
+    XCTAssertNotNil(consumer, @"%@", error);
+
+    return consumer;
+
+}
+
+-(EOSSharedSlot*)publishString:(const char*)string inRing:(EOSSharedRing*)ring consumers:(UInt64)consumers{
+
+    EOSSharedSlot* slot = [ring acquireSlot:nil];
+    XCTAssertNotNil(slot);
+
+    memcpy([slot bytes], string, strlen(string));
+    [slot setLength:strlen(string)];
+    [ring publishSlot:slot consumers:consumers];
+
+    return slot;
+
+}
+
+-(void)testSlotSizeIsRoundedToPages{
+
+    EOSSharedRing* ring = [[EOSSharedRing alloc] initWithSlotCount:2 slotSize:1 error:nil];
+
+    XCTAssertEqual([ring slotSize], (NSUInteger)getpagesize());
+    XCTAssertEqual([ring slotCount], (NSUInteger)2);
+    XCTAssertTrue([ring isProducer]);
+
+    EOSSharedRing* consumer = [self consumerOfRing:ring index:0];
+
+    XCTAssertEqual([consumer slotSize], [ring slotSize]);
+    XCTAssertEqual([consumer slotCount], [ring slotCount]);
+    XCTAssertFalse([consumer isProducer]);
+
+}
+
+-(void)testAcquireFailsWhenEverySlotIsHeld{
+
+    EOSSharedRing* ring = [[EOSSharedRing alloc] initWithSlotCount:2 slotSize:1 error:nil];
+    EOSSharedSlot* first = [ring acquireSlot:nil];
+    EOSSharedSlot* second = [ring acquireSlot:nil];
+    NSError* error;
+
+    XCTAssertNotNil(first);
+    XCTAssertNotNil(second);
+    XCTAssertNotEqual([first index], [second index]);
+    XCTAssertNil([ring acquireSlot:&error]);
+    XCTAssertEqual([error code], (NSInteger)EOSError_Device_Busy);
+
+    //an abandoned slot, or one published to no consumers, is free straight away
+    [ring abandonSlot:first];
+    first = [ring acquireSlot:nil];
+    XCTAssertNotNil(first);
+
+    [second setLength:0];
+    [ring publishSlot:second consumers:0];
+    XCTAssertNotNil([ring acquireSlot:nil]);
+
+}
+
+-(void)testSlotIsFreeOnceEveryConsumerReleases{
+
+    EOSSharedRing* ring = [[EOSSharedRing alloc] initWithSlotCount:1 slotSize:1 error:nil];
+    EOSSharedRing* first = [self consumerOfRing:ring index:0];
+    EOSSharedRing* second = [self consumerOfRing:ring index:3];
+    EOSSharedRing* other = [self consumerOfRing:ring index:1];
+
+    EOSSharedSlot* slot = [self publishString:"frame" inRing:ring consumers:(1ULL << 0) | (1ULL << 3)];
+
+    //each consumer reads the producer's bytes in place
+    EOSSharedSlot* firstSlot = [first slotAtIndex:[slot index]];
+    EOSSharedSlot* secondSlot = [second slotAtIndex:[slot index]];
+
+    XCTAssertEqualObjects([firstSlot data], [NSData dataWithBytes:"frame" length:5]);
+    XCTAssertEqual([firstSlot sequence], (UInt64)1);
+    XCTAssertNotNil(secondSlot);
+    XCTAssertNil([other slotAtIndex:[slot index]]);
+    XCTAssertNil([first slotAtIndex:1]);
+
+    [first releaseSlot:firstSlot];
+    XCTAssertNil([first slotAtIndex:[slot index]]);
+    XCTAssertNil([ring acquireSlot:nil]);
+
+    [second releaseSlot:secondSlot];
+    XCTAssertNotNil([ring acquireSlot:nil]);
+
+}
+
+-(void)testProducerReleasesDisconnectedConsumer{
+
+    EOSSharedRing* ring = [[EOSSharedRing alloc] initWithSlotCount:1 slotSize:1 error:nil];
+    EOSSharedRing* consumer = [self consumerOfRing:ring index:5];
+
+    EOSSharedSlot* slot = [self publishString:"frame" inRing:ring consumers:1ULL << 5];
+
+    XCTAssertNotNil([consumer slotAtIndex:[slot index]]);
+    XCTAssertNil([ring acquireSlot:nil]);
+
+    [ring releaseSlotsForConsumer:5];
+
+    XCTAssertNil([consumer slotAtIndex:[slot index]]);
+    XCTAssertNotNil([ring acquireSlot:nil]);
+
+}
+
+-(void)testConsumerRejectsInvalidMemory{
+
+    EOSSharedRing* ring = [[EOSSharedRing alloc] initWithSlotCount:1 slotSize:1 error:nil];
+    NSError* error;
+
+    XCTAssertNil([[EOSSharedRing alloc] initWithFileDescriptor:dup([ring fileDescriptor]) consumerIndex:EOSSharedRingMaxConsumers error:&error]);
+    XCTAssertEqual([error code], (NSInteger)EOSError_InvalidParameter);
+
+    //a file of the right size that isn't a ring
+    FILE* file = tmpfile();
+    XCTAssertEqual(ftruncate(fileno(file), getpagesize() * 2), 0);
+
+    XCTAssertNil([[EOSSharedRing alloc] initWithFileDescriptor:dup(fileno(file)) consumerIndex:0 error:&error]);
+    XCTAssertEqual([error code], (NSInteger)EOSError_InvalidParameter);
+
+    fclose(file);
+
+}
+
+@end
@@ -0,0 +1,913 @@
+//
+//  main.m
+//  eosctl
+//
+//  Created by Henry Betts on 18/10/2026.
+//  Copyright (c) 2026 Henry Betts.
+//
+
+#import <Foundation/Foundation.h>
+#import <EOSFramework/EOSFramework.h>
+#include <sysexits.h>
+
+#define EOSCtlDefaultJobs   8
+
+typedef struct{
+
+    const char* name;
+    EOSProperty property;
+
+} EOSCtlPropertyName;
+
+#define EOSCtlProperty(name) {#name, EOSProperty_##name}
+
+static const EOSCtlPropertyName EOSCtlPropertyNames[] = {
+
+    EOSCtlProperty(ProductName), EOSCtlProperty(SerialNumber), EOSCtlProperty(OwnerName), EOSCtlProperty(MakerName),
+    EOSCtlProperty(FirmwareVersion), EOSCtlProperty(BatteryLevel), EOSCtlProperty(BatteryQuality), EOSCtlProperty(CaptureDestination),
+    EOSCtlProperty(CurrentStorage), EOSCtlProperty(CurrentFolder), EOSCtlProperty(ImageQuality), EOSCtlProperty(JPEGQuality),
+    EOSCtlProperty(Orientation), EOSCtlProperty(WhiteBalance), EOSCtlProperty(ColorTemperature), EOSCtlProperty(ColorSpace),
+    EOSCtlProperty(PictureStyle), EOSCtlProperty(AEMode), EOSCtlProperty(AEModeSelect), EOSCtlProperty(DriveMode),
+    EOSCtlProperty(ISOSpeed), EOSCtlProperty(MeteringMode), EOSCtlProperty(AFMode), EOSCtlProperty(Aperture),
+    EOSCtlProperty(ShutterSpeed), EOSCtlProperty(ExposureCompensation), EOSCtlProperty(FlashCompensation), EOSCtlProperty(AvailableShots),
+    EOSCtlProperty(Bracket), EOSCtlProperty(AEBracket), EOSCtlProperty(WhiteBalanceBracket), EOSCtlProperty(LensName),
+    EOSCtlProperty(NoiseReduction), EOSCtlProperty(isLensAttached), EOSCtlProperty(Artist), EOSCtlProperty(Copyright)
+
+};
+
+static NSUInteger EOSCtlJobs = EOSCtlDefaultJobs;
+static NSArray* EOSCtlCameras;
+
+
+
+#pragma mark - Output
+
+static void EOSCtlPrintUsage(void){
+
+    fprintf(stderr,
+            "usage: eosctl [-c cameras] [-j jobs] <command> [arguments]\n"
+            "\n"
+            "commands:\n"
+            "    list                               lists the cameras\n"
+            "    get <property>...                  gets the values of properties\n"
+            "    set <property>=<value>...          sets the values of properties\n"
+            "    capture                            takes a picture\n"
+            "    ingest <directory> [-o] [-k file]  downloads every file to <directory>/<serial number>\n"
+            "                                       -o overwrites existing files, -k adds them to a catalog\n"
+            "    transfer <directory>               receives the files sent from each camera in direct transfer mode\n"
+            "                                       to <directory>/<serial number>, and reports the throughput\n"
+            "    format -y                          formats every volume\n"
+            "    geotag <lat> <lon> [alt]           writes a GPS position, in degrees and metres\n"
+            "    clock [-w]                         measures the offset of each camera's clock, -w sets it to the host's time\n"
+            "\n"
+            "options:\n"
+            "    -c cameras  comma separated indexes, serial numbers or ports of the cameras (default: all)\n"
+            "    -j jobs     the number of cameras to operate on at once (default: %d)\n"
+            "\n"
+            "Properties are named as in EOSProperty (for example ISOSpeed), or given as numbers.\n"
+            "Results are written to standard output as JSON.\n",
+            EOSCtlDefaultJobs);
+
+}
+
+static void EOSCtlPrintJSON(id object){
+
+    NSData* data = [NSJSONSerialization dataWithJSONObject:object options:NSJSONWritingPrettyPrinted error:nil];
+
+    fwrite([data bytes], 1, [data length], stdout);
+    fputc('\n', stdout);
+    fflush(stdout);
+
+}
+
+static NSDictionary* EOSCtlErrorDictionary(NSError* error){
+
+    return @{@"code": @([error code]), @"description": [error localizedDescription]};
+
+}
+
+static NSMutableDictionary* EOSCtlCameraDictionary(EOSCamera* camera, NSUInteger index){
+
+    NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
+
+    [dictionary setObject:@(index) forKey:@"index"];
+    [dictionary setObject:[camera cameraDescription] forKey:@"description"];
+    [dictionary setObject:[camera port] forKey:@"port"];
+
+    if ([camera serialNumber] != nil)
+        [dictionary setObject:[camera serialNumber] forKey:@"serialNumber"];
+
+    return dictionary;
+
+}
+
+//closes the sessions, unloads the SDK and exits
+static void EOSCtlExit(int status){
+
+    for (EOSCamera* camera in EOSCtlCameras){
+
+        if ([camera isOpen])
+            [camera closeSession:nil];
+
+    }
+
+    [[EOSManager sharedManager] terminate:nil];
+    exit(status);
+
+}
+
+static void EOSCtlFail(NSError* error){
+
+    EOSCtlPrintJSON(@{@"error": EOSCtlErrorDictionary(error)});
+    EOSCtlExit(EX_SOFTWARE);
+
+}
+
+
+
+#pragma mark - Cameras
+
+static BOOL EOSCtlOpenSession(EOSCamera* camera, NSError* __autoreleasing* error){
+
+    if ([camera isOpen])
+        return YES;
+
+    return [camera openSession:error];
+
+}
+
+//prints the results of a command and exits. The block adds each camera's attempts, and its result or error
+static void EOSCtlPrintResults(NSString* command, NSArray* cameras, NSTimeInterval duration, void (^describe)(EOSCamera* camera, NSMutableDictionary* dictionary)){
+
+    NSMutableArray* cameraResults = [NSMutableArray array];
+    NSUInteger failedCount = 0;
+
+    for (EOSCamera* camera in cameras){
+
+        NSMutableDictionary* dictionary = EOSCtlCameraDictionary(camera, [EOSCtlCameras indexOfObjectIdenticalTo:camera]);
+
+        describe(camera, dictionary);
+
+        if ([dictionary objectForKey:@"error"] != nil)
+            failedCount++;
+
+        [cameraResults addObject:dictionary];
+
+    }
+
+    EOSCtlPrintJSON(@{@"command": command,
+                      @"duration": @(duration),
+                      @"succeeded": @([cameras count] - failedCount),
+                      @"failed": @(failedCount),
+                      @"cameras": cameraResults});
+
+    EOSCtlExit(failedCount > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+}
+
+//adds a camera's attempts, and its result or error, from the result of a fleet operation
+static void EOSCtlDescribeResult(EOSFleetResult* result, EOSCamera* camera, id value, NSMutableDictionary* dictionary){
+
+    NSError* error = [result errorForCamera:camera];
+
+    [dictionary setObject:@([result attemptsForCamera:camera]) forKey:@"attempts"];
+
+    if (error != nil)
+        [dictionary setObject:EOSCtlErrorDictionary(error) forKey:@"error"];
+    else
+        [dictionary setObject:value ?: [NSNull null] forKey:@"result"];
+
+}
+
+//runs an operation on every camera, prints the results and exits
+static void EOSCtlRun(NSString* command, NSArray* cameras, id (^operation)(EOSCamera* camera, NSError* __autoreleasing* error)){
+
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        if (!EOSCtlOpenSession(camera, error))
+            return nil;
+
+        return operation(camera, error);
+
+    } onCameras:cameras maxConcurrentOperations:EOSCtlJobs completion:^(EOSFleetResult* result){
+
+        EOSCtlPrintResults(command, cameras, [result duration], ^(EOSCamera* camera, NSMutableDictionary* dictionary){
+            EOSCtlDescribeResult(result, camera, [result valueForCamera:camera], dictionary);
+        });
+
+    }];
+
+}
+
+//formats every volume of every camera, prints the results and exits
+static void EOSCtlFormat(NSString* command, NSArray* cameras){
+
+    EOSManager* manager = [EOSManager sharedManager];
+
+    //the volumes are only known once the sessions are open
+    [manager performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        return EOSCtlOpenSession(camera, error) ? [camera volumes] : nil;
+
+    } onCameras:cameras maxConcurrentOperations:EOSCtlJobs completion:^(EOSFleetResult* sessionResult){
+
+        NSMutableArray* volumes = [NSMutableArray array];
+
+        for (EOSCamera* camera in [sessionResult succeededCameras])
+            [volumes addObjectsFromArray:[sessionResult valueForCamera:camera]];
+
+        //the manager verifies each volume, and retries cameras that are busy
+        [manager formatVolumes:volumes maxConcurrentOperations:EOSCtlJobs progress:^(EOSVolume* volume, EOSFormatStage stage){
+
+            if (stage == EOSFormatStage_Failed)
+                fprintf(stderr, "eosctl: %s failed to format\n", [[volume description] UTF8String]);
+
+        } completion:^(EOSFleetResult* result){
+
+            EOSCtlPrintResults(command, cameras, [sessionResult duration] + [result duration], ^(EOSCamera* camera, NSMutableDictionary* dictionary){
+
+                //a camera without volumes isn't part of the format
+                if ([sessionResult errorForCamera:camera] != nil || ![[result cameras] containsObject:camera])
+                    EOSCtlDescribeResult(sessionResult, camera, @0, dictionary);
+                else
+                    EOSCtlDescribeResult(result, camera, @([[result valueForCamera:camera] count]), dictionary);
+
+            });
+
+        }];
+
+    }];
+
+}
+
+//matches the selector against the cameras; serial numbers are only known once sessions are open
+static void EOSCtlSelectCameras(NSString* selector, void (^handler)(NSArray* cameras)){
+
+    if (selector == nil){
+
+        handler(EOSCtlCameras);
+        return;
+
+    }
+
+    NSArray* tokens = [selector componentsSeparatedByString:@","];
+
+    void (^select)(void) = ^(void){
+
+        NSMutableArray* cameras = [NSMutableArray array];
+
+        for (NSString* token in tokens){
+
+            EOSCamera* match;
+            NSScanner* scanner = [NSScanner scannerWithString:token];
+            NSInteger index;
+
+            if ([scanner scanInteger:&index] && [scanner isAtEnd]){
+
+                if (index >= 0 && index < (NSInteger)[EOSCtlCameras count])
+                    match = [EOSCtlCameras objectAtIndex:index];
+
+            }else{
+
+                for (EOSCamera* camera in EOSCtlCameras){
+
+                    if ([[camera port] isEqualToString:token] || [[camera serialNumber] isEqualToString:token])
+                        match = camera;
+
+                }
+
+            }
+
+            if (match == nil){
+
+                fprintf(stderr, "eosctl: no camera matches '%s'\n", [token UTF8String]);
+                EOSCtlExit(EX_USAGE);
+
+            }
+
+            if ([cameras indexOfObjectIdenticalTo:match] == NSNotFound)
+                [cameras addObject:match];
+
+        }
+
+        handler(cameras);
+
+    };
+
+    BOOL needsSerialNumbers = NO;
+
+    for (NSString* token in tokens){
+
+        NSScanner* scanner = [NSScanner scannerWithString:token];
+
+        if (!([scanner scanInteger:NULL] && [scanner isAtEnd]) && [[EOSCtlCameras valueForKey:@"port"] indexOfObject:token] == NSNotFound)
+            needsSerialNumbers = YES;
+
+    }
+
+    if (!needsSerialNumbers){
+
+        select();
+        return;
+
+    }
+
+    //open every session at once, rather than one after another
+    [[EOSManager sharedManager] performOperation:^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+        return EOSCtlOpenSession(camera, error) ? [camera serialNumber] : nil;
+
+    } onCameras:EOSCtlCameras maxConcurrentOperations:EOSCtlJobs completion:^(EOSFleetResult* result){
+
+        select();
+
+    }];
+
+}
+
+
+
+#pragma mark - Properties
+
+static BOOL EOSCtlParseProperty(NSString* name, EOSProperty* property){
+
+    size_t i;
+    for (i=0; i<sizeof(EOSCtlPropertyNames) / sizeof(EOSCtlPropertyName); i++){
+
+        if ([name caseInsensitiveCompare:@(EOSCtlPropertyNames[i].name)] == NSOrderedSame){
+
+            *property = EOSCtlPropertyNames[i].property;
+            return YES;
+
+        }
+
+    }
+
+    unsigned long long value;
+    NSScanner* scanner = [NSScanner scannerWithString:name];
+
+    if ([name hasPrefix:@"0x"] ? [scanner scanHexLongLong:&value] : [scanner scanUnsignedLongLong:&value]){
+
+        if ([scanner isAtEnd]){
+
+            *property = (EOSProperty)value;
+            return YES;
+
+        }
+
+    }
+
+    fprintf(stderr, "eosctl: unknown property '%s'\n", [name UTF8String]);
+    return NO;
+
+}
+
+static id EOSCtlGetProperty(EOSCamera* camera, EOSProperty property, NSError* __autoreleasing* error){
+
+    NSUInteger size;
+    EdsDataType dataType;
+
+    if (![camera getValueSize:&size dataType:&dataType forProperty:property withParameter:0 error:error])
+        return nil;
+
+    switch (dataType){
+
+        case kEdsDataType_String:
+            return [camera stringValueForProperty:property error:error];
+
+        case kEdsDataType_Int32:
+        case kEdsDataType_UInt32:
+            return [camera numberValueForProperty:property error:error];
+
+        default:
+            break;
+
+    }
+
+    //other types are written as hex
+    NSMutableData* data = [NSMutableData dataWithLength:size];
+
+    if (![camera getValue:[data mutableBytes] ofSize:size forProperty:property withParameter:0 error:error])
+        return nil;
+
+    NSMutableString* string = [NSMutableString stringWithCapacity:size * 2];
+    const UInt8* bytes = [data bytes];
+
+    NSUInteger i;
+    for (i=0; i<size; i++)
+        [string appendFormat:@"%02x", bytes[i]];
+
+    return string;
+
+}
+
+static BOOL EOSCtlSetProperty(EOSCamera* camera, EOSProperty property, NSString* value, NSError* __autoreleasing* error){
+
+    NSUInteger size;
+    EdsDataType dataType;
+
+    if (![camera getValueSize:&size dataType:&dataType forProperty:property withParameter:0 error:error])
+        return NO;
+
+    if (dataType == kEdsDataType_String)
+        return [camera setStringValue:value forProperty:property error:error];
+
+    unsigned long long number;
+    NSScanner* scanner = [NSScanner scannerWithString:value];
+
+    if ((dataType != kEdsDataType_Int32 && dataType != kEdsDataType_UInt32) || !([value hasPrefix:@"0x"] ? [scanner scanHexLongLong:&number] : [scanner scanUnsignedLongLong:&number]) || ![scanner isAtEnd]){
+
+        if (error)
+            *error = EOSCreateError(EOSError_InvalidParameter);
+        return NO;
+
+    }
+
+    return [camera setNumberValue:@(number) forProperty:property error:error];
+
+}
+
+//parses a number, rejecting anything after it
+static BOOL EOSCtlParseDouble(NSString* string, double* value){
+
+    NSScanner* scanner = [NSScanner scannerWithString:string];
+
+    return [scanner scanDouble:value] && [scanner isAtEnd];
+
+}
+
+
+
+#pragma mark - Files
+
+@interface EOSCtlDownloadWaiter : NSObject <EOSDownloadDelegate>
+
+@property (readonly) dispatch_semaphore_t semaphore;
+@property NSError* error;
+
+@end
+
+@implementation EOSCtlDownloadWaiter
+
+-(id)init{
+
+    self = [super init];
+    if (self)
+        _semaphore = dispatch_semaphore_create(0);
+
+    return self;
+
+}
+
+-(void)didDownloadFile:(EOSFile *)file withOptions:(NSDictionary *)options contextInfo:(id)contextInfo error:(NSError *)error{
+
+    _error = error;
+    dispatch_semaphore_signal(_semaphore);
+
+}
+
+@end
+
+static BOOL EOSCtlCollectFiles(NSArray* files, NSMutableArray* collected, NSError* __autoreleasing* error){
+
+    for (EOSFile* file in files){
+
+        EOSFileInfo* info = [file info:error];
+
+        if (info == nil)
+            return NO;
+
+        if (![info isDirectory])
+            [collected addObject:file];
+        else if (!EOSCtlCollectFiles([file files], collected, error))
+            return NO;
+
+    }
+
+    return YES;
+
+}
+
+static id EOSCtlIngest(EOSCamera* camera, NSURL* directoryURL, BOOL overwrite, EOSDownloadJournal* journal, EOSCatalog* catalog, NSError* __autoreleasing* error){
+
+    NSMutableArray* files = [NSMutableArray array];
+
+    for (EOSVolume* volume in [camera volumes]){
+
+        if (!EOSCtlCollectFiles([volume files], files, error))
+            return nil;
+
+    }
+
+    //files downloaded by an earlier run are skipped
+    NSArray* pendingFiles = overwrite ? files : [journal filesNeedingDownload:files];
+
+    NSString* folder = [camera serialNumber] ?: [[camera port] stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
+    NSMutableDictionary* options = [NSMutableDictionary dictionary];
+
+    [options setObject:[directoryURL URLByAppendingPathComponent:folder isDirectory:YES] forKey:EOSDownloadDirectoryURLKey];
+    [options setObject:@(overwrite) forKey:EOSOverwriteKey];
+    [options setObject:journal forKey:EOSDownloadJournalKey];
+
+    if (catalog != nil)
+        [options setObject:catalog forKey:EOSDownloadCatalogKey];
+
+    NSUInteger downloaded = 0;
+
+    for (EOSFile* file in pendingFiles){
+
+        EOSCtlDownloadWaiter* waiter = [[EOSCtlDownloadWaiter alloc] init];
+
+        [file downloadWithOptions:options delegate:waiter contextInfo:nil];
+        dispatch_semaphore_wait([waiter semaphore], DISPATCH_TIME_FOREVER);
+
+        if ([waiter error] != nil && [[waiter error] code] != EOSError_File_AlreadyExists){
+
+            if (error)
+                *error = [waiter error];
+            return nil;
+
+        }
+
+        if ([waiter error] == nil)
+            downloaded++;
+
+    }
+
+    return @{@"files": @([files count]), @"downloaded": @(downloaded), @"skipped": @([files count] - downloaded)};
+
+}
+
+@interface EOSCtlTransferWaiter : NSObject <EOSDirectTransferDelegate>
+
+@property (readonly) dispatch_semaphore_t semaphore;
+@property EOSTransferMetrics* metrics;
+
+@end
+
+@implementation EOSCtlTransferWaiter
+
+-(id)init{
+
+    self = [super init];
+    if (self)
+        _semaphore = dispatch_semaphore_create(0);
+
+    return self;
+
+}
+
+-(void)directTransfer:(EOSDirectTransfer *)transfer didFinishBatchWithMetrics:(EOSTransferMetrics *)metrics{
+
+    _metrics = metrics;
+    dispatch_semaphore_signal(_semaphore);
+
+}
+
+@end
+
+//waits for the operator to send a batch from the camera, timing it from the first request to the last write
+static id EOSCtlDirectTransfer(EOSCamera* camera, NSURL* directoryURL, NSError* __autoreleasing* error){
+
+    NSString* folder = [camera serialNumber] ?: [[camera port] stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
+    EOSDirectTransfer* transfer = [[EOSDirectTransfer alloc] initWithCamera:camera directoryURL:[directoryURL URLByAppendingPathComponent:folder isDirectory:YES]];
+    EOSCtlTransferWaiter* waiter = [[EOSCtlTransferWaiter alloc] init];
+
+    [transfer setDelegate:waiter];
+
+    if (![transfer start:error])
+        return nil;
+
+    fprintf(stderr, "eosctl: %s is ready, send the files from the camera's menu\n", [[camera description] UTF8String]);
+    dispatch_semaphore_wait([waiter semaphore], DISPATCH_TIME_FOREVER);
+
+    __block NSError* stopError;
+    dispatch_semaphore_t stopped = dispatch_semaphore_create(0);
+
+    [transfer stopWithCompletion:^(NSError* completionError){
+
+        stopError = completionError;
+        dispatch_semaphore_signal(stopped);
+
+    }];
+
+    dispatch_semaphore_wait(stopped, DISPATCH_TIME_FOREVER);
+
+    if (stopError != nil){
+
+        if (error)
+            *error = stopError;
+        return nil;
+
+    }
+
+    return [[waiter metrics] dictionaryRepresentation];
+
+}
+
+
+
+#pragma mark - Commands
+
+static void EOSCtlCommand(NSString* command, NSArray* arguments, NSArray* cameras){
+
+    if ([command isEqualToString:@"list"] && [arguments count] == 0){
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
+            NSNumber* batteryLevel = [camera numberValueForProperty:EOSProperty_BatteryLevel error:nil];
+            NSNumber* availableShots = [camera numberValueForProperty:EOSProperty_AvailableShots error:nil];
+
+            if (batteryLevel != nil)
+                [dictionary setObject:batteryLevel forKey:@"BatteryLevel"];
+
+            if (availableShots != nil)
+                [dictionary setObject:availableShots forKey:@"AvailableShots"];
+
+            [dictionary setObject:@([[camera volumes] count]) forKey:@"volumes"];
+
+            return dictionary;
+
+        });
+
+    }else if ([command isEqualToString:@"get"] && [arguments count] > 0){
+
+        NSMutableArray* properties = [NSMutableArray array];
+
+        for (NSString* argument in arguments){
+
+            EOSProperty property;
+
+            if (!EOSCtlParseProperty(argument, &property))
+                EOSCtlExit(EX_USAGE);
+
+            [properties addObject:@(property)];
+
+        }
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            NSMutableDictionary* values = [NSMutableDictionary dictionary];
+
+            NSUInteger i;
+            for (i=0; i<[properties count]; i++){
+
+                id value = EOSCtlGetProperty(camera, [[properties objectAtIndex:i] unsignedIntegerValue], error);
+
+                if (value == nil)
+                    return nil;
+
+                [values setObject:value forKey:[arguments objectAtIndex:i]];
+
+            }
+
+            return values;
+
+        });
+
+    }else if ([command isEqualToString:@"set"] && [arguments count] > 0){
+
+        NSMutableArray* properties = [NSMutableArray array];
+        NSMutableArray* values = [NSMutableArray array];
+
+        for (NSString* argument in arguments){
+
+            NSRange range = [argument rangeOfString:@"="];
+            EOSProperty property;
+
+            if (range.location == NSNotFound){
+
+                EOSCtlPrintUsage();
+                EOSCtlExit(EX_USAGE);
+
+            }
+
+            if (!EOSCtlParseProperty([argument substringToIndex:range.location], &property))
+                EOSCtlExit(EX_USAGE);
+
+            [properties addObject:@(property)];
+            [values addObject:[argument substringFromIndex:range.location + 1]];
+
+        }
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            NSUInteger i;
+            for (i=0; i<[properties count]; i++){
+
+                if (!EOSCtlSetProperty(camera, [[properties objectAtIndex:i] unsignedIntegerValue], [values objectAtIndex:i], error))
+                    return nil;
+
+            }
+
+            return @([properties count]);
+
+        });
+
+    }else if ([command isEqualToString:@"capture"] && [arguments count] == 0){
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            return [camera sendCommand:EOSCommand_TakePicture error:error] ? @YES : nil;
+
+        });
+
+    }else if ([command isEqualToString:@"ingest"] && [arguments count] > 0){
+
+        NSURL* directoryURL = [NSURL fileURLWithPath:[[arguments objectAtIndex:0] stringByExpandingTildeInPath] isDirectory:YES];
+        NSURL* catalogURL;
+        BOOL overwrite = NO;
+
+        NSUInteger i;
+        for (i=1; i<[arguments count]; i++){
+
+            NSString* argument = [arguments objectAtIndex:i];
+
+            if ([argument isEqualToString:@"-o"]){
+
+                overwrite = YES;
+
+            }else if ([argument isEqualToString:@"-k"] && i + 1 < [arguments count]){
+
+                catalogURL = [NSURL fileURLWithPath:[[arguments objectAtIndex:++i] stringByExpandingTildeInPath]];
+
+            }else{
+
+                EOSCtlPrintUsage();
+                EOSCtlExit(EX_USAGE);
+
+            }
+
+        }
+
+        NSError* error;
+
+        if (![[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:&error])
+            EOSCtlFail(error);
+
+        //the journal makes an interrupted ingest resumable
+        EOSDownloadJournal* journal = [[EOSDownloadJournal alloc] initWithURL:[directoryURL URLByAppendingPathComponent:@".eosctl-journal"] error:&error];
+        EOSCatalog* catalog;
+
+        if (journal == nil)
+            EOSCtlFail(error);
+
+        if (catalogURL != nil){
+
+            catalog = [[EOSCatalog alloc] initWithURL:catalogURL error:&error];
+
+            if (catalog == nil)
+                EOSCtlFail(error);
+
+        }
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            __block id result;
+
+            //the operator can't make the camera busy part way through the download
+            BOOL success = [camera performWithLockedUI:^BOOL(NSError* __autoreleasing* lockedError){
+
+                result = EOSCtlIngest(camera, directoryURL, overwrite, journal, catalog, lockedError);
+                return result != nil;
+
+            } error:error];
+
+            return success ? result : nil;
+
+        });
+
+    }else if ([command isEqualToString:@"transfer"] && [arguments count] == 1){
+
+        NSURL* directoryURL = [NSURL fileURLWithPath:[[arguments objectAtIndex:0] stringByExpandingTildeInPath] isDirectory:YES];
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            return EOSCtlDirectTransfer(camera, directoryURL, error);
+
+        });
+
+    }else if ([command isEqualToString:@"format"] && [arguments isEqualToArray:@[@"-y"]]){
+
+        EOSCtlFormat(command, cameras);
+
+    }else if ([command isEqualToString:@"geotag"] && ([arguments count] == 2 || [arguments count] == 3)){
+
+        double latitude, longitude, altitude = NAN;
+        BOOL parsed = EOSCtlParseDouble([arguments objectAtIndex:0], &latitude) && EOSCtlParseDouble([arguments objectAtIndex:1], &longitude) && ([arguments count] < 3 || EOSCtlParseDouble([arguments objectAtIndex:2], &altitude));
+        EOSGeotag* geotag = parsed ? [[EOSGeotag alloc] initWithLatitude:latitude longitude:longitude altitude:altitude date:[NSDate date]] : nil;
+        EOSGeotagWriter* writer = [[EOSGeotagWriter alloc] init];
+
+        //a typo must not be written to the camera as 0
+        if (geotag == nil){
+
+            EOSCtlPrintUsage();
+            EOSCtlExit(EX_USAGE);
+
+        }
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            NSArray* changedProperties;
+
+            if (![writer writeGeotag:geotag toCamera:camera changedProperties:&changedProperties error:error])
+                return nil;
+
+            return @([changedProperties count]);
+
+        });
+
+    }else if ([command isEqualToString:@"clock"] && ([arguments count] == 0 || [arguments isEqualToArray:@[@"-w"]])){
+
+        EOSClockSync* clockSync = [[EOSClockSync alloc] init];
+        BOOL write = [arguments count] > 0;
+
+        EOSCtlRun(command, cameras, ^id(EOSCamera* camera, NSError* __autoreleasing* error){
+
+            EOSClockOffset* offset = write ? [clockSync synchronizeCamera:camera error:error] : [clockSync measureCamera:camera error:error];
+
+            if (offset == nil)
+                return nil;
+
+            return @{@"offset": @([offset offset]), @"uncertainty": @([offset uncertainty]), @"roundTripTime": @([offset roundTripTime])};
+
+        });
+
+    }else{
+
+        EOSCtlPrintUsage();
+        EOSCtlExit(EX_USAGE);
+
+    }
+
+}
+
+
+
+int main(int argc, const char * argv[]) {
+
+    @autoreleasepool {
+
+        NSString* selector;
+        int i = 1;
+
+        for (; i<argc && argv[i][0] == '-'; i++){
+
+            if (strcmp(argv[i], "-c") == 0 && i + 1 < argc){
+
+                selector = @(argv[++i]);
+
+            }else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc){
+
+                EOSCtlJobs = MAX(atoi(argv[++i]), 1);
+
+            }else{
+
+                EOSCtlPrintUsage();
+                return EX_USAGE;
+
+            }
+
+        }
+
+        if (i >= argc){
+
+            EOSCtlPrintUsage();
+            return EX_USAGE;
+
+        }
+
+        NSString* command = @(argv[i++]);
+        NSMutableArray* arguments = [NSMutableArray array];
+
+        for (; i<argc; i++)
+            [arguments addObject:@(argv[i])];
+
+        NSError* error;
+
+        if (![[EOSManager sharedManager] load:&error]){
+
+            EOSCtlPrintJSON(@{@"error": EOSCtlErrorDictionary(error)});
+            return EX_UNAVAILABLE;
+
+        }
+
+        EOSCtlCameras = [[EOSManager sharedManager] getCameras];
+
+        //results and camera events are delivered on the main thread, so the work is started once the run loop is running
+        dispatch_async(dispatch_get_main_queue(), ^(void){
+
+            EOSCtlSelectCameras(selector, ^(NSArray* cameras){
+                EOSCtlCommand(command, arguments, cameras);
+            });
+
+        });
+
+        CFRunLoopRun();
+
+    }
+
+    return EXIT_SUCCESS;
+
+}
\ No newline at end of file